@@ -76,7 +76,40 @@ EleSelector::EleSelector( const Tools::MConfig &cfg ):
    m_ele_heepid_endcap_NInnerLayerLostHits_max( cfg.GetItem< int    >( "Ele.HEEPID.Endcap.NInnerLayerLostHits.max" , 1 ) ),
    m_ele_heepid_endcap_dxy_max(                 cfg.GetItem< double >( "Ele.HEEPID.Endcap.dxy.max" , 0.05 ) ),
    m_ele_heepid_endcap_sigmaIetaIeta_max(       cfg.GetItem< double >( "Ele.HEEPID.Endcap.SigmaIetaIeta.max" , 0.03) ),
-   m_ele_EA( cfg , "Ele" )
+   m_ele_EA( cfg , "Ele" ),
+
+   // User record keys:
+   m_key_SCEt(                 "SCEt" ),
+   m_key_SCeta(                "SCeta" ),
+   m_key_GenIso(               "GenIso" ),
+   m_key_DEtaSCVtx(            "DEtaSCVtx" ),
+   m_key_DPhiSCVtx(            "DPhiSCVtx" ),
+   m_key_sigmaIetaIeta(        "sigmaIetaIeta" ),
+   m_key_HoEm(                 "HoEm" ),
+   m_key_Dxy(                  "Dxy" ),
+   m_key_Dz(                   "Dz" ),
+   m_key_EoP(                  "EoP" ),
+   m_key_NinnerLayerLostHits(  "NinnerLayerLostHits" ),
+   m_key_hasMatchedConversion( "hasMatchedConversion" ),
+   m_key_fbrem(                "fbrem" ),
+   m_key_ecalDriven(           "ecalDriven" ),
+   m_key_NMissingHits(         "NMissingHits: " ),
+   m_key_recoFlag(             "recoFlag" ),
+   m_key_e5x5(                 "e5x5" ),
+   m_key_e1x5(                 "e1x5" ),
+   m_key_e2x5(                 "e2x5" ),
+   m_key_TrkIso03(             "TrkIso03" ),
+   m_key_ECALIso03(            "ECALIso03" ),
+   m_key_HCALIso03d1(          "HCALIso03d1" ),
+   m_key_EffectiveArea(        "EffectiveArea" ),
+   m_key_PFIso03ChargedHadron( "PFIso03ChargedHadron" ),
+   m_key_PFIso03NeutralHadron( "PFIso03NeutralHadron" ),
+   m_key_PFIso03Photon(        "PFIso03Photon" ),
+   m_key_chargedHadronIso(     "chargedHadronIso" ),
+   m_key_neutralHadronIso(     "neutralHadronIso" ),
+   m_key_photonIso(            "photonIso" ),
+   m_key_cbid_bool(            m_ele_cbid_boolname ),
+   m_key_heepid_bool(          m_ele_heepid_boolname )
 {
 }
 
@@ -111,7 +144,7 @@ int EleSelector::passEle( pxl::Particle *ele, double const eleRho, bool const &i
    double eleEt = ele->getEt();
    if( m_ele_id_type == "HEEP" or  (m_ele_id_type == "switch" and  elePt>m_ele_id_ptswitch) ) {
        try {
-          eleEt = ele->getUserRecord( "SCEt" );
+          eleEt = ele->getUserRecord( m_key_SCEt );
        } catch( std::runtime_error ) {
           // Do nothing, simply use the Et from the pxl::Particle.
        }
@@ -121,7 +154,7 @@ int EleSelector::passEle( pxl::Particle *ele, double const eleRho, bool const &i
    if( elePt < m_ele_pt_min ) passKin=false;
 
    // eta
-   double const abseta = isRec ? fabs( ele->getUserRecord( "SCeta" ).toDouble() ) : fabs( ele->getEta() );
+   double const abseta = isRec ? fabs( ele->getUserRecord( m_key_SCeta ).toDouble() ) : fabs( ele->getEta() );
 
    //out of endcap
    if( abseta > m_ele_eta_endcap_max ) passKin=false;
@@ -179,9 +212,9 @@ int EleSelector::passEle( pxl::Particle *ele, double const eleRho, bool const &i
          //ele in barrel
          bool iso_failed = false;
          if( m_ele_id_type == "HEEP" )
-            iso_failed = ele->getUserRecord( "GenIso" ).toDouble() > m_ele_heepid_barrel_trackiso_max;
+            iso_failed = ele->getUserRecord( m_key_GenIso ).toDouble() > m_ele_heepid_barrel_trackiso_max;
          if( m_ele_id_type == "CB" )
-            iso_failed = ele->getUserRecord( "GenIso" ).toDouble() / elePt > m_ele_cbid_barrel_PFIsoRel_max;
+            iso_failed = ele->getUserRecord( m_key_GenIso ).toDouble() / elePt > m_ele_cbid_barrel_PFIsoRel_max;
 
          //turn around for iso-inversion
          if( m_ele_invertIso )
@@ -195,9 +228,9 @@ int EleSelector::passEle( pxl::Particle *ele, double const eleRho, bool const &i
       if( endcap ) {
          bool iso_failed = false;
          if(  m_ele_id_type == "HEEP" )
-            iso_failed = ele->getUserRecord( "GenIso" ).toDouble() > m_ele_heepid_barrel_trackiso_max;
+            iso_failed = ele->getUserRecord( m_key_GenIso ).toDouble() > m_ele_heepid_barrel_trackiso_max;
          if( m_ele_id_type == "CB" )
-            iso_failed = ele->getUserRecord( "GenIso" ).toDouble() / elePt > m_ele_cbid_barrel_PFIsoRel_max;
+            iso_failed = ele->getUserRecord( m_key_GenIso ).toDouble() / elePt > m_ele_cbid_barrel_PFIsoRel_max;
 
          //turn around for iso-inversion
          if( m_ele_invertIso )
@@ -234,8 +267,8 @@ bool EleSelector::passCBID( pxl::Particle const *ele,
    // First check if we want to use only id flags from miniaod or
    // reperform cuts
    if( m_ele_cbid_usebool ){
-      if(ele->hasUserRecord( m_ele_cbid_boolname ) ){
-         return ele->getUserRecord( m_ele_cbid_boolname );
+      if(ele->hasUserRecord( m_key_cbid_bool ) ){
+         return ele->getUserRecord( m_key_cbid_bool );
       }else{
          std::cerr << "Error: You are tring to select Ele with CBID"<< std::endl;
          std::cerr << "But no user record is found for boolname: "<< m_ele_cbid_boolname <<std::endl;
@@ -244,44 +277,44 @@ bool EleSelector::passCBID( pxl::Particle const *ele,
     }
 
    // Retrieve each variable and IMMEDIATELY check if it passes the cut!
-   double const DEtaIn = ele->getUserRecord( "DEtaSCVtx" );
+   double const DEtaIn = ele->getUserRecord( m_key_DEtaSCVtx );
    if( eleBarrel and DEtaIn > m_ele_cbid_barrel_DEtaIn_max )
       return false;
    if( eleEndcap and DEtaIn > m_ele_cbid_endcap_DEtaIn_max )
       return false;
 
-   double const DPhiIn = ele->getUserRecord( "DPhiSCVtx" );
+   double const DPhiIn = ele->getUserRecord( m_key_DPhiSCVtx );
    if( eleBarrel and DPhiIn > m_ele_cbid_barrel_DPhiIn_max )
       return false;
    if( eleEndcap and DPhiIn > m_ele_cbid_endcap_DPhiIn_max )
       return false;
 
-   double const sigmaIetaIeta = ele->getUserRecord( "sigmaIetaIeta" );
+   double const sigmaIetaIeta = ele->getUserRecord( m_key_sigmaIetaIeta );
    if( eleBarrel and sigmaIetaIeta > m_ele_cbid_barrel_sigmaIetaIeta_max )
       return false;
    if( eleEndcap and sigmaIetaIeta > m_ele_cbid_endcap_sigmaIetaIeta_max )
       return false;
 
-   double const HoE = ele->getUserRecord( "HoEm" );
+   double const HoE = ele->getUserRecord( m_key_HoEm );
    if( eleBarrel and HoE > m_ele_cbid_barrel_HoE_max )
       return false;
    if( eleEndcap and HoE > m_ele_cbid_endcap_HoE_max )
       return false;
 
-   double const Dxy = ele->getUserRecord( "Dxy" );
+   double const Dxy = ele->getUserRecord( m_key_Dxy );
    if( eleBarrel and Dxy > m_ele_cbid_barrel_Dxy_max )
       return false;
    if( eleEndcap and Dxy > m_ele_cbid_endcap_Dxy_max )
       return false;
 
-   double const Dz = ele->getUserRecord( "Dz" );
+   double const Dz = ele->getUserRecord( m_key_Dz );
    if( eleBarrel and Dz > m_ele_cbid_barrel_Dz_max )
       return false;
    if( eleEndcap and Dz > m_ele_cbid_endcap_Dz_max )
       return false;
 
    double const Energy = ele->getE();
-   double const EoP = ele->getUserRecord( "EoP" );
+   double const EoP = ele->getUserRecord( m_key_EoP );
    // p_in, the same as 'pat::Electron::trackMomentumAtVtx().p()'
    double const pIn = Energy / EoP;
    double const relInvEpDiff = std::abs( 1.0 / Energy - 1.0/ pIn );
@@ -290,7 +323,7 @@ bool EleSelector::passCBID( pxl::Particle const *ele,
    if( eleEndcap and relInvEpDiff > m_ele_cbid_endcap_RelInvEpDiff_max )
       return false;
 
-   double const NinnerLayerLostHits = ele->getUserRecord( "NinnerLayerLostHits" );
+   double const NinnerLayerLostHits = ele->getUserRecord( m_key_NinnerLayerLostHits );
    if( eleBarrel and NinnerLayerLostHits > m_ele_cbid_barrel_NInnerLayerLostHits_max )
       return false;
    if( eleEndcap and NinnerLayerLostHits > m_ele_cbid_endcap_NInnerLayerLostHits_max )
@@ -298,7 +331,7 @@ bool EleSelector::passCBID( pxl::Particle const *ele,
 
    //double const PFIso03PUCorrected = ele->getUserRecord( "PFIso03PUCorrected" );
 
-   double const hasConversion = ele->getUserRecord( "hasMatchedConversion" );
+   double const hasConversion = ele->getUserRecord( m_key_hasMatchedConversion );
    if( eleBarrel and m_ele_cbid_barrel_Conversion_reject and hasConversion )
       return true;
    if( eleEndcap and m_ele_cbid_endcap_Conversion_reject and hasConversion )
@@ -308,7 +341,7 @@ bool EleSelector::passCBID( pxl::Particle const *ele,
    // See also:
    // https://twiki.cern.ch/twiki/bin/view/CMS/EgammaCutBasedIdentification?rev=30#E_p_and_fbrem_based_tight_ID_201
 
-   double const fBrem = ele->getUserRecord( "fbrem" );
+   double const fBrem = ele->getUserRecord( m_key_fbrem );
    // It is OK that fBrem is too small, if we are in the lowEta region and the
    // EoP is large enough!
    bool const passfBrem = fBrem > m_ele_cbid_fBrem_min or
@@ -336,8 +369,8 @@ bool EleSelector::passHEEPID( pxl::Particle const *ele,
    // First check if we want to use only id flags from miniaod or
    // reperform cuts
    if( m_ele_heepid_usebool ){
-      if(ele->hasUserRecord( m_ele_heepid_boolname ) ){
-         return ele->getUserRecord( m_ele_heepid_boolname );
+      if(ele->hasUserRecord( m_key_heepid_bool ) ){
+         return ele->getUserRecord( m_key_heepid_bool );
       }else{
          std::cerr << "Error: You are tring to select Ele with HEEPID"<< std::endl;
          std::cerr << "But no user record is found for boolname: "<< m_ele_heepid_boolname <<std::endl;
@@ -347,31 +380,31 @@ bool EleSelector::passHEEPID( pxl::Particle const *ele,
 
    // Require electron to be ECAL driven?
    if( m_ele_heepid_requireEcalDriven and
-       not ele->getUserRecord( "ecalDriven" )
+       not ele->getUserRecord( m_key_ecalDriven )
        ) return false;
 
-   if( ele->getUserRecord( "EoP" ).toDouble() > m_ele_heepid_EoP_max )
+   if( ele->getUserRecord( m_key_EoP ).toDouble() > m_ele_heepid_EoP_max )
       return false;
 
    // These variables are checked in the barrel as well as in the endcaps.
-   double const ele_absDeltaEta = fabs( ele->getUserRecord( "DEtaSCVtx" ).toDouble() );
-   double const ele_absDeltaPhi = fabs( ele->getUserRecord( "DPhiSCVtx" ).toDouble() );
-   double const ele_HoEM        = ele->getUserRecord( "HoEm" );
+   double const ele_absDeltaEta = fabs( ele->getUserRecord( m_key_DEtaSCVtx ).toDouble() );
+   double const ele_absDeltaPhi = fabs( ele->getUserRecord( m_key_DPhiSCVtx ).toDouble() );
+   double const ele_HoEM        = ele->getUserRecord( m_key_HoEm );
 
 
    // TODO: Remove this construct when FA11 or older samples are not used anymore.
    // (Typo in skimmer already fixed. UserRecord: NinnerLayerLostHits.)
    int ele_innerLayerLostHits;
    try{
-      ele_innerLayerLostHits = ele->getUserRecord( "NMissingHits: " );
+      ele_innerLayerLostHits = ele->getUserRecord( m_key_NMissingHits );
    } catch( std::runtime_error ) {
-      ele_innerLayerLostHits = ele->getUserRecord( "NinnerLayerLostHits" );
+      ele_innerLayerLostHits = ele->getUserRecord( m_key_NinnerLayerLostHits );
    } catch( ... ) {
       throw;
    }
 
    if( m_ele_heepid_rejectOutOfTime and
-       ele->getUserRecord_def( "recoFlag",0 ).toUInt32() == 2
+       ele->getUserRecord_def( m_key_recoFlag,0 ).toUInt32() == 2
        ) return false;
 
    //ele in barrel
@@ -388,9 +421,9 @@ bool EleSelector::passHEEPID( pxl::Particle const *ele,
       if( ele_HoEM > m_ele_heepid_barrel_HoEM_max )
          return false;
       //shower shape
-      double const e5x5 = ele->getUserRecord( "e5x5" );
-      double const e1x5 = ele->getUserRecord( "e1x5" );
-      double const e2x5 = ele->getUserRecord( "e2x5" );
+      double const e5x5 = ele->getUserRecord( m_key_e5x5 );
+      double const e1x5 = ele->getUserRecord( m_key_e1x5 );
+      double const e2x5 = ele->getUserRecord( m_key_e2x5 );
 
       if( e1x5/e5x5 < m_ele_heepid_barrel_e1x5_min and
           e2x5/e5x5 < m_ele_heepid_barrel_e2x5_min
@@ -399,7 +432,7 @@ bool EleSelector::passHEEPID( pxl::Particle const *ele,
       if( ele_innerLayerLostHits > m_ele_heepid_barrel_NInnerLayerLostHits_max )
          return false;
 
-      if( ele->getUserRecord( "Dxy" ).toDouble() > m_ele_heepid_barrel_dxy_max )
+      if( ele->getUserRecord( m_key_Dxy ).toDouble() > m_ele_heepid_barrel_dxy_max )
          return false;
    }
 
@@ -418,14 +451,14 @@ bool EleSelector::passHEEPID( pxl::Particle const *ele,
          return false;
 
       //sigma iEta-iEta
-      if( ele->getUserRecord( "sigmaIetaIeta" ).toDouble() > m_ele_heepid_endcap_sigmaIetaIeta_max )
+      if( ele->getUserRecord( m_key_sigmaIetaIeta ).toDouble() > m_ele_heepid_endcap_sigmaIetaIeta_max )
          return false;
 
 
       if( ele_innerLayerLostHits > m_ele_heepid_endcap_NInnerLayerLostHits_max )
          return false;
 
-      if( ele->getUserRecord( "Dxy" ).toDouble() > m_ele_heepid_endcap_dxy_max )
+      if( ele->getUserRecord( m_key_Dxy ).toDouble() > m_ele_heepid_endcap_dxy_max )
          return false;
    }
    return true;
@@ -434,9 +467,9 @@ bool EleSelector::passHEEPID( pxl::Particle const *ele,
 
 bool EleSelector::passHEEP_Isolation(pxl::Particle const *ele, double const eleEt, bool const eleBarrel, bool const eleEndcap, double const eleRho) const {
 
-   double const ele_TrkIso      = ele->getUserRecord( "TrkIso03" );
-   double const ele_ECALIso     = ele->getUserRecord( "ECALIso03" );
-   double const ele_HCALIso     = ele->getUserRecord( "HCALIso03d1" );
+   double const ele_TrkIso      = ele->getUserRecord( m_key_TrkIso03 );
+   double const ele_ECALIso     = ele->getUserRecord( m_key_ECALIso03 );
+   double const ele_HCALIso     = ele->getUserRecord( m_key_HCALIso03d1 );
    double const ele_CaloIso     = ele_ECALIso + ele_HCALIso;
    //ele in barrel
    if( eleBarrel ) {
@@ -497,16 +530,16 @@ bool EleSelector::passCBID_Isolation( pxl::Particle const *ele, double const &el
    //double  pfIsoPU=0;
    //std::cout<<ele->hasUserRecord("EffectiveArea")<<std::endl;
 
-   if (ele->hasUserRecord("EffectiveArea")){
-      effArea = ele->getUserRecord( "EffectiveArea" );
-      pfIsoCH = ele->getUserRecord( "PFIso03ChargedHadron" );
-      pfIsoNH = ele->getUserRecord( "PFIso03NeutralHadron" );
-      pfIsoPH = ele->getUserRecord( "PFIso03Photon" );
+   if (ele->hasUserRecord(m_key_EffectiveArea)){
+      effArea = ele->getUserRecord( m_key_EffectiveArea );
+      pfIsoCH = ele->getUserRecord( m_key_PFIso03ChargedHadron );
+      pfIsoNH = ele->getUserRecord( m_key_PFIso03NeutralHadron );
+      pfIsoPH = ele->getUserRecord( m_key_PFIso03Photon );
    }else{
       effArea = m_ele_EA.getEffectiveArea( fabs(ele->getEta()), EffectiveArea::chargedHadron );
-      pfIsoCH = ele->getUserRecord( "chargedHadronIso" );
-      pfIsoNH = ele->getUserRecord( "neutralHadronIso" );
-      pfIsoPH = ele->getUserRecord( "photonIso" );
+      pfIsoCH = ele->getUserRecord( m_key_chargedHadronIso );
+      pfIsoNH = ele->getUserRecord( m_key_neutralHadronIso );
+      pfIsoPH = ele->getUserRecord( m_key_photonIso );
       //pfIsoPU = ele->getUserRecord( "puChargedHadronIso" );
    }
 
@@ -109,5 +109,38 @@ private:
    double const m_ele_heepid_endcap_sigmaIetaIeta_max;
 
    EffectiveArea const m_ele_EA;
+
+   // User record keys, resolved once:
+   pxl::UserRecordKey const m_key_SCEt;
+   pxl::UserRecordKey const m_key_SCeta;
+   pxl::UserRecordKey const m_key_GenIso;
+   pxl::UserRecordKey const m_key_DEtaSCVtx;
+   pxl::UserRecordKey const m_key_DPhiSCVtx;
+   pxl::UserRecordKey const m_key_sigmaIetaIeta;
+   pxl::UserRecordKey const m_key_HoEm;
+   pxl::UserRecordKey const m_key_Dxy;
+   pxl::UserRecordKey const m_key_Dz;
+   pxl::UserRecordKey const m_key_EoP;
+   pxl::UserRecordKey const m_key_NinnerLayerLostHits;
+   pxl::UserRecordKey const m_key_hasMatchedConversion;
+   pxl::UserRecordKey const m_key_fbrem;
+   pxl::UserRecordKey const m_key_ecalDriven;
+   pxl::UserRecordKey const m_key_NMissingHits;
+   pxl::UserRecordKey const m_key_recoFlag;
+   pxl::UserRecordKey const m_key_e5x5;
+   pxl::UserRecordKey const m_key_e1x5;
+   pxl::UserRecordKey const m_key_e2x5;
+   pxl::UserRecordKey const m_key_TrkIso03;
+   pxl::UserRecordKey const m_key_ECALIso03;
+   pxl::UserRecordKey const m_key_HCALIso03d1;
+   pxl::UserRecordKey const m_key_EffectiveArea;
+   pxl::UserRecordKey const m_key_PFIso03ChargedHadron;
+   pxl::UserRecordKey const m_key_PFIso03NeutralHadron;
+   pxl::UserRecordKey const m_key_PFIso03Photon;
+   pxl::UserRecordKey const m_key_chargedHadronIso;
+   pxl::UserRecordKey const m_key_neutralHadronIso;
+   pxl::UserRecordKey const m_key_photonIso;
+   pxl::UserRecordKey const m_key_cbid_bool;
+   pxl::UserRecordKey const m_key_heepid_bool;
 };
 #endif
@@ -8,6 +8,14 @@
 using namespace pxl;
 using namespace std;
 
+// User record keys of the results of the given filters.
+static vector< pxl::UserRecordKey > filterKeys( string const &filterSetName, vector< string > const &filters ) {
+   vector< pxl::UserRecordKey > keys;
+   for( vector< string >::const_iterator filter = filters.begin(); filter != filters.end(); ++filter )
+      keys.push_back( pxl::UserRecordKey( filterSetName + "_p_" + *filter ) );
+   return keys;
+}
+
 //--------------------Constructor-----------------------------------------------------------------
 
 EventSelector::EventSelector( const Tools::MConfig &cfg ) :
@@ -26,6 +34,8 @@ EventSelector::EventSelector( const Tools::MConfig &cfg ) :
    m_filterSet_name( cfg.GetItem< string >( "FilterSet.Name" ) ),
    m_filterSet_genList( Tools::splitString< string >( cfg.GetItem< string >( "FilterSet.GenList" ), true  ) ),
    m_filterSet_recList( Tools::splitString< string >( cfg.GetItem< string >( "FilterSet.RecList" ), true  ) ),
+   m_filterSet_genKeys( filterKeys( m_filterSet_name, m_filterSet_genList ) ),
+   m_filterSet_recKeys( filterKeys( m_filterSet_name, m_filterSet_recList ) ),
 
    // Primary vertex:
    m_PV_num_min(  cfg.GetItem< int    >( "PV.N.min" ) ),
@@ -186,8 +196,66 @@ EventSelector::EventSelector( const Tools::MConfig &cfg ) :
    m_GenMETName( m_gen_rec_map.get( "MET" ).GenName ),
 
    m_eventCleaning( cfg ),
-   m_triggerSelector( cfg )
+   m_triggerSelector( cfg ),
+
+   // User record keys:
+   m_key_generator_accept(            "generator_accept" ),
+   m_key_non_topo_accept(             "non_topo_accept" ),
+   m_key_accepted(                    "accepted" ),
+   m_key_filter_accept(               "filter_accept" ),
+   m_key_IDpassed(                    "IDpassed" ),
+   m_key_ISOfailed(                   "ISOfailed" ),
+   m_key_IDfailed(                    "IDfailed" ),
+   m_key_KINfailed(                   "KINfailed" ),
+   m_key_multipleFails(               "multipleFails" ),
+   m_key_IDFailValue(                 "IDFailValue" ),
+   m_key_SCeta(                       "SCeta" ),
+   m_key_iEta_iEta(                   "iEta_iEta" ),
+   m_key_recoFlag(                    "recoFlag" ),
+   m_key_Converted(                   "Converted" ),
+   m_key_rawEnergy(                   "rawEnergy" ),
+   m_key_GenIso(                      "GenIso" ),
+   m_key_HasSeed(                     "HasSeed" ),
+   m_key_HoEm(                        "HoEm" ),
+   m_key_ID_ECALIso(                  "ID_ECALIso" ),
+   m_key_ID_HCALIso(                  "ID_HCALIso" ),
+   m_key_ID_TrkIso(                   "ID_TrkIso" ),
+   m_key_ECALIso(                     "ECALIso" ),
+   m_key_HCALIso(                     "HCALIso" ),
+   m_key_TrkIso(                      "TrkIso" ),
+   m_key_hasMatchedPromptElectron(    "hasMatchedPromptElectron" ),
+   m_key_HoverE2012(                  "HoverE2012" ),
+   m_key_PFIso03ChargedHadron(        "PFIso03ChargedHadron" ),
+   m_key_PFIso03NeutralHadron(        "PFIso03NeutralHadron" ),
+   m_key_PFIso03Photon(               "PFIso03Photon" ),
+   m_key_isPF(                        "isPF" ),
+   m_key_neutralHadronEnergyFraction( "neutralHadronEnergyFraction" ),
+   m_key_neutralEmEnergyFraction(     "neutralEmEnergyFraction" ),
+   m_key_nconstituents(               "nconstituents" ),
+   m_key_chargedHadronEnergyFraction( "chargedHadronEnergyFraction" ),
+   m_key_chargedEmEnergyFraction(     "chargedEmEnergyFraction" ),
+   m_key_chargedMultiplicity(         "chargedMultiplicity" ),
+   m_key_HadE(                        "HadE" ),
+   m_key_EmE(                         "EmE" ),
+   m_key_bJetType(                    "bJetType" ),
+   m_key_IsFake(                      "IsFake" ),
+   m_key_ndof(                        "ndof" ),
+   m_key_NumPV(                       "NumPV" ),
+   m_key_Type(                        "Type" ),
+   m_key_Process(                     "Process" ),
+   m_key_rho(                         "rho" ),
+   m_key_topo_accept(                 "topo_accept" ),
+   m_key_Veto(                        "Veto" ),
+   m_key_HLT_accept(                  "HLT_accept" ),
+   m_key_trigger_accept(              "trigger_accept" )
 {
+   // Resolve the keys of all particle counts written per event.
+   string const countedNames[] = { m_RecMuoName, m_RecEleName, m_RecTauName, m_RecGamName, m_RecJetName, m_RecMETName,
+                                   m_GenMuoName, m_GenEleName, m_GenTauName, m_GenGamName, m_GenJetName, m_GenMETName,
+                                   m_jet_bJets_algo, m_jet_bJets_gen_label, m_tracks_type };
+   for( size_t i = 0; i < sizeof( countedNames ) / sizeof( countedNames[ 0 ] ); ++i )
+      m_numKeys.insert( make_pair( countedNames[ i ], pxl::UserRecordKey( "Num" + countedNames[ i ] ) ) );
+
 //   if( (not m_gam_Vgamma2011PhotonID_use xor m_gam_CutBasedPhotonID2012_use xor m_gam_CutBasedPhotonID2012Flag_use ) && ( not m_gam_Vgamma2011PhotonID_use && m_gam_CutBasedPhotonID2012_use && m_gam_CutBasedPhotonID2012Flag_use ) ) {
 //      stringstream error;
 //      error << "In config file: ";
@@ -208,44 +276,37 @@ EventSelector::~EventSelector() {
 // fill them into the GenEvtView for further processing.
 //
 void EventSelector::preSynchronizeGenRec( pxl::EventView *GenEvtView, pxl::EventView *RecEvtView ) {
-   for( vector< string >::const_iterator filter = m_filterSet_genList.begin(); filter != m_filterSet_genList.end(); ++filter ) {
-      const string filterName = m_filterSet_name + "_p_" + *filter;
-      bool filterResult = RecEvtView->getUserRecord( filterName );
+   for( vector< pxl::UserRecordKey >::const_iterator filter = m_filterSet_genKeys.begin(); filter != m_filterSet_genKeys.end(); ++filter ) {
+      bool filterResult = RecEvtView->getUserRecord( *filter );
 
-      GenEvtView->setUserRecord( filterName, filterResult );
-      RecEvtView->eraseUserRecord( filterName );
+      GenEvtView->setUserRecord( *filter, filterResult );
+      RecEvtView->eraseUserRecord( *filter );
    }
 }
 
 
 void EventSelector::synchronizeGenRec( pxl::EventView* GenEvtView, pxl::EventView* RecEvtView ) {
-   bool generator_accept = GenEvtView->getUserRecord( "generator_accept" );
-   bool gen_non_topo_accepted = GenEvtView->getUserRecord( "non_topo_accept" );
-   bool rec_non_topo_accepted = RecEvtView->getUserRecord( "non_topo_accept" );
-   bool gen_accepted = GenEvtView->getUserRecord( "accepted" );
-   bool rec_accepted = RecEvtView->getUserRecord( "accepted" );
-   bool gen_filter_accepted = GenEvtView->getUserRecord( "filter_accept" );
+   bool generator_accept = GenEvtView->getUserRecord( m_key_generator_accept );
+   bool gen_non_topo_accepted = GenEvtView->getUserRecord( m_key_non_topo_accept );
+   bool rec_non_topo_accepted = RecEvtView->getUserRecord( m_key_non_topo_accept );
+   bool gen_accepted = GenEvtView->getUserRecord( m_key_accepted );
+   bool rec_accepted = RecEvtView->getUserRecord( m_key_accepted );
+   bool gen_filter_accepted = GenEvtView->getUserRecord( m_key_filter_accept );
 
    //gen and rec are both only accepted when the binning value is accepted, too
-   GenEvtView->setUserRecord( "non_topo_accept", gen_non_topo_accepted && generator_accept && gen_filter_accepted );
-   RecEvtView->setUserRecord( "non_topo_accept", rec_non_topo_accepted && generator_accept && gen_filter_accepted );
-   GenEvtView->setUserRecord( "accepted", gen_accepted && generator_accept && gen_filter_accepted );
-   RecEvtView->setUserRecord( "accepted", rec_accepted && generator_accept && gen_filter_accepted );
+   GenEvtView->setUserRecord( m_key_non_topo_accept, gen_non_topo_accepted && generator_accept && gen_filter_accepted );
+   RecEvtView->setUserRecord( m_key_non_topo_accept, rec_non_topo_accepted && generator_accept && gen_filter_accepted );
+   GenEvtView->setUserRecord( m_key_accepted, gen_accepted && generator_accept && gen_filter_accepted );
+   RecEvtView->setUserRecord( m_key_accepted, rec_accepted && generator_accept && gen_filter_accepted );
 }
 
 
 // ------------------ Check if the given filters have fired -------------------
 bool EventSelector::passFilterSelection( pxl::EventView *EvtView, const bool isRec ) {
-   vector< string > list;
-   if( isRec ) {
-      list = m_filterSet_recList;
-   } else {
-      list = m_filterSet_genList;
-   }
+   vector< pxl::UserRecordKey > const &list = isRec ? m_filterSet_recKeys : m_filterSet_genKeys;
 
-   for( vector< string >::const_iterator filter = list.begin(); filter != list.end(); ++filter ) {
-      const string filterName = m_filterSet_name + "_p_" + *filter;
-      bool filterResult = EvtView->getUserRecord( filterName );
+   for( vector< pxl::UserRecordKey >::const_iterator filter = list.begin(); filter != list.end(); ++filter ) {
+      bool filterResult = EvtView->getUserRecord( *filter );
 
       //If the filter has not fired this means that the event did not pass the
       //selection criteria and so we don't want it.
@@ -261,7 +322,9 @@ bool EventSelector::passFilterSelection( pxl::EventView *EvtView, const bool isR
 
 double EventSelector::TransverseInvariantMass(EventView* EvtView, const std::string& type1, const std::string& type2) {
    // take the particles with the highest pT of type1 and type2 and calculate transverse invariant mass
-   if (EvtView->getUserRecord("Num"+type1).toInt32() < 1 || EvtView->getUserRecord("Num"+type2).toInt32() < 1) return 0.;
+   pxl::UserRecordKey const num1 = numKey( type1 );
+   pxl::UserRecordKey const num2 = numKey( type2 );
+   if (EvtView->getUserRecord( num1 ).toInt32() < 1 || EvtView->getUserRecord( num2 ).toInt32() < 1) return 0.;
    vector<Particle*> type1_particles;
    vector<Particle*> type2_particles;
    pxl::ParticleFilter particleFilter;
@@ -282,7 +345,9 @@ double EventSelector::TransverseInvariantMass(EventView* EvtView, const std::str
 
 double EventSelector::InvariantMass(EventView* EvtView, const std::string& type1, const std::string& type2) {
    // take the particles with the highest pT of type1 and type2 and calculate transverse invariant mass
-   if (EvtView->getUserRecord("Num"+type1).toInt32() < 1 || EvtView->getUserRecord("Num"+type2).toInt32() < 1) return 0;
+   pxl::UserRecordKey const num1 = numKey( type1 );
+   pxl::UserRecordKey const num2 = numKey( type2 );
+   if (EvtView->getUserRecord( num1 ).toInt32() < 1 || EvtView->getUserRecord( num2 ).toInt32() < 1) return 0;
    vector<Particle*> type1_particles;
    vector<Particle*> type2_particles;
    pxl::ParticleFilter particleFilter;
@@ -292,7 +357,7 @@ double EventSelector::InvariantMass(EventView* EvtView, const std::string& type1
    Particle* part1 = type1_particles.front();
    Particle* part2 = type2_particles.front();
    if (type1 == type2) {
-      if (EvtView->getUserRecord("Num"+type2).toInt32() > 1) part2 = type1_particles[1];
+      if (EvtView->getUserRecord( num2 ).toInt32() > 1) part2 = type1_particles[1];
       else cout << "only one particle of type " << type1 << " available!!!" << endl;
    }
    double InvMass2 =   (part1->getE() + part2->getE())  *(part1->getE() + part2->getE())
@@ -380,31 +445,31 @@ void EventSelector::applyCutsOnMuon( std::vector< pxl::Particle* > &muons, const
          //else if (!passKin && passID && passIso) return 3;
          //return 4;
          int retrunvalue=m_muo_selector.passMuon(*muon,isRec);
-         (*muon)->setUserRecord("IDpassed",false);
-         (*muon)->setUserRecord("ISOfailed",false);
-         (*muon)->setUserRecord("IDfailed",false);
-         (*muon)->setUserRecord("KINfailed",false);
-         (*muon)->setUserRecord("multipleFails",false);
-         (*muon)->setUserRecord("IDFailValue",retrunvalue);
+         (*muon)->setUserRecord(m_key_IDpassed,false);
+         (*muon)->setUserRecord(m_key_ISOfailed,false);
+         (*muon)->setUserRecord(m_key_IDfailed,false);
+         (*muon)->setUserRecord(m_key_KINfailed,false);
+         (*muon)->setUserRecord(m_key_multipleFails,false);
+         (*muon)->setUserRecord(m_key_IDFailValue,retrunvalue);
          switch(retrunvalue){
             case 0: {
-               (*muon)->setUserRecord("IDpassed",true);
+               (*muon)->setUserRecord(m_key_IDpassed,true);
                break;
             }
             case 1: {
-               (*muon)->setUserRecord("ISOfailed",true);
+               (*muon)->setUserRecord(m_key_ISOfailed,true);
                break;
             }
             case 2: {
-               (*muon)->setUserRecord("IDfailed",true);
+               (*muon)->setUserRecord(m_key_IDfailed,true);
                break;
             }
             case 3: {
-               (*muon)->setUserRecord("KINfailed",true);
+               (*muon)->setUserRecord(m_key_KINfailed,true);
                break;
             }
             default: {
-               (*muon)->setUserRecord("multipleFails",true);
+               (*muon)->setUserRecord(m_key_multipleFails,true);
                break;
             }
          }
@@ -448,31 +513,31 @@ void EventSelector::applyCutsOnEle( std::vector< pxl::Particle* > &eles,
          //else if (!passKin && passID && passIso) return 3;
          //return 4;
          int retrunvalue=m_ele_selector.passEle( *ele, eleRho, isRec );
-         (*ele)->setUserRecord("IDpassed",false);
-         (*ele)->setUserRecord("ISOfailed",false);
-         (*ele)->setUserRecord("IDfailed",false);
-         (*ele)->setUserRecord("KINfailed",false);
-         (*ele)->setUserRecord("multipleFails",false);
-         (*ele)->setUserRecord("IDFailValue",retrunvalue);
+         (*ele)->setUserRecord(m_key_IDpassed,false);
+         (*ele)->setUserRecord(m_key_ISOfailed,false);
+         (*ele)->setUserRecord(m_key_IDfailed,false);
+         (*ele)->setUserRecord(m_key_KINfailed,false);
+         (*ele)->setUserRecord(m_key_multipleFails,false);
+         (*ele)->setUserRecord(m_key_IDFailValue,retrunvalue);
          switch(retrunvalue){
             case 0: {
-               (*ele)->setUserRecord("IDpassed",true);
+               (*ele)->setUserRecord(m_key_IDpassed,true);
                break;
             }
             case 1: {
-               (*ele)->setUserRecord("ISOfailed",true);
+               (*ele)->setUserRecord(m_key_ISOfailed,true);
                break;
             }
             case 2: {
-               (*ele)->setUserRecord("IDfailed",true);
+               (*ele)->setUserRecord(m_key_IDfailed,true);
                break;
             }
             case 3: {
-               (*ele)->setUserRecord("KINfailed",true);
+               (*ele)->setUserRecord(m_key_KINfailed,true);
                break;
             }
             default: {
-               (*ele)->setUserRecord("multipleFails",true);
+               (*ele)->setUserRecord(m_key_multipleFails,true);
                break;
             }
          }
@@ -554,7 +619,7 @@ bool EventSelector::passGam( pxl::Particle const *gam,
    // been skimmed with the updated Skimmer.
    double abseta = 0;
    try {
-      abseta = isRec ? fabs( gam->getUserRecord( "SCeta" ).toDouble() ) : fabs( gam->getEta() );
+      abseta = isRec ? fabs( gam->getUserRecord( m_key_SCeta ).toDouble() ) : fabs( gam->getEta() );
    } catch( std::runtime_error ) {
       abseta = fabs( gam->getEta() );
    }
@@ -590,7 +655,7 @@ bool EventSelector::passGam( pxl::Particle const *gam,
 
    if( isRec ) {
       //cut on sigmaietaieta ("eta width") which is different for EB and EE
-      double const gam_sigma_ieta_ieta = gam->getUserRecord( "iEta_iEta" );
+      double const gam_sigma_ieta_ieta = gam->getUserRecord( m_key_iEta_iEta );
 
       if( barrel ) {
          //Additional spike cleaning
@@ -618,7 +683,7 @@ bool EventSelector::passGam( pxl::Particle const *gam,
 
       if( m_gam_rejectOutOfTime )
         try {
-            if( gam->getUserRecord_def( "recoFlag",0 ).toUInt32() == 2 )
+            if( gam->getUserRecord_def( m_key_recoFlag,0 ).toUInt32() == 2 )
                 return false;
         } catch( std::runtime_error ) {
             // In case "recoFlag" is not set, we assume, it is *not* out of
@@ -626,11 +691,11 @@ bool EventSelector::passGam( pxl::Particle const *gam,
         }
 
       //do we care about converted photons?
-      if( not m_gam_useConverted and gam->getUserRecord( "Converted" ).asBool() ) return false;
+      if( not m_gam_useConverted and gam->getUserRecord( m_key_Converted ).asBool() ) return false;
 
       if( m_gam_corrFactor_max > 0.0 ) {
          //too large correction factors are not good for photons
-         if( gam->getE() / gam->getUserRecord( "rawEnergy" ).toDouble() > m_gam_corrFactor_max ) return false;
+         if( gam->getE() / gam->getUserRecord( m_key_rawEnergy ).toDouble() > m_gam_corrFactor_max ) return false;
       }
 
       //do we care about gamma ID?
@@ -665,7 +730,7 @@ bool EventSelector::passGam( pxl::Particle const *gam,
          }
       }
 
-      if( gam->getUserRecord( "GenIso" ).toDouble() > maxIso ) return false;
+      if( gam->getUserRecord( m_key_GenIso ).toDouble() > maxIso ) return false;
    }
 
    //no cut failed
@@ -679,9 +744,9 @@ bool EventSelector::passVgamma2011PhotonID( pxl::Particle const *gam,
                                             bool const endcap
                                             ) const {
    // Track (pixel seed) veto.
-   if( m_gam_useSeedVeto and gam->getUserRecord( "HasSeed" ).asBool() ) return false;
+   if( m_gam_useSeedVeto and gam->getUserRecord( m_key_HasSeed ).asBool() ) return false;
 
-   if( gam->getUserRecord( "HoEm" ).toDouble() > m_gam_HoEm_max ) return false;
+   if( gam->getUserRecord( m_key_HoEm ).toDouble() > m_gam_HoEm_max ) return false;
 
    double const gamPt = gam->getPt();
 
@@ -715,18 +780,18 @@ bool EventSelector::passVgamma2011PhotonID( pxl::Particle const *gam,
    // TODO: Remove try-block once no old samples are used anymore.
    try {
       //Jurrasic ECAL Isolation
-      if( gam->getUserRecord( "ID_ECALIso" ).toDouble() > maxEcalIso ) return false;
+      if( gam->getUserRecord( m_key_ID_ECALIso ).toDouble() > maxEcalIso ) return false;
       //Tower-based HCAL Isolation
-      if( gam->getUserRecord( "ID_HCALIso" ).toDouble() > maxHcalIso ) return false;
+      if( gam->getUserRecord( m_key_ID_HCALIso ).toDouble() > maxHcalIso ) return false;
       //hollow cone track isolation
-      if( gam->getUserRecord( "ID_TrkIso" ).toDouble() > maxTrackIso ) return false;
+      if( gam->getUserRecord( m_key_ID_TrkIso ).toDouble() > maxTrackIso ) return false;
    } catch( std::runtime_error ) {
       // Jurrasic ECAL Isolation.
-      if( gam->getUserRecord( "ECALIso" ).toDouble() > maxEcalIso ) return false;
+      if( gam->getUserRecord( m_key_ECALIso ).toDouble() > maxEcalIso ) return false;
       // Tower-based HCAL Isolation.
-      if( gam->getUserRecord( "HCALIso" ).toDouble() > maxHcalIso ) return false;
+      if( gam->getUserRecord( m_key_HCALIso ).toDouble() > maxHcalIso ) return false;
       // Hollow cone track isolation.
-      if( gam->getUserRecord( "TrkIso" ).toDouble() > maxTrackIso ) return false;
+      if( gam->getUserRecord( m_key_TrkIso ).toDouble() > maxTrackIso ) return false;
    }
 
    return true;
@@ -771,22 +836,22 @@ bool EventSelector::passCutBasedPhotonID2012( pxl::Particle const *gam,
                       + m_gam_endcap_PFIsoPhoton_slope * gamPt;
    }
 
-   if( eleVeto_require and gam->getUserRecord( "hasMatchedPromptElectron" ).asBool() ) return false;
+   if( eleVeto_require and gam->getUserRecord( m_key_hasMatchedPromptElectron ).asBool() ) return false;
 
-   if( gam->getUserRecord( "HoverE2012" ).toDouble() > HoEm2012_max ) return false;
+   if( gam->getUserRecord( m_key_HoverE2012 ).toDouble() > HoEm2012_max ) return false;
 
    // Correct the isolation variables accrding to:
    // https://twiki.cern.ch/twiki/bin/view/CMS/CutBasedPhotonID2012#Effective_Areas_for_rho_correcti
    // (r20: 2013-01-10)
-   double const chargedIsoCorr = max( gam->getUserRecord( "PFIso03ChargedHadron" ).toDouble() -
+   double const chargedIsoCorr = max( gam->getUserRecord( m_key_PFIso03ChargedHadron ).toDouble() -
                                       gamRho * chargedHadronEA,
                                       0.0
                                       );
-   double const neutralIsoCorr = max( gam->getUserRecord( "PFIso03NeutralHadron" ).toDouble() -
+   double const neutralIsoCorr = max( gam->getUserRecord( m_key_PFIso03NeutralHadron ).toDouble() -
                                       gamRho * neutralHadronEA,
                                       0.0
                                       );
-   double const photonIsoCorr = max( gam->getUserRecord( "PFIso03Photon" ).toDouble() -
+   double const photonIsoCorr = max( gam->getUserRecord( m_key_PFIso03Photon ).toDouble() -
                                      gamRho * photonEA,
                                      0.0
                                      );
@@ -812,7 +877,7 @@ void EventSelector::applyCutsOnJet( std::vector< pxl::Particle* > &jets, const b
       // TODO: Update to use new variable "isPFJet" implemented in Skimmer that
       // should be available in 5XY skimmed samples!
       // If any of the three is false, we don't count the jet as PF.
-      thisJet->setUserRecord( "isPF", isRec and m_jet_isPF and acceptJet );
+      thisJet->setUserRecord( m_key_isPF, isRec and m_jet_isPF and acceptJet );
 
       if( acceptJet ) jetsAfterCuts.push_back( thisJet );
       else            thisJet->owner()->remove( thisJet );
@@ -832,27 +897,27 @@ bool EventSelector::passJet( pxl::Particle *jet, const bool &isRec ) const {
          if( not jet->getUserRecord( m_jet_ID_name ).asBool() ) return false;
       } else {
          // We do it ourselves!
-         if( not jet->getUserRecord( "neutralHadronEnergyFraction" ).toDouble() < m_jet_nHadEFrac_max )
+         if( not jet->getUserRecord( m_key_neutralHadronEnergyFraction ).toDouble() < m_jet_nHadEFrac_max )
             return false;
-         if( not jet->getUserRecord( "neutralEmEnergyFraction" ).toDouble() < m_jet_nEMEFrac_max )
+         if( not jet->getUserRecord( m_key_neutralEmEnergyFraction ).toDouble() < m_jet_nEMEFrac_max )
             return false;
          // This variable is unnecessarily stored as a double! Not any more!!
-         if( jet->getUserRecord( "nconstituents" ).asUInt32() < m_jet_numConstituents_min )
+         if( jet->getUserRecord( m_key_nconstituents ).asUInt32() < m_jet_numConstituents_min )
             return false;
          // Additional cuts if |eta|>2.4:
          if( absEta > 2.4 ) {
-            if( not jet->getUserRecord( "chargedHadronEnergyFraction" ).toDouble() > m_jet_cHadEFrac_min )
+            if( not jet->getUserRecord( m_key_chargedHadronEnergyFraction ).toDouble() > m_jet_cHadEFrac_min )
                return false;
-            if( not jet->getUserRecord( "chargedEmEnergyFraction" ).toDouble() < m_jet_cEMEFrac_max )
+            if( not jet->getUserRecord( m_key_chargedEmEnergyFraction ).toDouble() < m_jet_cEMEFrac_max )
                return false;
             // This variable is unnecessarily stored as a double!
-            if( jet->getUserRecord( "chargedMultiplicity" ).asUInt32() < m_jet_cMultiplicity_min )
+            if( jet->getUserRecord( m_key_chargedMultiplicity ).asUInt32() < m_jet_cMultiplicity_min )
                return false;
          }
       }
    } else {
-      double const HadOverEm = jet->getUserRecord( "HadE" ).toDouble() / jet->getUserRecord( "EmE" ).toDouble();
-      double const HadEFrac  = jet->getUserRecord( "HadE" ).toDouble() / jet->getE();
+      double const HadOverEm = jet->getUserRecord( m_key_HadE ).toDouble() / jet->getUserRecord( m_key_EmE ).toDouble();
+      double const HadEFrac  = jet->getUserRecord( m_key_HadE ).toDouble() / jet->getE();
 
       if( HadOverEm < m_jet_gen_hadOverEm_min ) return false;
       if( HadEFrac  < m_jet_gen_hadEFrac_min )  return false;
@@ -867,13 +932,18 @@ void EventSelector::countParticles( pxl::EventView *EvtView,
                                     std::string const &name,
                                     bool const &isRec
                                     ) const {
-   std::string label = "Num";
    if( isRec )
-      label += m_gen_rec_map.get( name ).RecName;
+      EvtView->setUserRecord( numKey( m_gen_rec_map.get( name ).RecName ), particles.size() );
    else
-      label += m_gen_rec_map.get( name ).GenName;
+      EvtView->setUserRecord( numKey( m_gen_rec_map.get( name ).GenName ), particles.size() );
+}
 
-   EvtView->setUserRecord( label, particles.size() );
+
+pxl::UserRecordKey EventSelector::numKey( std::string const &name ) const {
+   map< string, pxl::UserRecordKey >::const_iterator key = m_numKeys.find( name );
+   if( key != m_numKeys.end() )
+      return key->second;
+   return pxl::UserRecordKey( "Num" + name );
 }
 
 
@@ -882,7 +952,7 @@ void EventSelector::countJets( pxl::EventView *EvtView, std::vector< pxl::Partic
    unsigned int numB = 0;
    if( m_jet_bJets_use ) {
       for( vector< Particle* >::const_iterator jet = jets.begin(); jet != jets.end(); ++jet ) {
-         if( (*jet)->getUserRecord( "bJetType" ).asString() == "nonB" ) {
+         if( (*jet)->getUserRecord( m_key_bJetType ).asString() == "nonB" ) {
             ++numJet;
          } else {
             ++numB;
@@ -892,18 +962,13 @@ void EventSelector::countJets( pxl::EventView *EvtView, std::vector< pxl::Partic
       numJet = jets.size();
    }
 
-   std::string labelJet  = "Num";
-   std::string labelBJet = "Num";
    if( isRec ) {
-      labelJet  += m_RecJetName;
-      labelBJet += m_jet_bJets_algo;
+      EvtView->setUserRecord( numKey( m_RecJetName ),     numJet );
+      EvtView->setUserRecord( numKey( m_jet_bJets_algo ), numB );
    } else {
-      labelJet  += m_GenJetName;
-      labelBJet += m_jet_bJets_gen_label;
+      EvtView->setUserRecord( numKey( m_GenJetName ),          numJet );
+      EvtView->setUserRecord( numKey( m_jet_bJets_gen_label ), numB );
    }
-
-   EvtView->setUserRecord( labelJet,  numJet );
-   EvtView->setUserRecord( labelBJet, numB );
 }
 
 
@@ -958,7 +1023,7 @@ void EventSelector::applyCutsOnVertex( pxl::EventView* EvtView, std::vector< pxl
       //check quality
       bool quality_OK;
       if( isRec ) {
-         quality_OK = ( !(*PV)->getUserRecord( "IsFake" ).asBool() and (*PV)->getUserRecord( "ndof" ).toInt32() >= m_PV_ndof_min );
+         quality_OK = ( !(*PV)->getUserRecord( m_key_IsFake ).asBool() and (*PV)->getUserRecord( m_key_ndof ).toInt32() >= m_PV_ndof_min );
       } else {
          //gen level quality is alway fine
          quality_OK = true;
@@ -975,7 +1040,7 @@ void EventSelector::applyCutsOnVertex( pxl::EventView* EvtView, std::vector< pxl
    //ATTENTION: changing PV-vector!
    vertices = PVafterCuts;
 
-   EvtView->setUserRecord( "NumPV", numPV );
+   EvtView->setUserRecord( m_key_NumPV, numPV );
 }
 
 
@@ -991,7 +1056,7 @@ bool EventSelector::applyGlobalEventCuts( pxl::EventView* EvtView,
    //check that we got enough PVs
    if( numPV < m_PV_num_min ) return false;
 
-   if( EvtView->getUserRecord( "Type" ).asString() == "Rec" ){
+   if( EvtView->getUserRecord( m_key_Type ).asString() == "Rec" ){
       //only HCAL noise ID cut on rec level in the moment
       //return true when empty to disable cut
       if( not m_runOnFastSim )
@@ -1000,7 +1065,7 @@ bool EventSelector::applyGlobalEventCuts( pxl::EventView* EvtView,
       // Use cut on track number?
       //does not work for miniAOD -- no tracks!
       if( m_tracks_use )
-         if( EvtView->getUserRecord( "Num" + m_tracks_type ).asUInt32() > m_tracks_num_max ) return false;
+         if( EvtView->getUserRecord( numKey( m_tracks_type ) ).asUInt32() > m_tracks_num_max ) return false;
    }
 
    //this makes no sence at all here!!!
@@ -1061,18 +1126,18 @@ void EventSelector::checkOrder( std::vector< pxl::Particle* > const &particles )
 
 //--------------------This is the main method to perform the selection-----------------------------------------
 void EventSelector::performSelection(EventView* EvtView, EventView* TrigEvtView, const int& JES) {   //used with either GenEvtView or RecEvtView
-   string process = EvtView->getUserRecord("Process");
-   bool isRec = (EvtView->getUserRecord("Type").asString() == "Rec");
+   string process = EvtView->getUserRecord(m_key_Process);
+   bool isRec = (EvtView->getUserRecord(m_key_Type).asString() == "Rec");
    if (JES == -1){
        process += "_JES_DOWN";
-       EvtView->setUserRecord("Process", process);
+       EvtView->setUserRecord(m_key_Process, process);
     } else if(JES == 1){
        process += "_JES_UP";
-       EvtView->setUserRecord("Process", process);
+       EvtView->setUserRecord(m_key_Process, process);
     }
 
    const bool filterAccept = passFilterSelection( EvtView, isRec );
-   EvtView->setUserRecord( "filter_accept", filterAccept );
+   EvtView->setUserRecord( m_key_filter_accept, filterAccept );
 
    double eleRho = 0.0;
    double gamRho = 0.0;
@@ -1091,7 +1156,7 @@ void EventSelector::performSelection(EventView* EvtView, EventView* TrigEvtView,
       // "rho25": rho value with eta_max = 2.5
       // "rho44": rho value with eta_max = 4.4
       try {
-         EvtView->getUserRecord( "rho" );
+         EvtView->getUserRecord( m_key_rho );
       } catch( std::runtime_error &e ) {
          // The correction factor is purley empirical and extracted from a very
          // limited set of MC (DY) and SingleMu events. This is only a temporary
@@ -1196,7 +1261,7 @@ void EventSelector::performSelection(EventView* EvtView, EventView* TrigEvtView,
    bool global_accept = applyGlobalEventCuts( EvtView, vertices, eles, mets );
 
    bool topo_accept = passEventTopology( muons, eles, taus, gammas, jets, mets );
-   EvtView->setUserRecord( "topo_accept", topo_accept );
+   EvtView->setUserRecord( m_key_topo_accept, topo_accept );
 
    if(m_useTrigger){
        // Check if there are any unprescaled single muon or single electron
@@ -1214,7 +1279,7 @@ void EventSelector::performSelection(EventView* EvtView, EventView* TrigEvtView,
                                                            mets,
                                                            TrigEvtView
                                                            );
-          EvtView->setUserRecord( "Veto", vetoed );
+          EvtView->setUserRecord( m_key_Veto, vetoed );
 
           bool const HLT_accept = m_triggerSelector.passHLTrigger( isRec,
                                                                    muons,
@@ -1225,35 +1290,35 @@ void EventSelector::performSelection(EventView* EvtView, EventView* TrigEvtView,
                                                                    mets,
                                                                    TrigEvtView
                                                                    );
-          EvtView->setUserRecord( "HLT_accept", HLT_accept );
+          EvtView->setUserRecord( m_key_HLT_accept, HLT_accept );
 
           bool const triggerAccept = HLT_accept;
-          EvtView->setUserRecord( "trigger_accept", triggerAccept );
+          EvtView->setUserRecord( m_key_trigger_accept, triggerAccept );
 
           bool const non_topo_accept = global_accept && filterAccept && triggerAccept && !vetoed;
-          EvtView->setUserRecord( "non_topo_accept", non_topo_accept );
+          EvtView->setUserRecord( m_key_non_topo_accept, non_topo_accept );
 
           //event accepted after all cuts
           bool accepted = topo_accept && non_topo_accept;
-          EvtView->setUserRecord( "accepted", accepted );
+          EvtView->setUserRecord( m_key_accepted, accepted );
        } else {
-          EvtView->setUserRecord( "HLT_accept", false );
-          EvtView->setUserRecord( "Veto", false );
-          EvtView->setUserRecord( "trigger_accept", false );
-          EvtView->setUserRecord( "non_topo_accept", false );
-          EvtView->setUserRecord( "accepted", false );
+          EvtView->setUserRecord( m_key_HLT_accept, false );
+          EvtView->setUserRecord( m_key_Veto, false );
+          EvtView->setUserRecord( m_key_trigger_accept, false );
+          EvtView->setUserRecord( m_key_non_topo_accept, false );
+          EvtView->setUserRecord( m_key_accepted, false );
        }
    }else{
-       EvtView->setUserRecord( "HLT_accept", true );
-       EvtView->setUserRecord( "Veto", true );
-       EvtView->setUserRecord( "trigger_accept", true );
-       EvtView->setUserRecord( "non_topo_accept", true );
-       EvtView->setUserRecord( "accepted", true );
+       EvtView->setUserRecord( m_key_HLT_accept, true );
+       EvtView->setUserRecord( m_key_Veto, true );
+       EvtView->setUserRecord( m_key_trigger_accept, true );
+       EvtView->setUserRecord( m_key_non_topo_accept, true );
+       EvtView->setUserRecord( m_key_accepted, true );
    }
 
    // For gen: check if generator cuts are fulfilled.
    if( !isRec ) {
-      EvtView->setUserRecord( "generator_accept", m_gen_accept.passGeneratorCuts( EvtView, s3_particles ) );
+      EvtView->setUserRecord( m_key_generator_accept, m_gen_accept.passGeneratorCuts( EvtView, s3_particles ) );
    }
 }
 
@@ -7,6 +7,7 @@ This class performs the Final Event Selection based on Final Cuts and Trigger
 Decision.
 
 */
+#include <map>
 #include <string>
 #include "Pxl/Pxl/interface/pxl/core.hh"
 #include "Pxl/Pxl/interface/pxl/hep.hh"
@@ -122,6 +123,8 @@ private:
                                 bool const &isRec
                                 ) const;
     void countJets( pxl::EventView *EvtView, std::vector< pxl::Particle* > &jets, const bool &isRec );
+    // User record key of the number of particles called name ("Num" + name).
+    pxl::UserRecordKey numKey( std::string const &name ) const;
     void applyCutsOnMET( std::vector< pxl::Particle* > &mets, const bool &isRec);
     bool passMET( pxl::Particle *met, const bool &isRec ) const;
     //cuts on primary vertices
@@ -177,6 +180,9 @@ private:
     std::string const                     m_filterSet_name;
     std::vector< std::string > const m_filterSet_genList;
     std::vector< std::string > const m_filterSet_recList;
+    // User record keys of the filter results ("<name>_p_<filter>"):
+    std::vector< pxl::UserRecordKey > const m_filterSet_genKeys;
+    std::vector< pxl::UserRecordKey > const m_filterSet_recKeys;
 
     // Primary vertex:
     int const     m_PV_num_min;
@@ -184,7 +190,7 @@ private:
     double const m_PV_rho_max;
     double const m_PV_ndof_min;
 
-    std::string const m_rho_use;
+    pxl::UserRecordKey const m_rho_use;
 
     // Tracks:
     bool const            m_tracks_use;
@@ -217,7 +223,7 @@ private:
     // Electrons:
     bool const          m_ele_use;
     bool const          m_ele_idtag;
-    std::string const m_ele_rho_label;
+    pxl::UserRecordKey const m_ele_rho_label;
     EleSelector const m_ele_selector;
 
     // Taus:
@@ -241,13 +247,13 @@ private:
     double const m_gam_endcap_sigmaIetaIeta_max;
 
     bool const    m_gam_CutBasedPhotonID2012Flag_use;
-    std::string const m_gam_IDFlag;
+    pxl::UserRecordKey const m_gam_IDFlag;
 
 
     // CutBasedPhotonID2012:
     bool const m_gam_CutBasedPhotonID2012_use;
     EffectiveArea const m_gam_EA;
-    std::string const m_gam_rho_label;
+    pxl::UserRecordKey const m_gam_rho_label;
     // Barrel:
     bool const    m_gam_barrel_electronVeto_require;
     double const m_gam_barrel_HoEm2012_max;
@@ -292,7 +298,7 @@ private:
 
     // ID:
     bool const          m_gam_ID_use;
-    std::string const m_gam_ID_name;
+    pxl::UserRecordKey const m_gam_ID_name;
 
     // Jets:
     bool const          m_jet_use;
@@ -300,7 +306,7 @@ private:
     double const        m_jet_eta_max;
     bool const          m_jet_isPF;
     bool const          m_jet_ID_use;
-    std::string const m_jet_ID_name;
+    pxl::UserRecordKey const m_jet_ID_name;
     double const        m_jet_gen_hadOverEm_min;
     double const        m_jet_gen_hadEFrac_min;
 
@@ -325,7 +331,7 @@ private:
 
     //HCAL noise ID
     bool const          m_hcal_noise_ID_use;
-    std::string const m_hcal_noise_ID_name;
+    pxl::UserRecordKey const m_hcal_noise_ID_name;
 
     /////////////////////////////////////////////////////////////////////////////
     ////////////////////////////// Other variables: /////////////////////////////
@@ -358,5 +364,58 @@ private:
     EventCleaning const m_eventCleaning;
 
     TriggerSelector const m_triggerSelector;
+
+    // User record keys, resolved once:
+    pxl::UserRecordKey const m_key_generator_accept;
+    pxl::UserRecordKey const m_key_non_topo_accept;
+    pxl::UserRecordKey const m_key_accepted;
+    pxl::UserRecordKey const m_key_filter_accept;
+    pxl::UserRecordKey const m_key_IDpassed;
+    pxl::UserRecordKey const m_key_ISOfailed;
+    pxl::UserRecordKey const m_key_IDfailed;
+    pxl::UserRecordKey const m_key_KINfailed;
+    pxl::UserRecordKey const m_key_multipleFails;
+    pxl::UserRecordKey const m_key_IDFailValue;
+    pxl::UserRecordKey const m_key_SCeta;
+    pxl::UserRecordKey const m_key_iEta_iEta;
+    pxl::UserRecordKey const m_key_recoFlag;
+    pxl::UserRecordKey const m_key_Converted;
+    pxl::UserRecordKey const m_key_rawEnergy;
+    pxl::UserRecordKey const m_key_GenIso;
+    pxl::UserRecordKey const m_key_HasSeed;
+    pxl::UserRecordKey const m_key_HoEm;
+    pxl::UserRecordKey const m_key_ID_ECALIso;
+    pxl::UserRecordKey const m_key_ID_HCALIso;
+    pxl::UserRecordKey const m_key_ID_TrkIso;
+    pxl::UserRecordKey const m_key_ECALIso;
+    pxl::UserRecordKey const m_key_HCALIso;
+    pxl::UserRecordKey const m_key_TrkIso;
+    pxl::UserRecordKey const m_key_hasMatchedPromptElectron;
+    pxl::UserRecordKey const m_key_HoverE2012;
+    pxl::UserRecordKey const m_key_PFIso03ChargedHadron;
+    pxl::UserRecordKey const m_key_PFIso03NeutralHadron;
+    pxl::UserRecordKey const m_key_PFIso03Photon;
+    pxl::UserRecordKey const m_key_isPF;
+    pxl::UserRecordKey const m_key_neutralHadronEnergyFraction;
+    pxl::UserRecordKey const m_key_neutralEmEnergyFraction;
+    pxl::UserRecordKey const m_key_nconstituents;
+    pxl::UserRecordKey const m_key_chargedHadronEnergyFraction;
+    pxl::UserRecordKey const m_key_chargedEmEnergyFraction;
+    pxl::UserRecordKey const m_key_chargedMultiplicity;
+    pxl::UserRecordKey const m_key_HadE;
+    pxl::UserRecordKey const m_key_EmE;
+    pxl::UserRecordKey const m_key_bJetType;
+    pxl::UserRecordKey const m_key_IsFake;
+    pxl::UserRecordKey const m_key_ndof;
+    pxl::UserRecordKey const m_key_NumPV;
+    pxl::UserRecordKey const m_key_Type;
+    pxl::UserRecordKey const m_key_Process;
+    pxl::UserRecordKey const m_key_rho;
+    pxl::UserRecordKey const m_key_topo_accept;
+    pxl::UserRecordKey const m_key_Veto;
+    pxl::UserRecordKey const m_key_HLT_accept;
+    pxl::UserRecordKey const m_key_trigger_accept;
+    // Keys of the particle counts, see numKey().
+    std::map< std::string, pxl::UserRecordKey > m_numKeys;
 };
 #endif
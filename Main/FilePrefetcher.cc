@@ -0,0 +1,145 @@
+#include "FilePrefetcher.hh"
+
+#include <iostream>
+#include <stdexcept>
+#include <sys/time.h>
+
+#include "Pxl/Pxl/interface/pxl/core/InputFile.hh"
+
+static double wallTime() {
+   timeval now;
+   gettimeofday( &now, 0 );
+   return now.tv_sec + 1e-6 * now.tv_usec;
+}
+
+
+FilePrefetcher::FilePrefetcher( std::vector< std::string > const &fileNames,
+                                Setup const &setup,
+                                unsigned int const depth,
+                                unsigned int const trials,
+                                size_t const warmUpBytes
+                                ) :
+   m_fileNames( fileNames ),
+   m_setup( setup ),
+   m_depth( depth ),
+   m_trials( trials > 0 ? trials : 1 ),
+   m_warmUpBytes( warmUpBytes ),
+   m_files( fileNames.size() ),
+   m_next( 0 ),
+   m_waitTime( 0 ),
+   m_threadRunning( false ),
+   m_stop( false )
+{
+   pthread_mutex_init( &m_mutex, 0 );
+   pthread_cond_init( &m_opened, 0 );
+   pthread_cond_init( &m_consumed, 0 );
+
+   if( m_depth > 0 and not m_fileNames.empty() ) {
+      if( pthread_create( &m_thread, 0, prefetch_thread, this ) == 0 ) {
+         m_threadRunning = true;
+      } else {
+         std::cerr << "[WARNING] (FilePrefetcher): Could not start the prefetch thread, opening files in turn." << std::endl;
+      }
+   }
+}
+
+
+FilePrefetcher::~FilePrefetcher() {
+   if( m_threadRunning ) {
+      pthread_mutex_lock( &m_mutex );
+      m_stop = true;
+      pthread_cond_broadcast( &m_consumed );
+      pthread_mutex_unlock( &m_mutex );
+      pthread_join( m_thread, 0 );
+   }
+
+   for( std::vector< Slot >::iterator slot = m_files.begin(); slot != m_files.end(); ++slot ) {
+      delete slot->file;
+   }
+
+   pthread_cond_destroy( &m_consumed );
+   pthread_cond_destroy( &m_opened );
+   pthread_mutex_destroy( &m_mutex );
+}
+
+
+pxl::InputFile *FilePrefetcher::next() {
+   if( m_next > 0 ) {
+      // Only the thread calling next() touches returned files.
+      Slot &previous = m_files[ m_next - 1 ];
+      delete previous.file;
+      previous.file = 0;
+   }
+   if( m_next >= m_files.size() ) return 0;
+
+   double const start = wallTime();
+   if( not m_threadRunning ) {
+      open( m_next );
+   }
+
+   pthread_mutex_lock( &m_mutex );
+   Slot &slot = m_files[ m_next ];
+   ++m_next;
+   pthread_cond_signal( &m_consumed );
+   while( not slot.done ) {
+      pthread_cond_wait( &m_opened, &m_mutex );
+   }
+   pthread_mutex_unlock( &m_mutex );
+   m_waitTime = wallTime() - start;
+
+   return slot.file;
+}
+
+
+// Opens the file with the given index, retrying up to m_trials times.
+void FilePrefetcher::open( size_t const index ) {
+   double const start = wallTime();
+   pxl::InputFile *file = 0;
+   std::string error;
+
+   for( unsigned int trial = 1; trial <= m_trials and not file; ++trial ) {
+      file = new pxl::InputFile();
+      try {
+         m_setup.apply( *file );
+         file->open( m_fileNames[ index ] );
+         file->warmUp( m_warmUpBytes );
+      } catch( std::exception &e ) {
+         error = e.what();
+         std::cerr << "[WARNING] (FilePrefetcher): Failed to open file '" << m_fileNames[ index ]
+                   << "' (trial " << trial << " of " << m_trials << "): " << error << std::endl;
+         delete file;
+         file = 0;
+      }
+   }
+
+   pthread_mutex_lock( &m_mutex );
+   Slot &slot = m_files[ index ];
+   slot.file = file;
+   slot.error = error;
+   slot.openTime = wallTime() - start;
+   slot.done = true;
+   pthread_cond_broadcast( &m_opened );
+   pthread_mutex_unlock( &m_mutex );
+}
+
+
+void *FilePrefetcher::prefetch_thread( void *prefetcher ) {
+   static_cast< FilePrefetcher* >( prefetcher )->prefetch();
+   return 0;
+}
+
+
+void FilePrefetcher::prefetch() {
+   for( size_t index = 0; index < m_files.size(); ++index ) {
+      // Stay at most m_depth files ahead of the file being analyzed.
+      pthread_mutex_lock( &m_mutex );
+      while( not m_stop and index >= m_next + m_depth ) {
+         pthread_cond_wait( &m_consumed, &m_mutex );
+      }
+      bool const stop = m_stop;
+      pthread_mutex_unlock( &m_mutex );
+      if( stop ) return;
+
+      open( index );
+   }
+}
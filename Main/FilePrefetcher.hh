@@ -0,0 +1,81 @@
+#ifndef FILEPREFETCHER
+#define FILEPREFETCHER
+
+#include <pthread.h>
+#include <string>
+#include <vector>
+
+namespace pxl {
+   class InputFile;
+}
+
+// Opens the input files in a background thread, up to 'depth' files ahead of
+// the one being analyzed, and reads the first bytes of each, so that the
+// (on dCache possibly long) opening of the next file overlaps with the
+// analysis of the current one. With depth 0, next() opens the files itself.
+class FilePrefetcher {
+   public:
+      // Applied to each file before it is opened (read ahead, filters, ...).
+      class Setup {
+         public:
+            virtual ~Setup() {}
+            virtual void apply( pxl::InputFile &file ) const = 0;
+      };
+
+      FilePrefetcher( std::vector< std::string > const &fileNames,
+                      Setup const &setup,
+                      unsigned int const depth = 1,
+                      unsigned int const trials = 3,
+                      size_t const warmUpBytes = 4194304
+                      );
+      ~FilePrefetcher();
+
+      // Closes the current file and returns the next one, waiting until it is
+      // open. Returns 0 if it could not be opened (see error()) and once all
+      // files have been returned. The file is owned by the prefetcher.
+      pxl::InputFile *next();
+
+      // Name, error message and timing of the file last returned by next().
+      std::string const &fileName() const { return m_fileNames.at( m_next - 1 ); }
+      std::string const &error() const { return m_files.at( m_next - 1 ).error; }
+      // Wall time spent opening (all trials) and warming up the file.
+      double openTime() const { return m_files.at( m_next - 1 ).openTime; }
+      // Wall time next() had to wait for the file.
+      double waitTime() const { return m_waitTime; }
+
+   private:
+      struct Slot {
+         Slot() : file( 0 ), openTime( 0 ), done( false ) {}
+         pxl::InputFile *file;
+         std::string error;
+         double openTime;
+         bool done;
+      };
+
+      void open( size_t const index );
+      static void *prefetch_thread( void *prefetcher );
+      void prefetch();
+
+      std::vector< std::string > const m_fileNames;
+      Setup const &m_setup;
+      unsigned int const m_depth;
+      unsigned int const m_trials;
+      size_t const m_warmUpBytes;
+
+      std::vector< Slot > m_files;
+      // Number of files returned by next() so far.
+      size_t m_next;
+      double m_waitTime;
+
+      pthread_t m_thread;
+      bool m_threadRunning;
+      bool m_stop;
+      pthread_mutex_t m_mutex;
+      pthread_cond_t m_opened;
+      pthread_cond_t m_consumed;
+
+      FilePrefetcher( FilePrefetcher const & );
+      FilePrefetcher &operator=( FilePrefetcher const & );
+};
+
+#endif /*FILEPREFETCHER*/
@@ -18,7 +18,12 @@ GenSelector::GenSelector( Tools::MConfig const &cfg ) :
    m_pt_min(           cfg.GetItem< double >( "Generator.pt.min", 0 ) ),
    m_pt_max(           cfg.GetItem< double >( "Generator.pt.max", 0 ) ),
    m_pt_IDs(       Tools::splitString< int >( cfg.GetItem< std::string >( "Generator.pt.IDs" ), true ) ),
-   m_pt_MotherIDs( Tools::splitString< int >( cfg.GetItem< std::string >( "Generator.pt.mothers" ), true ) )
+   m_pt_MotherIDs( Tools::splitString< int >( cfg.GetItem< std::string >( "Generator.pt.mothers" ), true ) ),
+
+   // User record keys:
+   m_key_binScale(  "binScale" ),
+   m_key_id(        "id" ),
+   m_key_mother_id( "mother_id" )
 
 {
 }
@@ -38,7 +43,7 @@ bool GenSelector::passGeneratorCuts( pxl::EventView const *EvtView,
 bool GenSelector::passBinningCuts( pxl::EventView const *EvtView ) const {
    // check binning value
    if( m_binningValue_max > 0 and
-       EvtView->getUserRecord( "binScale" ).toDouble() > m_binningValue_max
+       EvtView->getUserRecord( m_key_binScale ).toDouble() > m_binningValue_max
        ) {
       return false;
    }
@@ -56,10 +61,10 @@ bool GenSelector::passMassCuts( pxlParticles const &s3_particles ) const {
 
    for( pxlParticles::const_iterator part = s3_particles.begin(); part != s3_particles.end(); ++part ) {
       if( ( m_mass_IDs.size() == 0
-            or std::find( m_mass_IDs.begin(), m_mass_IDs.end(), (*part)->getUserRecord( "id" ).toInt32() ) != m_mass_IDs.end()
+            or std::find( m_mass_IDs.begin(), m_mass_IDs.end(), (*part)->getUserRecord( m_key_id ).toInt32() ) != m_mass_IDs.end()
             ) and
           ( m_mass_MotherIDs.size() == 0
-            or std::find( m_mass_MotherIDs.begin(), m_mass_MotherIDs.end(), (*part)->getUserRecord( "mother_id" ).toInt32() ) != m_mass_MotherIDs.end()
+            or std::find( m_mass_MotherIDs.begin(), m_mass_MotherIDs.end(), (*part)->getUserRecord( m_key_mother_id ).toInt32() ) != m_mass_MotherIDs.end()
             ) ) {
          s3_particlesSelected.push_back( *part );
       }
@@ -93,10 +98,10 @@ bool GenSelector::passTransverseMomentumCuts( pxlParticles const &s3_particles )
 
    for( pxlParticles::const_iterator part = s3_particles.begin(); part != s3_particles.end(); ++part ) {
       if( ( m_pt_IDs.size() == 0
-            or std::find( m_pt_IDs.begin(), m_pt_IDs.end(), (*part)->getUserRecord( "id" ).toInt32() ) != m_pt_IDs.end()
+            or std::find( m_pt_IDs.begin(), m_pt_IDs.end(), (*part)->getUserRecord( m_key_id ).toInt32() ) != m_pt_IDs.end()
             ) and
           ( m_pt_MotherIDs.size() == 0
-            or std::find( m_pt_MotherIDs.begin(), m_pt_MotherIDs.end(), (*part)->getUserRecord( "mother_id" ).toInt32() ) != m_pt_MotherIDs.end()
+            or std::find( m_pt_MotherIDs.begin(), m_pt_MotherIDs.end(), (*part)->getUserRecord( m_key_mother_id ).toInt32() ) != m_pt_MotherIDs.end()
             ) ) {
          s3_particlesSelected.push_back( *part );
       }
@@ -124,13 +129,13 @@ bool GenSelector::CheckNumberOfParticles( pxlParticles const &s3_particlesSelect
 
    if( s3_particlesSelected.size() < 2 ) {
       for( pxlParticles::const_iterator part = s3_particlesSelected.begin(); part != s3_particlesSelected.end(); ++part ) {
-         std::cerr << "ID=" << ( *part )->getUserRecord( "id" ).toInt32() << " mother=" << (*part)->getUserRecord( "mother_id" ).toInt32() << std::endl;
+         std::cerr << "ID=" << ( *part )->getUserRecord( m_key_id ).toInt32() << " mother=" << (*part)->getUserRecord( m_key_mother_id ).toInt32() << std::endl;
       }
       throw std::length_error( "Can't build resonance particle with less than 2 particles." );
    }
    else if( s3_particlesSelected.size() > 3 ) {
       for( pxlParticles::const_iterator part = s3_particlesSelected.begin(); part != s3_particlesSelected.end(); ++part ) {
-         std::cerr << "ID=" << ( *part )->getUserRecord( "id" ).toInt32() << " mother=" << (*part)->getUserRecord( "mother_id" ).toInt32() << std::endl;
+         std::cerr << "ID=" << ( *part )->getUserRecord( m_key_id ).toInt32() << " mother=" << (*part)->getUserRecord( m_key_mother_id ).toInt32() << std::endl;
       }
       throw std::length_error( "Can't build resonance particle with more than 2 particles." );
    }
@@ -48,6 +48,11 @@ private:
    double const m_pt_max;
    std::vector< int > m_pt_IDs;
    std::vector< int > m_pt_MotherIDs;
+
+   // User record keys, resolved once:
+   pxl::UserRecordKey const m_key_binScale;
+   pxl::UserRecordKey const m_key_id;
+   pxl::UserRecordKey const m_key_mother_id;
 };
 
 #endif /*GENSELECTOR*/
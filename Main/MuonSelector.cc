@@ -28,7 +28,40 @@ MuonSelector::MuonSelector( const Tools::MConfig &cfg ):
     m_xyImpactParameter_max(          cfg.GetItem< double >(  "Muon.XYImpactParameter.max") ),
     m_nPixelHits_min(                 cfg.GetItem< int >(     "Muon.NPixelHits.min") ),
     m_nTrackerLayersWithMeas_min(     cfg.GetItem< int >(     "Muon.NTrackerLayersWithMeas.min") ),
-    m_dPtRelTrack_max(                cfg.GetItem< double >(  "Muon.dPtRelTrack.max") )
+    m_dPtRelTrack_max(                cfg.GetItem< double >(  "Muon.dPtRelTrack.max") ),
+
+    // User record keys:
+    m_key_GenIso(                        "GenIso" ),
+    m_key_isTightMuon(                   "isTightMuon" ),
+    m_key_isHighPtMuon(                  "isHighPtMuon" ),
+    m_key_TrkIso(                        "TrkIso" ),
+    m_key_PFIsoR04ChargedHadrons(        "PFIsoR04ChargedHadrons" ),
+    m_key_PFIsoR04NeutralHadrons(        "PFIsoR04NeutralHadrons" ),
+    m_key_PFIsoR04Photons(               "PFIsoR04Photons" ),
+    m_key_PFIsoR04PU(                    "PFIsoR04PU" ),
+    m_key_PFIsoR03ChargedHadrons(        "PFIsoR03ChargedHadrons" ),
+    m_key_PFIsoR03NeutralHadrons(        "PFIsoR03NeutralHadrons" ),
+    m_key_PFIsoR03Photons(               "PFIsoR03Photons" ),
+    m_key_PFIsoR03PU(                    "PFIsoR03PU" ),
+    m_key_ECALIso(                       "ECALIso" ),
+    m_key_HCALIso(                       "HCALIso" ),
+    m_key_isGlobalMuon(                  "isGlobalMuon" ),
+    m_key_isPFMuon(                      "isPFMuon" ),
+    m_key_NormChi2(                      "NormChi2" ),
+    m_key_VHitsMuonSys(                  "VHitsMuonSys" ),
+    m_key_NMatchedStations(              "NMatchedStations" ),
+    m_key_Dxy(                           "Dxy" ),
+    m_key_Dz(                            "Dz" ),
+    m_key_VHitsPixel(                    "VHitsPixel" ),
+    m_key_TrackerLayersWithMeas(         "TrackerLayersWithMeas" ),
+    m_key_validCocktail(                 "validCocktail" ),
+    m_key_NMatchedStationsCocktail(      "NMatchedStationsCocktail" ),
+    m_key_VHitsPixelCocktail(            "VHitsPixelCocktail" ),
+    m_key_TrackerLayersWithMeasCocktail( "TrackerLayersWithMeasCocktail" ),
+    m_key_ptErrorCocktail(               "ptErrorCocktail" ),
+    m_key_ptCocktail(                    "ptCocktail" ),
+    m_key_alternative_Dxy(               "DxyBT" ),
+    m_key_alternative_Dz(                "DzBT" )
 {
     m_useAlternative=false;
 }
@@ -45,21 +78,14 @@ int MuonSelector::passMuon( pxl::Particle *muon, const bool& isRec ,double const
         }catch(std::runtime_error &e) {
             std::cout << e.what() << '\n';
             std::cout << e.what() << '\n';
+            // Older skims store the impact parameters as "DxyBT" and "DzBT".
             m_useAlternative=true;
-            m_alternativeUserVariables["DxyGTBS"]="DxyBS";
-            m_alternativeUserVariables["DzIT"]="Dz";
-            m_alternativeUserVariables["DzIT"]="DzBS";
-            m_alternativeUserVariables["DxyGT"]="Dxy";
-            m_alternativeUserVariables["Dz"]="DzBT";
-            m_alternativeUserVariables["Dxy"]="DxyBT";
-            m_alternativeUserVariables["isGoodTMOneST"]="TMOneStationTight";
-            m_alternativeUserVariables["isGoodLastST"]="lastStationTight";
             return muonID(muon, rho);
         }
     }
     //generator muon cuts
     else{
-        double const muon_rel_iso = muon->getUserRecord( "GenIso" ).toDouble() / muon->getPt();
+        double const muon_rel_iso = muon->getUserRecord( m_key_GenIso ).toDouble() / muon->getPt();
         // Gen iso cut.
         bool iso_failed = muon_rel_iso > m_muo_iso_max;
         //turn around for iso-inversion
@@ -96,14 +122,14 @@ int MuonSelector::muonID( pxl::Particle *muon , double rho) const {
     // isTightMuon or isHighPtMuon
     if(m_muo_id_type=="musicID.bool"){
         if(muon->getPt()<m_muo_HighPtSwitchPt){
-            if( not muon->getUserRecord("isTightMuon")) passID=false;
+            if( not muon->getUserRecord(m_key_isTightMuon)) passID=false;
         }else{
-            if( not muon->getUserRecord("isHighPtMuon")) passID=false;
+            if( not muon->getUserRecord(m_key_isHighPtMuon)) passID=false;
         }
     }else if(m_muo_id_type=="isTightMuon.bool"){
-        if(not muon->getUserRecord("isTightMuon")) passID=false;
+        if(not muon->getUserRecord(m_key_isTightMuon)) passID=false;
     }else if(m_muo_id_type=="isHighPtMuon.bool"){
-        if(not muon->getUserRecord("isHighPtMuon")) passID=false;
+        if(not muon->getUserRecord(m_key_isHighPtMuon)) passID=false;
     }else if(m_muo_id_type=="isTightMuon.Cut"){
         if ( not tightMuonIDCut(muon) ){
             passID=false;
@@ -124,15 +150,15 @@ int MuonSelector::muonID( pxl::Particle *muon , double rho) const {
     // Muon isolation.
     double muon_iso;
     if( m_muo_iso_type == "Tracker" ) {
-      muon_iso = muon->getUserRecord( "TrkIso" );
+      muon_iso = muon->getUserRecord( m_key_TrkIso );
     } else if( m_muo_iso_type == "PF" ) {
       //[sumChargedHadronPt+ max(0.,sumNeutralHadronPt+sumPhotonPt-0.5sumPUPt]/pt
         if( m_muo_iso_useDeltaBetaCorr && !m_muo_iso_useRhoCorr) {
-            muon_iso = muon->getUserRecord( "PFIsoR04ChargedHadrons" ).toDouble()
+            muon_iso = muon->getUserRecord( m_key_PFIsoR04ChargedHadrons ).toDouble()
                 + max( 0.,
-                    muon->getUserRecord( "PFIsoR04NeutralHadrons" ).toDouble()
-                    + muon->getUserRecord( "PFIsoR04Photons" ).toDouble()
-                    - 0.5 * muon->getUserRecord( "PFIsoR04PU" ).toDouble()
+                    muon->getUserRecord( m_key_PFIsoR04NeutralHadrons ).toDouble()
+                    + muon->getUserRecord( m_key_PFIsoR04Photons ).toDouble()
+                    - 0.5 * muon->getUserRecord( m_key_PFIsoR04PU ).toDouble()
                 );
         } else if (m_muo_iso_useDeltaBetaCorr && !m_muo_iso_useRhoCorr){
             //PFIsoCorr = PF(ChHad PFNoPU) + Max ((PF(Nh+Ph) - ρ’EACombined),0.0)) where ρ’=max(ρ,0.0) and with a 0.5 GeV threshold on neutrals
@@ -140,35 +166,35 @@ int MuonSelector::muonID( pxl::Particle *muon , double rho) const {
             double const photonEA = m_muo_EA.getEffectiveArea(          fabs(muon->getEta()), EffectiveArea::photon );
             double const neutralHadronEA = m_muo_EA.getEffectiveArea(   fabs(muon->getEta()), EffectiveArea::neutralHadron );
 
-            muon_iso = muon->getUserRecord( "PFIsoR04ChargedHadrons" ).toDouble()
+            muon_iso = muon->getUserRecord( m_key_PFIsoR04ChargedHadrons ).toDouble()
                 + max( 0.,
-                    muon->getUserRecord( "PFIsoR04NeutralHadrons" ).toDouble()
-                    + muon->getUserRecord( "PFIsoR04Photons" ).toDouble()
+                    muon->getUserRecord( m_key_PFIsoR04NeutralHadrons ).toDouble()
+                    + muon->getUserRecord( m_key_PFIsoR04Photons ).toDouble()
                     -  rho* (photonEA+neutralHadronEA)
                 );
 
         } else {
-            muon_iso = muon->getUserRecord( "PFIsoR04ChargedHadrons" ).toDouble()
-                + muon->getUserRecord( "PFIsoR04NeutralHadrons" ).toDouble()
-                + muon->getUserRecord( "PFIsoR04Photons" ).toDouble();
+            muon_iso = muon->getUserRecord( m_key_PFIsoR04ChargedHadrons ).toDouble()
+                + muon->getUserRecord( m_key_PFIsoR04NeutralHadrons ).toDouble()
+                + muon->getUserRecord( m_key_PFIsoR04Photons ).toDouble();
         }
     } else if( m_muo_iso_type == "PFCombined03" ) { //not supported anymore
         if( m_muo_iso_useDeltaBetaCorr ) {
-            muon_iso = muon->getUserRecord( "PFIsoR03ChargedHadrons" ).toDouble()
+            muon_iso = muon->getUserRecord( m_key_PFIsoR03ChargedHadrons ).toDouble()
                 + max( 0.,
-                    muon->getUserRecord( "PFIsoR03NeutralHadrons" ).toDouble()
-                    + muon->getUserRecord( "PFIsoR03Photons" ).toDouble()
-                    - 0.5 * muon->getUserRecord( "PFIsoR03PU" ).toDouble()
+                    muon->getUserRecord( m_key_PFIsoR03NeutralHadrons ).toDouble()
+                    + muon->getUserRecord( m_key_PFIsoR03Photons ).toDouble()
+                    - 0.5 * muon->getUserRecord( m_key_PFIsoR03PU ).toDouble()
                 );
         } else {
-            muon_iso = muon->getUserRecord( "PFIsoR03ChargedHadrons" ).toDouble()
-                + muon->getUserRecord( "PFIsoR03NeutralHadrons" ).toDouble()
-                + muon->getUserRecord( "PFIsoR03Photons" ).toDouble();
+            muon_iso = muon->getUserRecord( m_key_PFIsoR03ChargedHadrons ).toDouble()
+                + muon->getUserRecord( m_key_PFIsoR03NeutralHadrons ).toDouble()
+                + muon->getUserRecord( m_key_PFIsoR03Photons ).toDouble();
         }
     } else if( m_muo_iso_type == "Combined" ) { // not supported anymore
-        muon_iso = muon->getUserRecord( "TrkIso" ).toDouble()
-            + muon->getUserRecord( "ECALIso" ).toDouble()
-            + muon->getUserRecord( "HCALIso" ).toDouble();
+        muon_iso = muon->getUserRecord( m_key_TrkIso ).toDouble()
+            + muon->getUserRecord( m_key_ECALIso ).toDouble()
+            + muon->getUserRecord( m_key_HCALIso ).toDouble();
     } else {
       throw Tools::config_error( "In passMuon(...): Invalid isolation type: '" + m_muo_iso_type + "'" );
     }
@@ -192,21 +218,20 @@ int MuonSelector::muonID( pxl::Particle *muon , double rho) const {
 
 bool MuonSelector::tightMuonIDCut(pxl::Particle *muon) const{
 
-    if( not muon->getUserRecord("isGlobalMuon").toBool() )                          return false;
-    if( not muon->getUserRecord("isPFMuon").toBool() )                              return false;
-    if( muon->getUserRecord("NormChi2").toInt32() > m_globalChi2_max)               return false;
-    if( muon->getUserRecord("VHitsMuonSys").toInt32() < m_nMuonHits_min)            return false;
-    if( muon->getUserRecord("NMatchedStations").toInt32() < m_nMatchedStations_min) return false;
+    if( not muon->getUserRecord(m_key_isGlobalMuon).toBool() )                          return false;
+    if( not muon->getUserRecord(m_key_isPFMuon).toBool() )                              return false;
+    if( muon->getUserRecord(m_key_NormChi2).toInt32() > m_globalChi2_max)               return false;
+    if( muon->getUserRecord(m_key_VHitsMuonSys).toInt32() < m_nMuonHits_min)            return false;
+    if( muon->getUserRecord(m_key_NMatchedStations).toInt32() < m_nMatchedStations_min) return false;
     if(!m_useAlternative){
-        if( muon->getUserRecord("Dxy").toDouble() > m_xyImpactParameter_max)            return false;
-        if( muon->getUserRecord("Dz").toDouble() > m_zImpactParameter_max)            return false;
+        if( muon->getUserRecord(m_key_Dxy).toDouble() > m_xyImpactParameter_max)            return false;
+        if( muon->getUserRecord(m_key_Dz).toDouble() > m_zImpactParameter_max)            return false;
     }else{
-        m_alternativeUserVariables["Dxy"];
-        if( muon->getUserRecord(m_alternativeUserVariables["Dxy"]).toDouble() > m_xyImpactParameter_max)            return false;
-        if( muon->getUserRecord(m_alternativeUserVariables["Dz"]).toDouble() > m_zImpactParameter_max)            return false;
+        if( muon->getUserRecord(m_key_alternative_Dxy).toDouble() > m_xyImpactParameter_max)            return false;
+        if( muon->getUserRecord(m_key_alternative_Dz).toDouble() > m_zImpactParameter_max)            return false;
     }
-    if( muon->getUserRecord("VHitsPixel").toInt32() < m_nPixelHits_min)             return false;
-    if( muon->getUserRecord("TrackerLayersWithMeas").toInt32() < m_nTrackerLayersWithMeas_min)
+    if( muon->getUserRecord(m_key_VHitsPixel).toInt32() < m_nPixelHits_min)             return false;
+    if( muon->getUserRecord(m_key_TrackerLayersWithMeas).toInt32() < m_nTrackerLayersWithMeas_min)
         return false;
     return true;
 }
@@ -214,26 +239,26 @@ bool MuonSelector::tightMuonIDCut(pxl::Particle *muon) const{
 
 
 bool MuonSelector::HighptMuonIDCut(pxl::Particle *muon) const{
-    if( not muon->getUserRecord("validCocktail").toBool() )                                 return false;
-    if( not muon->getUserRecord("isGlobalMuon").toBool() )                                  return false;
+    if( not muon->getUserRecord(m_key_validCocktail).toBool() )                                 return false;
+    if( not muon->getUserRecord(m_key_isGlobalMuon).toBool() )                                  return false;
     //if( muon->getUserRecord("VHitsMuonSysCocktail").toInt32() < m_nMuonHits_min)            return false;
-    if( muon->getUserRecord("VHitsMuonSys").toInt32() < m_nMuonHits_min)            return false;
-    if (muon->hasUserRecord("NMatchedStationsCocktail")){
-        if( muon->getUserRecord("NMatchedStationsCocktail").toInt32() < m_nMatchedStations_min) return false;
+    if( muon->getUserRecord(m_key_VHitsMuonSys).toInt32() < m_nMuonHits_min)            return false;
+    if (muon->hasUserRecord(m_key_NMatchedStationsCocktail)){
+        if( muon->getUserRecord(m_key_NMatchedStationsCocktail).toInt32() < m_nMatchedStations_min) return false;
     }else{
-        if( muon->getUserRecord("NMatchedStations").toInt32() < m_nMatchedStations_min) return false;
+        if( muon->getUserRecord(m_key_NMatchedStations).toInt32() < m_nMatchedStations_min) return false;
     }
     if(!m_useAlternative){
-        if( muon->getUserRecord("Dxy").toDouble() > m_xyImpactParameter_max)            return false;
-        if( muon->getUserRecord("Dz").toDouble() > m_zImpactParameter_max)            return false;
+        if( muon->getUserRecord(m_key_Dxy).toDouble() > m_xyImpactParameter_max)            return false;
+        if( muon->getUserRecord(m_key_Dz).toDouble() > m_zImpactParameter_max)            return false;
     }else{
-        if( muon->getUserRecord(m_alternativeUserVariables["Dxy"]).toDouble() > m_xyImpactParameter_max)            return false;
-        if( muon->getUserRecord(m_alternativeUserVariables["Dz"]).toDouble() > m_zImpactParameter_max)            return false;
+        if( muon->getUserRecord(m_key_alternative_Dxy).toDouble() > m_xyImpactParameter_max)            return false;
+        if( muon->getUserRecord(m_key_alternative_Dz).toDouble() > m_zImpactParameter_max)            return false;
     }
-    if( muon->getUserRecord("VHitsPixelCocktail").toInt32() < m_nPixelHits_min)             return false;
-    if( muon->getUserRecord("TrackerLayersWithMeasCocktail").toInt32() < m_nTrackerLayersWithMeas_min)
+    if( muon->getUserRecord(m_key_VHitsPixelCocktail).toInt32() < m_nPixelHits_min)             return false;
+    if( muon->getUserRecord(m_key_TrackerLayersWithMeasCocktail).toInt32() < m_nTrackerLayersWithMeas_min)
         return false;
-    if( muon->getUserRecord("ptErrorCocktail").toDouble()/muon->getUserRecord("ptCocktail").toDouble() > m_dPtRelTrack_max )
+    if( muon->getUserRecord(m_key_ptErrorCocktail).toDouble()/muon->getUserRecord(m_key_ptCocktail).toDouble() > m_dPtRelTrack_max )
         return false;
     return true;
 }
@@ -10,7 +10,6 @@ This class contains all the muon selections
 
 
 #include <string>
-#include <map>
 #include "Pxl/Pxl/interface/pxl/core.hh"
 #include "Pxl/Pxl/interface/pxl/hep.hh"
 #include "Tools/MConfig.hh"
@@ -51,7 +50,39 @@ private:
     int const           m_nTrackerLayersWithMeas_min;
     double const        m_dPtRelTrack_max;
     bool mutable        m_useAlternative;
-    std::map<std::string,std::string> mutable m_alternativeUserVariables;
+
+    // User record keys, resolved once:
+    pxl::UserRecordKey const m_key_GenIso;
+    pxl::UserRecordKey const m_key_isTightMuon;
+    pxl::UserRecordKey const m_key_isHighPtMuon;
+    pxl::UserRecordKey const m_key_TrkIso;
+    pxl::UserRecordKey const m_key_PFIsoR04ChargedHadrons;
+    pxl::UserRecordKey const m_key_PFIsoR04NeutralHadrons;
+    pxl::UserRecordKey const m_key_PFIsoR04Photons;
+    pxl::UserRecordKey const m_key_PFIsoR04PU;
+    pxl::UserRecordKey const m_key_PFIsoR03ChargedHadrons;
+    pxl::UserRecordKey const m_key_PFIsoR03NeutralHadrons;
+    pxl::UserRecordKey const m_key_PFIsoR03Photons;
+    pxl::UserRecordKey const m_key_PFIsoR03PU;
+    pxl::UserRecordKey const m_key_ECALIso;
+    pxl::UserRecordKey const m_key_HCALIso;
+    pxl::UserRecordKey const m_key_isGlobalMuon;
+    pxl::UserRecordKey const m_key_isPFMuon;
+    pxl::UserRecordKey const m_key_NormChi2;
+    pxl::UserRecordKey const m_key_VHitsMuonSys;
+    pxl::UserRecordKey const m_key_NMatchedStations;
+    pxl::UserRecordKey const m_key_Dxy;
+    pxl::UserRecordKey const m_key_Dz;
+    pxl::UserRecordKey const m_key_VHitsPixel;
+    pxl::UserRecordKey const m_key_TrackerLayersWithMeas;
+    pxl::UserRecordKey const m_key_validCocktail;
+    pxl::UserRecordKey const m_key_NMatchedStationsCocktail;
+    pxl::UserRecordKey const m_key_VHitsPixelCocktail;
+    pxl::UserRecordKey const m_key_TrackerLayersWithMeasCocktail;
+    pxl::UserRecordKey const m_key_ptErrorCocktail;
+    pxl::UserRecordKey const m_key_ptCocktail;
+    pxl::UserRecordKey const m_key_alternative_Dxy;
+    pxl::UserRecordKey const m_key_alternative_Dz;
 
 };
 #endif
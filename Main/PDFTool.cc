@@ -10,6 +10,17 @@
 
 using namespace pdf;
 
+// Keys of the weights written by older skims (we had 41 PDF sets in the past).
+static std::vector< pxl::UserRecordKey > oldWeightKeys() {
+   std::vector< pxl::UserRecordKey > keys;
+   for( unsigned int i = 1; i < 41; ++i ) {
+      std::stringstream sstream;
+      sstream << "w" << i;
+      keys.push_back( pxl::UserRecordKey( sstream.str() ) );
+   }
+   return keys;
+}
+
 PDFTool::PDFTool( Tools::MConfig const &config, unsigned int const debug ) :
    m_pdfInfo(),
    m_debug( debug ),
@@ -22,7 +33,9 @@ PDFTool::PDFTool( Tools::MConfig const &config, unsigned int const debug ) :
                              ) ),
    m_pdfSetsCTEQ( initCTEQPDFs( config ) ),
    m_pdfSetsMSTW( initMSTWPDFs( config ) ),
-   m_pdfSetsNNPDF( initNNPDFPDFs( config ) )
+   m_pdfSetsNNPDF( initNNPDFPDFs( config ) ),
+   m_oldWeightKeys( oldWeightKeys() ),
+   m_pdfWeightsKey( "pdfWeights" )
 {
    // Set the init flag in PDFInfo. This is important when merging later!
    m_pdfInfo.init = true;
@@ -175,14 +188,11 @@ void PDFTool::setPDFWeights( pxl::Event &event ) const {
    // Remove the old weights.
    // TODO: Once the new reweighting (i.e. this here) is established, the
    // calculation of weights should be removed from the Skimmer!
-   // Ugly hard-coded stuff (we had 41 PDF sets in the past).
    try{
-      for( unsigned int i = 1; i < 41; ++i ) {
-         std::stringstream sstream;
-         sstream << "w" << i;
-         std::string const str_i = sstream.str();
-         GenEvtView->eraseUserRecord( str_i );
-         RecEvtView->eraseUserRecord( str_i );
+      std::vector< pxl::UserRecordKey >::const_iterator key;
+      for( key = m_oldWeightKeys.begin(); key != m_oldWeightKeys.end(); ++key ) {
+         GenEvtView->eraseUserRecord( *key );
+         RecEvtView->eraseUserRecord( *key );
       }
    } catch( std::runtime_error ) {
    }
@@ -196,55 +206,24 @@ void PDFTool::setPDFWeights( pxl::Event &event ) const {
    float const prodWeight = m_pdfProd->xfxQ( f1, x1, Q ) *
                             m_pdfProd->xfxQ( f2, x2, Q );
 
-   // Get the weight for every loaded PDFSet, write it into the event!
-   std::string const w( "w" );
-   unsigned int count = 1;
+   // Get the weight for every loaded PDFSet, write them into the event!
+   std::vector< float > weights;
+   weights.reserve( m_pdfSetsCTEQ.size() + m_pdfSetsMSTW.size() + m_pdfSetsNNPDF.size() );
 
    // Only three kinds of PDF sets at the moment, so treat them one by one.
-   PDFSets::const_iterator PDFSet;
-   for( PDFSet = m_pdfSetsCTEQ.begin(); PDFSet != m_pdfSetsCTEQ.end(); ++PDFSet ) {
-      // Compute the PDF weight for this event.
-      float const pdfWeight = (*PDFSet)->xfxQ( f1, x1, Q ) *
-                              (*PDFSet)->xfxQ( f2, x2, Q );
-
-      // Divide the new weight by the weight from the PDF the event was produced
-      // with.
-      float const weight = pdfWeight/prodWeight;
-
-      std::stringstream stream;
-      stream << "w" << count;
-      event.setUserRecord( stream.str(), weight );
-      ++count;
-   }
-
-   for( PDFSet = m_pdfSetsMSTW.begin(); PDFSet != m_pdfSetsMSTW.end(); ++PDFSet ) {
-      // Compute the PDF weight for this event.
-      float const pdfWeight = (*PDFSet)->xfxQ( f1, x1, Q ) *
-                              (*PDFSet)->xfxQ( f2, x2, Q );
-
-      // Divide the new weight by the weight from the PDF the event was produced
-      // with.
-      float const weight = pdfWeight/prodWeight;
-
-      std::stringstream stream;
-      stream << "w" << count;
-      event.setUserRecord( stream.str(), weight );
-      ++count;
-
+   PDFSets const *sets[] = { &m_pdfSetsCTEQ, &m_pdfSetsMSTW, &m_pdfSetsNNPDF };
+   for( unsigned int i = 0; i < 3; ++i ) {
+      PDFSets::const_iterator PDFSet;
+      for( PDFSet = sets[ i ]->begin(); PDFSet != sets[ i ]->end(); ++PDFSet ) {
+         // Compute the PDF weight for this event.
+         float const pdfWeight = (*PDFSet)->xfxQ( f1, x1, Q ) *
+                                 (*PDFSet)->xfxQ( f2, x2, Q );
+
+         // Divide the new weight by the weight from the PDF the event was
+         // produced with.
+         weights.push_back( pdfWeight/prodWeight );
+      }
    }
 
-   for( PDFSet = m_pdfSetsNNPDF.begin(); PDFSet != m_pdfSetsNNPDF.end(); ++PDFSet ) {
-      // Compute the PDF weight for this event.
-      float const pdfWeight = (*PDFSet)->xfxQ( f1, x1, Q ) *
-                              (*PDFSet)->xfxQ( f2, x2, Q );
-
-      // Divide the new weight by the weight from the PDF the event was produced
-      // with.
-      float const weight = pdfWeight/prodWeight;
-
-      std::stringstream stream;
-      stream << "w" << count;
-      event.setUserRecord( stream.str(), weight );
-      ++count;
-   }
+   event.setUserRecord( m_pdfWeightsKey, weights );
 }
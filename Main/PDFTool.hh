@@ -28,6 +28,8 @@ class PDFTool {
       ~PDFTool() {}
 
    // Delete old and write new PDF weights into the pxl::Event.
+   // The weights of all PDF sets (CTEQ, MSTW, NNPDF, in this order) are stored
+   // as one float array in the user record "pdfWeights".
    void setPDFWeights( pxl::Event &event ) const;
    pdf::PDFInfo const &getPDFInfo() const { return m_pdfInfo; }
 
@@ -54,6 +56,10 @@ class PDFTool {
       PDFSets const m_pdfSetsCTEQ;
       PDFSets const m_pdfSetsMSTW;
       PDFSets const m_pdfSetsNNPDF;
+
+      // Weights written by older skims as separate user records "w1", "w2", ...
+      std::vector< pxl::UserRecordKey > const m_oldWeightKeys;
+      pxl::UserRecordKey const m_pdfWeightsKey;
 };
 
 }
@@ -1,5 +1,6 @@
 #include "SkipEvents.hh"
 
+#include <cstdlib>
 #include <iostream>
 #include <utility> // make_pair
 
@@ -138,3 +139,20 @@ bool SkipEvents::skip( unsigned int const runNumber,
 
    return false;
 }
+
+
+bool SkipEventsFilter::operator()( std::string const &info ) const {
+   std::string run, lumi, event;
+   if( not pxl::SectionInfo::getValue( info, "Run", run ) or
+       not pxl::SectionInfo::getValue( info, "LumiSection", lumi ) or
+       not pxl::SectionInfo::getValue( info, "EventNum", event ) ) return true;
+
+   if( m_skipEvents.skip( std::strtoul( run.c_str(), 0, 10 ),
+                          std::strtoul( lumi.c_str(), 0, 10 ),
+                          std::strtoul( event.c_str(), 0, 10 ) ) ) {
+      ++m_skipped;
+      return false;
+   }
+
+   return true;
+}
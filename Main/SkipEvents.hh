@@ -11,6 +11,8 @@
 #include <boost/filesystem.hpp>
 #pragma GCC diagnostic pop
 
+#include "Pxl/Pxl/interface/pxl/core/InfoCondition.hh"
+
 namespace Tools {
    class MConfig;
 }
@@ -51,4 +53,26 @@ class SkipEvents {
       std::pair< unsigned int, unsigned int > m_dontSkip;
 };
 
+// Applies SkipEvents to the Run/LumiSection/EventNum values in the info string
+// of a file section (see pxl::OutputHandler::setSectionInfoKeys), so skipped
+// events are rejected before they are inflated. Sections without these values
+// pass and have to be checked after reading.
+class SkipEventsFilter : public pxl::InfoCondition {
+   public:
+      explicit SkipEventsFilter( SkipEvents const &skipEvents ) :
+         m_skipEvents( skipEvents ),
+         m_skipped( 0 )
+      {}
+
+      virtual bool operator()( std::string const &info ) const;
+
+      // Number of rejected events.
+      unsigned int skipped() const { return m_skipped; }
+
+   private:
+      // Own copy, since the filter is evaluated in the read-ahead thread.
+      mutable SkipEvents m_skipEvents;
+      mutable unsigned int m_skipped;
+};
+
 #endif /*SKIPEVENTS*/
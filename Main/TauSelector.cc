@@ -5,6 +5,13 @@
 #include "Tools/Tools.hh"
 #include "Tools/PXL/Sort.hh"
 
+// User record keys of the given discriminators.
+static std::vector< pxl::UserRecordKey > discriminatorKeys( std::vector< std::string > const &discriminators ) {
+   std::vector< pxl::UserRecordKey > keys;
+   for( std::vector< std::string >::const_iterator discr = discriminators.begin(); discr != discriminators.end(); ++discr )
+      keys.push_back( pxl::UserRecordKey( *discr ) );
+   return keys;
+}
 
 //--------------------Constructor-----------------------------------------------------------------
 
@@ -14,7 +21,8 @@ TauSelector::TauSelector( const Tools::MConfig &cfg ):
    m_tau_pt_min(  cfg.GetItem< double >( "Tau.pt.min" ) ),
    m_tau_eta_max( cfg.GetItem< double >( "Tau.Eta.max" ) ),
    //Get Tau-Discriminators and save them
-   m_tau_discriminators( Tools::splitString< std::string >( cfg.GetItem< std::string >( "Tau.Discriminators" ), true ) )
+   m_tau_discriminators( Tools::splitString< std::string >( cfg.GetItem< std::string >( "Tau.Discriminators" ), true ) ),
+   m_tau_discriminatorKeys( discriminatorKeys( m_tau_discriminators ) )
 {
 }
 
@@ -37,7 +45,7 @@ bool TauSelector::passTau( pxl::Particle *tau, const bool &isRec ) const{
    if( fabs( tau->getEta() ) > m_tau_eta_max )
       return false;
    if( isRec ) {
-      for( std::vector< std::string >::const_iterator discr = m_tau_discriminators.begin(); discr != m_tau_discriminators.end(); ++discr ) {
+      for( std::vector< pxl::UserRecordKey >::const_iterator discr = m_tau_discriminatorKeys.begin(); discr != m_tau_discriminatorKeys.end(); ++discr ) {
          // In theory all tau discriminators have a value between 0 and 1.
          // Thus, they are saved as a float and the cut value is 0.5.
          // In practice most (or all) discriminators are boolean.
@@ -27,5 +27,6 @@ private:
     double const  m_tau_eta_max;
     // Discriminators:
     std::vector< std::string > const m_tau_discriminators;
+    std::vector< pxl::UserRecordKey > const m_tau_discriminatorKeys;
 };
 #endif
@@ -0,0 +1,129 @@
+// Microbenchmark of the lookups by Id: ObjectFactory::create() and
+// ObjectOwner::getById(), each next to the same lookups in a pxl::IdMap and
+// in the std::map these classes used before.
+//
+// Usage: benchIdLookup [number of lookups, default 10000000]
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <vector>
+#include <sys/time.h>
+
+#include "Pxl/Pxl/interface/pxl/core.hh"
+#include "Pxl/Pxl/interface/pxl/hep.hh"
+
+namespace {
+
+   double now() {
+      timeval tv;
+      gettimeofday( &tv, 0 );
+      return tv.tv_sec + 1e-6 * tv.tv_usec;
+   }
+
+   void report( std::string const &what, unsigned long count, double seconds ) {
+      std::cout << std::setw( 44 ) << std::left << what
+                << std::setw( 8 ) << std::right << std::fixed << std::setprecision( 3 ) << seconds << " s"
+                << std::setw( 8 ) << std::setprecision( 1 ) << 1e9 * seconds / count << " ns each"
+                << std::endl;
+   }
+
+   typedef pxl::Serializable *( *CreateFunction )();
+
+   template< class T > pxl::Serializable *createObject() {
+      return new T;
+   }
+
+   // the same random sequence for every variant
+   std::vector< size_t > sequence( size_t size, unsigned long count ) {
+      std::vector< size_t > positions( count );
+      srand( 1 );
+      for( unsigned long i = 0; i < count; ++i ) positions[ i ] = rand() % size;
+      return positions;
+   }
+
+}
+
+int main( int argc, char* argv[] ) {
+   unsigned long const lookups = argc > 1 ? strtoul( argv[ 1 ], 0, 10 ) : 10000000;
+   pxl::Core::initialize();
+   pxl::Hep::initialize();
+
+   // the types of an event, created as they come when reading: mostly
+   // particles, some vertices and views
+   std::vector< pxl::Id > types;
+   std::vector< CreateFunction > functions;
+   types.push_back( pxl::Particle::getStaticTypeId() );        functions.push_back( createObject< pxl::Particle > );
+   types.push_back( pxl::Vertex::getStaticTypeId() );          functions.push_back( createObject< pxl::Vertex > );
+   types.push_back( pxl::Collision::getStaticTypeId() );       functions.push_back( createObject< pxl::Collision > );
+   types.push_back( pxl::EventView::getStaticTypeId() );       functions.push_back( createObject< pxl::EventView > );
+   types.push_back( pxl::Event::getStaticTypeId() );           functions.push_back( createObject< pxl::Event > );
+   types.push_back( pxl::BasicContainer::getStaticTypeId() );  functions.push_back( createObject< pxl::BasicContainer > );
+   std::vector< size_t > order( lookups / 10 );
+   srand( 2 );
+   for( size_t i = 0; i < order.size(); ++i ) order[ i ] = rand() % 8 < 6 ? 0 : rand() % 4;
+
+   pxl::IdMap< CreateFunction > idMapFunctions;
+   std::map< pxl::Id, CreateFunction > stdMapFunctions;
+   for( size_t i = 0; i < types.size(); ++i ) {
+      idMapFunctions.insert( types[ i ], functions[ i ] );
+      stdMapFunctions.insert( std::make_pair( types[ i ], functions[ i ] ) );
+   }
+
+   std::cout << "create and delete, " << order.size() << " objects of " << types.size() << " types" << std::endl;
+   double start = now();
+   for( size_t i = 0; i < order.size(); ++i ) {
+      delete stdMapFunctions.find( types[ order[ i ] ] )->second();
+   }
+   report( "  std::map", order.size(), now() - start );
+   start = now();
+   for( size_t i = 0; i < order.size(); ++i ) {
+      delete idMapFunctions.get( types[ order[ i ] ] )();
+   }
+   report( "  pxl::IdMap", order.size(), now() - start );
+   start = now();
+   for( size_t i = 0; i < order.size(); ++i ) {
+      delete pxl::ObjectFactory::instance().create( types[ order[ i ] ] );
+   }
+   report( "  pxl::ObjectFactory::create", order.size(), now() - start );
+
+   size_t const sizes[] = { 20, 200, 2000 };
+   for( unsigned int s = 0; s < sizeof( sizes ) / sizeof( sizes[ 0 ] ); ++s ) {
+      pxl::EventView view;
+      std::vector< pxl::Id > ids;
+      std::map< pxl::Id, pxl::Relative* > stdMap;
+      pxl::IdMap< pxl::Relative* > idMap;
+      for( size_t i = 0; i < sizes[ s ]; ++i ) {
+         pxl::Particle *particle = view.create< pxl::Particle >();
+         ids.push_back( particle->getId() );
+         stdMap.insert( std::make_pair( particle->getId(), particle ) );
+         idMap.insert( particle->getId(), particle );
+      }
+      std::vector< size_t > const positions = sequence( ids.size(), lookups );
+      pxl::ObjectOwner const &owner = view.getObjectOwner();
+
+      std::cout << "getById, " << lookups << " lookups among " << sizes[ s ] << " objects" << std::endl;
+      unsigned long found = 0;
+      start = now();
+      for( unsigned long i = 0; i < lookups; ++i ) {
+         found += stdMap.find( ids[ positions[ i ] ] ) != stdMap.end();
+      }
+      report( "  std::map", lookups, now() - start );
+      start = now();
+      for( unsigned long i = 0; i < lookups; ++i ) {
+         found += idMap.get( ids[ positions[ i ] ] ) != 0;
+      }
+      report( "  pxl::IdMap", lookups, now() - start );
+      start = now();
+      for( unsigned long i = 0; i < lookups; ++i ) {
+         found += owner.getById( ids[ positions[ i ] ] ) != 0;
+      }
+      report( "  pxl::ObjectOwner::getById", lookups, now() - start );
+      if( found != 3 * lookups ) {
+         std::cerr << "Objects not found." << std::endl;
+         return 1;
+      }
+   }
+   return 0;
+}
@@ -0,0 +1,94 @@
+// Benchmark of UserRecords::deserialize() and of copying UserRecords.
+//
+// Usage: benchUserRecords [number of records read, default 100000]
+//
+// The records are those of a typical event: 40 strings, half of them longer
+// than the small buffer of std::string, and 20 doubles. They are read into
+// the same UserRecords again and again, as when reading events, and into new
+// UserRecords each time. Copies share the records until the first change,
+// which is timed with one set() on each copy.
+
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <sys/time.h>
+
+#include "Pxl/Pxl/interface/pxl/core.hh"
+
+namespace {
+
+   double now() {
+      timeval tv;
+      gettimeofday( &tv, 0 );
+      return tv.tv_sec + 1e-6 * tv.tv_usec;
+   }
+
+   void report( std::string const &what, unsigned long count, double seconds ) {
+      std::cout << std::setw( 44 ) << std::left << what
+                << std::setw( 8 ) << std::right << std::fixed << std::setprecision( 3 ) << seconds << " s"
+                << std::setw( 8 ) << std::setprecision( 1 ) << 1e9 * seconds / count << " ns each"
+                << std::endl;
+   }
+
+}
+
+int main( int argc, char* argv[] ) {
+   unsigned long const count = argc > 1 ? strtoul( argv[ 1 ], 0, 10 ) : 100000;
+   pxl::Core::initialize();
+
+   pxl::UserRecords records;
+   for( int i = 0; i < 40; ++i ) {
+      char key[ 32 ];
+      sprintf( key, "string%d", i );
+      records.set( key, std::string( i % 2 ? 40 : 8, 'a' + i % 26 ) );
+   }
+   for( int i = 0; i < 20; ++i ) {
+      char key[ 32 ];
+      sprintf( key, "double%d", i );
+      records.set( key, 0.5 * i );
+   }
+   pxl::BufferOutput out;
+   records.serialize( out );
+   std::cout << records.size() << " records, " << out.buffer.size() << " bytes serialized" << std::endl;
+
+   pxl::BufferInput in;
+   pxl::UserRecords reused;
+   double start = now();
+   for( unsigned long i = 0; i < count; ++i ) {
+      in.setView( &out.buffer[ 0 ], out.buffer.size() );
+      reused.deserialize( in );
+   }
+   report( "deserialize into reused records", count, now() - start );
+
+   start = now();
+   for( unsigned long i = 0; i < count; ++i ) {
+      in.setView( &out.buffer[ 0 ], out.buffer.size() );
+      pxl::UserRecords fresh;
+      fresh.deserialize( in );
+   }
+   report( "deserialize into fresh records", count, now() - start );
+
+   in.setLazyUserRecords( true );
+   start = now();
+   for( unsigned long i = 0; i < count; ++i ) {
+      in.setView( &out.buffer[ 0 ], out.buffer.size() );
+      reused.deserialize( in );
+   }
+   report( "deserialize lazily into reused records", count, now() - start );
+   in.setLazyUserRecords( false );
+
+   start = now();
+   for( unsigned long i = 0; i < 2 * count; ++i ) {
+      pxl::UserRecords copy( records );
+      copy.set( "double0", 1. );
+   }
+   report( "copy and detach by one set()", 2 * count, now() - start );
+
+   if( reused.size() != records.size() || reused.get( "string1" ).toString() != records.get( "string1" ).toString() ) {
+      std::cerr << "Records read differ from those written." << std::endl;
+      return 1;
+   }
+   return 0;
+}
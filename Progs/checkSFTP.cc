@@ -0,0 +1,130 @@
+// Compares reading a file through sFTPFileImpl with reading it locally.
+//
+// Usage: checkSFTP <local file> <ssh url of the same file>
+// e.g.   checkSFTP /tmp/test.pxlio ssh://$USER@localhost//tmp/test.pxlio
+//
+// Needs an sshd on the given host and a running ssh-agent holding a key that
+// is accepted there. The file is read with random reads, seeks, peeks and
+// ignores, with several read ahead settings, so that the sliding window of
+// requests, the short last block at the end of the file and seeks inside and
+// outside of the window are all used. The file should be a few MB large and
+// its size not a multiple of the block sizes.
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Pxl/Pxl/interface/pxl/core.hh"
+
+#ifdef PXL_ENABLE_SFTP
+
+#include "Pxl/Pxl/src/LocalFileImpl.hh"
+#include "Pxl/Pxl/src/sFTPFileImpl.hh"
+
+namespace {
+
+   // Runs the same random operations on both files, returns false at the first
+   // difference.
+   bool compare( pxl::FileImpl &local, pxl::FileImpl &remote, unsigned int seed, int operations ) {
+      local.seek( 0, pxl::SeekEnd );
+      remote.seek( 0, pxl::SeekEnd );
+      int64_t const size = local.tell();
+      if( remote.tell() != size ) {
+         std::cerr << "size differs: " << size << " " << remote.tell() << std::endl;
+         return false;
+      }
+      local.seek( 0, pxl::SeekBegin );
+      remote.seek( 0, pxl::SeekBegin );
+
+      srand( seed );
+      std::vector< char > a( 300000 ), b( 300000 );
+      for( int i = 0; i < operations; ++i ) {
+         int const op = rand() % 6;
+         if( op == 0 ) {
+            // anywhere, also behind the end of the file
+            int64_t const pos = ( (int64_t) rand() * 7919 ) % ( size + 100 );
+            local.seek( pos, pxl::SeekBegin );
+            remote.seek( pos, pxl::SeekBegin );
+         } else if( op == 1 ) {
+            // close by, mostly inside the blocks read ahead
+            int64_t const offset = rand() % 3000 - 1000;
+            if( local.tell() + offset >= 0 ) {
+               local.seek( offset, pxl::SeekCurrent );
+               remote.seek( offset, pxl::SeekCurrent );
+            }
+         } else if( op == 2 ) {
+            if( local.peek() != remote.peek() ) {
+               std::cerr << "peek differs at operation " << i << std::endl;
+               return false;
+            }
+         } else if( op == 3 ) {
+            int64_t const count = rand() % 30000;
+            local.ignore( count );
+            remote.ignore( count );
+         } else {
+            size_t const count = rand() % ( op == 4 ? 100 : 300000 );
+            int64_t const na = local.read( &a[ 0 ], count );
+            int64_t const nb = remote.read( &b[ 0 ], count );
+            if( na != nb || memcmp( &a[ 0 ], &b[ 0 ], na ) != 0 ) {
+               std::cerr << "read differs at operation " << i << ": " << na << " " << nb << " bytes" << std::endl;
+               return false;
+            }
+            if( count > 0 && local.isEof() != remote.isEof() ) {
+               std::cerr << "end of file differs at operation " << i << std::endl;
+               return false;
+            }
+            local.clear();
+            remote.clear();
+         }
+         if( local.tell() != remote.tell() ) {
+            std::cerr << "position differs at operation " << i << ": " << local.tell() << " " << remote.tell() << std::endl;
+            return false;
+         }
+      }
+      return true;
+   }
+
+}
+
+int main( int argc, char* argv[] ) {
+   if( argc != 3 ) {
+      std::cerr << "Usage: " << argv[ 0 ] << " <local file> <ssh url of the same file>" << std::endl;
+      return 2;
+   }
+   pxl::Core::initialize();
+
+   // number and size of the blocks read ahead
+   size_t const blocks[] = { 1, 3, 8, 8 };
+   size_t const sizes[] = { 65536, 1000, 65536, 524288 };
+   int failed = 0;
+   for( unsigned int c = 0; c < sizeof( blocks ) / sizeof( blocks[ 0 ] ); ++c ) {
+      pxl::sFTPFileImpl::setReadAhead( blocks[ c ], sizes[ c ] );
+      pxl::LocalFileImpl local;
+      pxl::sFTPFileImpl remote;
+      if( !local.open( argv[ 1 ], pxl::OpenRead ) ) {
+         std::cerr << "Cannot open " << argv[ 1 ] << std::endl;
+         return 2;
+      }
+      if( !remote.open( argv[ 2 ], pxl::OpenRead ) ) {
+         std::cerr << "Cannot open " << argv[ 2 ] << std::endl;
+         return 2;
+      }
+      bool const ok = compare( local, remote, c, 5000 );
+      std::cout << blocks[ c ] << " blocks of " << sizes[ c ] << " bytes: " << ( ok ? "ok" : "FAILED" ) << std::endl;
+      if( !ok ) ++failed;
+      remote.close();
+      local.close();
+   }
+   return failed ? 1 : 0;
+}
+
+#else
+
+int main() {
+   std::cerr << "Built without SFTP support, use make PXL_USE_SFTP=1." << std::endl;
+   return 2;
+}
+
+#endif
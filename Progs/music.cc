@@ -17,6 +17,7 @@
 #include "boost/program_options.hpp"
 
 #include "Main/EventAdaptor.hh"
+#include "Main/FilePrefetcher.hh"
 #include "Main/JetTypeWriter.hh"
 #include "Main/EventSelector.hh"
 #include "Main/ParticleMatcher.hh"
@@ -52,6 +53,37 @@ namespace
 
 void PrintProcessInfo( ProcInfo_t &info );
 
+// Applies the input settings from the config to each file before it is opened.
+class InputFileSetup : public FilePrefetcher::Setup {
+   public:
+      InputFileSetup( Tools::MConfig const &config, pxl::InfoCondition const *sectionFilter ) :
+         m_sectionFilter( sectionFilter ),
+         // Read and inflate the next file sections in a background thread while
+         // the current event is analyzed (0 = synchronous reading).
+         m_readAhead( config.GetItem< unsigned int >( "General.ReadAhead", 0 ) ),
+         // Inflate the sections read ahead on additional worker threads.
+         m_inflateThreads( config.GetItem< unsigned int >( "General.InflateThreads", 0 ) ),
+         // Keep several large reads of local files in flight, optionally bypassing
+         // the page cache for these one-pass reads.
+         m_asyncRead( config.GetItem< bool >( "General.AsyncRead", false ) ),
+         m_directIO( config.GetItem< bool >( "General.DirectIO", false ) )
+      {}
+
+      virtual void apply( pxl::InputFile &file ) const {
+         file.setSectionFilter( m_sectionFilter );
+         file.setReadAhead( m_readAhead );
+         file.setInflateThreads( m_inflateThreads );
+         file.setAsyncRead( m_asyncRead, m_directIO );
+      }
+
+   private:
+      pxl::InfoCondition const *m_sectionFilter;
+      unsigned int const m_readAhead;
+      unsigned int const m_inflateThreads;
+      bool const m_asyncRead;
+      bool const m_directIO;
+};
+
 bool do_break;
 
 void KeyboardInterrupt_endJob(int signum) {
@@ -250,75 +282,57 @@ int main( int argc, char* argv[] ) {
 
    // initialize process info object
    ProcInfo_t info;
-   // Get file handler to access files.
-   // New PXL version knows how to handle dcap protocol.
-   //std::auto_prt< pxl::InputFile > inFile = pxl::InputFile();
-   pxl::InputFile inFile;
+   // Reject events listed in the SkipEvents files by their section headers,
+   // before they are read (only for files written with section info).
+   SkipEventsFilter skipFilter( skipEvents );
+   InputFileSetup const inputSetup( config, runOnData ? &skipFilter : 0 );
+   // Open the next General.PrefetchFiles files in a background thread while
+   // the current one is analyzed (0 = open each file when it is needed).
+   FilePrefetcher prefetcher( input_files,
+                              inputSetup,
+                              config.GetItem< unsigned int >( "General.PrefetchFiles", 0 )
+                              );
+   pxl::Event event;
+   // Allocate the particles, event views, ... of each event in one arena,
+   // which is reused for the next event.
+   event.setArena( true );
    for( unsigned int f = 0; f < input_files.size() && ( numberOfEvents == -1 || e < numberOfEvents ); f++ ) {
       std::string const fileName = *file_iter;
-      // Open File:
-      // open file(s):
-      //pxl::InputHandler* input =
-      //if( filename.substr(0,7)  == "dcap://" || filename.substr(0,6) == "/pnfs/") {
-         //input = new pxl::dCacheInputFile();
-      //} else {
-         //if( filename.substr(0,1) != "/" ) {
-            //filename = startDir + "/" + filename;
-         //}
-         //input = new pxl::InputFile();
-      //}
 
       std::cout << "Opening file " << fileName << std::endl;
-      unsigned int numTrials = 0;
-      //we need to get done in 3 days, so don't wait too long
-      //unsigned int timeout = 3*24*60*60/input_files.size();
-      //cout << "Opening file (timeout " << timeout << " seconds) " << filename << endl;
-      while( true ) {
-         numTrials++;
-         try {
-            time_t rawtime;
-            time ( &rawtime );
-            std::cout << "Opening time: " << ctime ( &rawtime );
-            inFile.open( fileName );
-         } catch( std::runtime_error& e ) {
-            // Wait for ( 10^numTrials - 1 ) seconds before retrying.
-            //double const sleep = std::pow( 10, numTrials ) - 1.0;
-            //boost::this_thread::sleep( boost::posix_time::seconds( sleep ) );
-            std::cout << "Did you use an absolute path to the .pxlio file?" << std::endl;
-            if( numTrials < 3 ) {
-               numTrials++;
-               // Retry!
-               continue;
-            }
-
-            if( not runOnData ) {
-               //increase lost files counter, but don't try again
-               lost_files++;
-               std::cerr << "Failed to open file '" << fileName
-                         << "', skipping..." << std::endl;
-            } else {
-               std::cerr << "Failed to open file '" << fileName
-                         << "' three times. Aborting!" << std::endl;
-               throw e;
-            }
+      time_t rawtime;
+      time ( &rawtime );
+      std::cout << "Opening time: " << ctime ( &rawtime );
+      pxl::InputFile *inFile = prefetcher.next();
+      std::cout << "Opened file in " << prefetcher.openTime() << " s, waited "
+                << prefetcher.waitTime() << " s" << std::endl;
+      if( not inFile ) {
+         std::cout << "Did you use an absolute path to the .pxlio file?" << std::endl;
+         if( not runOnData ) {
+            //increase lost files counter, but don't try again
+            lost_files++;
+            std::cerr << "Failed to open file '" << fileName
+                      << "', skipping..." << std::endl;
+            ++file_iter;
+            continue;
+         } else {
+            std::cerr << "Failed to open file '" << fileName
+                      << "' three times. Aborting!" << std::endl;
+            throw std::runtime_error( prefetcher.error() );
          }
-         //increase successful files counter
-         analyzed_files++;
-         break;
       }
+      //increase successful files counter
+      analyzed_files++;
 
       // run event loop:
-      while( inFile.good() ) {
-         pxl::Event* event_ptr=0;
+      while( inFile->good() ) {
+         // Each event is read into the same pxl::Event, replacing the previous one.
          try{
-             event_ptr=dynamic_cast<pxl::Event*>(inFile.readNextObject());
+             if( not inFile->readNextEvent( event ) ) break;
         }catch( std::runtime_error& e ){
             std::cout <<"end of file or unreadable event.    "<<std::endl;
             break;
         }
-         if(!event_ptr) continue;
-
-         pxl::Event event = *event_ptr;
 
          if( numberOfEvents > -1 and e >= numberOfEvents ) break;
 
@@ -326,7 +340,6 @@ int main( int argc, char* argv[] ) {
          if( event.getUserRecords().size() == 0 ) {
             std::cout << "WARNING: Found corrupt pxlio event with User Record size 0 in file " << fileName << "." << std::endl;
             std::cout << "WARNING: Continue with next event." << std::endl;
-            delete event_ptr;
             continue;
          }
 
@@ -348,7 +361,6 @@ int main( int argc, char* argv[] ) {
                std::cerr << "Skipping Run/LS/Event: ";
                std::cerr <<  run << ":" <<  LS << ":" <<  eventNum << std::endl;
             }
-            delete event_ptr;
             continue;
          }
 
@@ -412,7 +424,6 @@ int main( int argc, char* argv[] ) {
                std::cerr << "[WARNING] (main): ";
                std::cerr << "Found unsorted particle in event no. " << e << ". ";
                std::cerr << "Skipping this event!" << std::endl;
-               delete event_ptr;
                continue;
             }
 
@@ -439,7 +450,6 @@ int main( int argc, char* argv[] ) {
          // run the fork ..
          fork.analyseEvent( &event );
          fork.finishEvent( &event );
-         delete event_ptr;
          e++;
          if( e < 10 || ( e < 100 && e % 10 == 0 ) ||
             ( e < 1000 && e % 100 == 0 ) ||
@@ -451,11 +461,12 @@ int main( int argc, char* argv[] ) {
          //if( e % 100000 == 0 ) PrintProcessInfo( info );
          if(do_break)break;
       }
-      inFile.close();
       ++file_iter;
       if(do_break)break;
    }
 
+   skipped += skipFilter.skipped();
+
    // Don't need the PDFTool any more after file loop!
    delete pdfTool;
    pdfTool = 0;
@@ -19,21 +19,26 @@
 #include "Pxl/Pxl/interface/pxl/core/BasicContainer.hh"
 #include "Pxl/Pxl/interface/pxl/core/Event.hh"
 #include "Pxl/Pxl/interface/pxl/core/File.hh"
+#include "Pxl/Pxl/interface/pxl/core/FileIndex.hh"
 #include "Pxl/Pxl/interface/pxl/core/Filter.hh"
 #include "Pxl/Pxl/interface/pxl/core/functions.hh"
 #include "Pxl/Pxl/interface/pxl/core/Id.hh"
+#include "Pxl/Pxl/interface/pxl/core/IdMap.hh"
+#include "Pxl/Pxl/interface/pxl/core/InfoCondition.hh"
 #include "Pxl/Pxl/interface/pxl/core/InformationChunk.hh"
 #include "Pxl/Pxl/interface/pxl/core/logging.hh"
 #include "Pxl/Pxl/interface/pxl/core/MessageDispatcher.hh"
 #include "Pxl/Pxl/interface/pxl/core/macros.hh"
 #include "Pxl/Pxl/interface/pxl/core/Random.hh"
 #include "Pxl/Pxl/interface/pxl/core/Object.hh"
+#include "Pxl/Pxl/interface/pxl/core/ObjectArena.hh"
 #include "Pxl/Pxl/interface/pxl/core/ObjectManager.hh"
 #include "Pxl/Pxl/interface/pxl/core/ObjectOwner.hh"
 #include "Pxl/Pxl/interface/pxl/core/Relations.hh"
 #include "Pxl/Pxl/interface/pxl/core/Relative.hh"
 #include "Pxl/Pxl/interface/pxl/core/SoftRelations.hh"
 #include "Pxl/Pxl/interface/pxl/core/UserRecord.hh"
+#include "Pxl/Pxl/interface/pxl/core/UserRecordKeys.hh"
 #include "Pxl/Pxl/interface/pxl/core/Variant.hh"
 #include "Pxl/Pxl/interface/pxl/core/weak_ptr.hh"
 #include "Pxl/Pxl/interface/pxl/core/WkPtrBase.hh"
@@ -47,6 +52,7 @@
 #include "Pxl/Pxl/interface/pxl/core/OutputFile.hh"
 #include "Pxl/Pxl/interface/pxl/core/OutputHandler.hh"
 #include "Pxl/Pxl/interface/pxl/core/PluginManager.hh"
+#include "Pxl/Pxl/interface/pxl/core/RandomAccessInputFile.hh"
 #include "Pxl/Pxl/interface/pxl/core/Serializable.hh"
 #include "Pxl/Pxl/interface/pxl/core/Stream.hh"
 #include "Pxl/Pxl/interface/pxl/core/Tokenizer.hh"
@@ -13,6 +13,7 @@
 #include <vector>
 #include <map>
 
+#include "Pxl/Pxl/interface/pxl/core/IdMap.hh"
 #include "Pxl/Pxl/interface/pxl/core/UserRecord.hh"
 
 #include "Pxl/Pxl/interface/pxl/core/Serializable.hh"
@@ -36,6 +37,11 @@ public:
 	{
 	}
 
+	explicit BasicContainer(const NoInit& tag) :
+		Serializable(tag)
+	{
+	}
+
 	BasicContainer(const BasicContainer& basicContainer) :
 		Serializable(basicContainer), UserRecordHelper(basicContainer),
 				_container(), _index(), _uuidSearchMap()
@@ -88,8 +94,7 @@ public:
 	{
 		objecttype* pitem = new objecttype;
 		_container.push_back(static_cast<Serializable*> (pitem));
-		_uuidSearchMap.insert(std::pair<Id, Serializable*>(pitem->getId(),
-				pitem));
+		_uuidSearchMap.insert(pitem->getId(), pitem);
 		return pitem;
 	}
 
@@ -101,8 +106,7 @@ public:
 	{
 		objecttype* pitem = new objecttype(*original);
 		_container.push_back(static_cast<Serializable*> (pitem));
-		_uuidSearchMap.insert(std::pair<Id, Serializable*>(pitem->getId(),
-				pitem));
+		_uuidSearchMap.insert(pitem->getId(), pitem);
 		return pitem;
 	}
 
@@ -189,13 +193,9 @@ public:
 
 	/// Returns a Serializable pointer for a contained object with the passed ID.
 	/// In case the Serializable is not in the container, 0 is returned.
-	Serializable* getById(Id id) const
+	Serializable* getById(const Id& id) const
 	{
-		std::map<Id, Serializable*>::const_iterator found =
-				_uuidSearchMap.find(id);
-		if (found != _uuidSearchMap.end())
-			return found->second;
-		return 0;
+		return _uuidSearchMap.get(id);
 	}
 
 	/// Fills into the passed vector weak pointers to the objects of the
@@ -253,7 +253,7 @@ public:
 private:
 	std::vector<Serializable*> _container;
 	map_t _index;
-	std::map<Id, Serializable*> _uuidSearchMap;
+	IdMap<Serializable*> _uuidSearchMap;
 };
 
 } // namespace pxl
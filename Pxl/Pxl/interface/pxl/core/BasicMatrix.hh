@@ -55,6 +55,9 @@ public:
 	BasicMatrix() : Serializable() ,_size1(0), _size2(0), _storageType(ROWMAJOR), _alienarray(false), _data(NULL)
 	{
 	}
+	explicit BasicMatrix(const NoInit& tag) : Serializable(tag) ,_size1(0), _size2(0), _storageType(ROWMAJOR), _alienarray(false), _data(NULL)
+	{
+	}
 	BasicMatrix(size_t size1, size_t size2, std::string name = "BasicMatrix") : Serializable(), _size1(size1), _size2(size2), _storageType(ROWMAJOR), _alienarray(false), _name(name)
 	{
 		_data = new double[size1*size2];
@@ -35,6 +35,10 @@ public:
 	{
 	}
 
+	explicit BasicNVector(const NoInit& tag) : Serializable(tag), _data(NULL), _size1(0), _alienarray(false), _name("BasicNVector")
+	{
+	}
+
 	BasicNVector(size_t size) : Serializable(), _data(NULL), _size1(size), _alienarray(false), _name("BasicNVector")
 	{
 		_data = new double[size];
@@ -0,0 +1,75 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#ifndef PXL_BUFFERED_FILE_IMPL_HH_
+#define PXL_BUFFERED_FILE_IMPL_HH_
+
+#include "Pxl/Pxl/interface/pxl/core/macros.hh"
+#include "Pxl/Pxl/interface/pxl/core/File.hh"
+
+#include <vector>
+
+namespace pxl
+{
+
+/// File implementation which buffers another one in a large window. Reads,
+/// peeks, skips and seeks within the window are served from memory, and the
+/// wrapped file is only read in large chunks. This pays off for remote
+/// protocols (dcap, sftp), where each call on the wrapped file can be a round
+/// trip, as the ChunkReader peeks at the file several times per block.
+/// Files opened for writing are passed through unbuffered.
+class PXL_DLL_EXPORT BufferedFileImpl: public FileImpl
+{
+	FileImpl *_impl;
+	std::vector<char> _buffer;
+	size_t _windowSize;
+	/// File position of the first byte in the buffer.
+	int64_t _bufferBegin;
+	/// Read position within and number of valid bytes in the buffer.
+	size_t _bufferPosition;
+	size_t _bufferSize;
+	bool _eof;
+	/// Set when reading the wrapped file failed, reported once the data
+	/// buffered before the failure is read.
+	bool _bad;
+	int32_t _mode;
+
+	bool fill();
+	void drop(int64_t position);
+
+public:
+
+	/// Takes ownership of \p impl. A \p windowSize of 0 uses getDefaultWindowSize().
+	BufferedFileImpl(FileImpl *impl, size_t windowSize = 0);
+
+	~BufferedFileImpl();
+
+	/// Sets the window size for files buffered from now on, 4 MiB by default.
+	static void setDefaultWindowSize(size_t size);
+
+	static size_t getDefaultWindowSize();
+
+	virtual bool open(const std::string &filename, int32_t mode);
+	virtual void close();
+	virtual bool isEof();
+	virtual bool isOpen();
+	virtual bool isBad();
+	virtual void clear();
+	virtual bool isGood();
+	virtual int64_t tell();
+	virtual void seek(int64_t pos, int32_t d);
+	virtual int32_t peek();
+	virtual int64_t read(char *s, size_t count);
+	virtual int64_t write(const char *s, size_t count);
+	virtual void ignore(int64_t count);
+	virtual void destroy();
+};
+
+} // namespace pxl
+
+#endif /* PXL_BUFFERED_FILE_IMPL_HH_ */
@@ -13,9 +13,15 @@
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <deque>
+#include <set>
+#include <vector>
+#include <string>
+#include <pthread.h>
 
 #include "Pxl/Pxl/interface/pxl/core/Stream.hh"
 #include "Pxl/Pxl/interface/pxl/core/File.hh"
+#include "Pxl/Pxl/interface/pxl/core/InfoCondition.hh"
 
 #define iotl__iStreamer__lengthUnzipBuffer 65536
 
@@ -81,30 +87,115 @@ public:
 	};
 
 	ChunkReader(FileImpl& stream, fileMode seekMode = seekable) :
-	_stream(stream), _status(preHeader), _sectionCount(0), _seekMode(seekMode)
+	_stream(stream), _status(preHeader), _sectionCount(0), _seekMode(seekMode),
+	_readAheadDepth(0), _readAheadRunning(false), _readAheadStop(false),
+	_readAheadFinished(false), _readAheadConsumed(0), _readAheadPosition(0),
+	_readAheadSize(0), _currentSection(0), _currentBlock(0),
+	_inflateThreadCount(0), _inflateStop(false), _sectionFilter(0),
+	_zstdContext(0), _zstdDictionary(0)
 	{
 		_inputBuffer =	new unsigned char[iotl__iStreamer__lengthUnzipBuffer];
 		_outputBuffer = new unsigned char[iotl__iStreamer__lengthUnzipBuffer];
+		pthread_mutex_init(&_readAheadMutex, 0);
+		pthread_cond_init(&_readAheadNotEmpty, 0);
+		pthread_cond_init(&_readAheadNotFull, 0);
+		pthread_mutex_init(&_inflateMutex, 0);
+		pthread_cond_init(&_inflateWork, 0);
+		pthread_cond_init(&_inflateDone, 0);
 	}
 
 	~ChunkReader()
 	{
+		stopReadAhead();
+		pthread_cond_destroy(&_inflateDone);
+		pthread_cond_destroy(&_inflateWork);
+		pthread_mutex_destroy(&_inflateMutex);
+		pthread_cond_destroy(&_readAheadNotFull);
+		pthread_cond_destroy(&_readAheadNotEmpty);
+		pthread_mutex_destroy(&_readAheadMutex);
+		releaseZstd();
 		delete[] _inputBuffer;
 		delete[] _outputBuffer;
 	}
 	
 	void reset()
 	{
+		stopReadAhead();
 		_sectionCount = 0;
 		_status = preHeader;
 		_buffer.clear();
 	}
 
+	/// Enables reading ahead up to \p depth file sections in a background thread,
+	/// which also inflates the blocks. Sequential reading via next() and nextBlock()
+	/// is then served from memory. Any other operation on the file (skip, previous,
+	/// reset, ...) stops the background thread and repositions the file, reading
+	/// ahead resumes with the next section header. A depth of 0 disables reading ahead.
+	void setReadAhead(size_t depth);
+
+	size_t getReadAhead() const
+	{
+		return _readAheadDepth;
+	}
+
+	/// Inflates the compressed blocks of the sections read ahead on \p threads
+	/// worker threads instead of the read-ahead thread. Blocks are still handed
+	/// out in file order. Blocks written with their uncompressed size stored are
+	/// inflated into buffers allocated once. Takes effect when reading ahead
+	/// (re)starts, 0 inflates in the read-ahead thread.
+	void setInflateThreads(size_t threads);
+
+	size_t getInflateThreads() const
+	{
+		return _inflateThreadCount;
+	}
+
+	/// Sets the dictionary needed for Zstandard blocks written with a dictionary,
+	/// see ChunkWriter::setZstdDictionary. An empty string removes it.
+	void setZstdDictionary(const std::string& dictionary);
+
+	/// Returns true if the read-ahead thread is currently active.
+	bool isReadingAhead() const
+	{
+		return _readAheadRunning;
+	}
+
+	/// Stops the read-ahead thread and positions the file where the
+	/// synchronous reader would be. Must be called before the underlying
+	/// file is closed or modified.
+	void stopReadAhead();
+
 	unsigned long getSectionCount()
 	{
 		return _sectionCount;
 	}
 
+	/// Returns the info string of the file section last read by readHeader().
+	const std::string& getSectionInfo() const
+	{
+		return _sectionInfo;
+	}
+
+	/// Positions the file at \p position, which must be the begin of a file
+	/// section (e.g. taken from a FileIndex), and sets the section count to
+	/// \p sectionCount. Returns false if the file cannot be positioned.
+	bool seekSection(int64_t position, unsigned long sectionCount);
+
+	/// Skips all file sections whose info string does not fulfil \p filter
+	/// when reading headers, without reading their blocks. When reading ahead,
+	/// the filter is evaluated in the read-ahead thread, so the rejected sections
+	/// are not inflated either. The filter is not owned, 0 removes it.
+	void setSectionFilter(const InfoCondition* filter)
+	{
+		stopReadAhead();
+		_sectionFilter = filter;
+	}
+
+	const InfoCondition* getSectionFilter() const
+	{
+		return _sectionFilter;
+	}
+
 	/// Reads in the next event header. 
 	bool readHeader(readMode mode, skipMode skip, infoMode checkInfo,
 			const std::string& infoCondition);
@@ -126,6 +217,11 @@ public:
 		return readHeader(all, skip, checkInfo, infoCondition);
 	}
 
+	/// Reads in the header of the next file section whose info string fulfils
+	/// \p condition. Unless \p skip is off, the sections in between are skipped
+	/// without reading their blocks. False is returned if not successful.
+	bool next(const InfoCondition& condition, skipMode skip = on);
+
 
 	/// Reads the next block and puts data into the input stream. False is returned if not successful.
 	bool nextBlock(skipMode skip = on, infoMode checkInfo = ignore,
@@ -134,6 +230,26 @@ public:
 		return readBlock(skip, checkInfo, infoCondition);
 	}
 
+	/// Skips \p bytes of the uncompressed data of the current file section,
+	/// reading further blocks as needed, e.g. to jump to an object at an offset
+	/// taken from a FileIndex. Returns false if the section holds less data.
+	bool skipSectionData(size_t bytes);
+
+	/// Keeps the content of object managers serialized until first accessed,
+	/// see InputStream::setDeferredContent.
+	void setDeferredContent(bool defer,
+			const std::set<std::string>& eager = std::set<std::string>())
+	{
+		_buffer.setDeferredContent(defer, eager);
+	}
+
+	/// Decodes user records on first access, see
+	/// InputStream::setLazyUserRecords.
+	void setLazyUserRecords(bool lazy)
+	{
+		_buffer.setLazyUserRecords(lazy);
+	}
+
 	/// Access to the data read in the individual blocks.
 	inline const InputStream& getInputStream()
 	{
@@ -143,11 +259,13 @@ public:
 	
 	bool isBlock()
 	{
+		stopReadAhead();
 		return (_stream.peek()=='B');
 	}
 
 	bool isEnd()
 	{
+		stopReadAhead();
 		return (_stream.peek()=='e');
 	}
 
@@ -173,19 +291,19 @@ public:
 	size_t getSize() const;
 
 	/// Returns the current position in the associated file.
-	size_t getPosition() const
-	{
-		return _stream.tell();
-	}
+	size_t getPosition() const;
 
-	bool eof() const
-	{
-		return _stream.peek()==EOF;
-	}
+	bool eof() const;
 
 protected:
 	/// Helper method to perform the unzipping.
-	int unzipEventData(uint32_t nBytes) ;
+	int unzipEventData(uint32_t nBytes)
+	{
+		return unzipEventData(nBytes, _buffer.buffer);
+	}
+
+	/// Inflates nBytes from the file into the passed buffer.
+	int unzipEventData(uint32_t nBytes, std::vector<char>& buffer);
 
 	/// Reads in a char from file and returns this.
 	inline char nextBlockId()
@@ -196,6 +314,71 @@ protected:
 	}
 
 private:
+	/// A block as read and inflated by the read-ahead thread.
+	struct ReadAheadBlock
+	{
+		ReadAheadBlock() :
+			view(0), viewSize(0), end(0), compressionMode(' '), compressedView(0),
+			compressedSize(0), uncompressedSize(0), inflated(true)
+		{
+		}
+
+		std::string info;
+		std::vector<char> data;
+		/// Data in a memory mapped file, used instead of data if set.
+		const char* view;
+		size_t viewSize;
+		/// File position after this block.
+		int64_t end;
+
+		/// Compressed payload waiting for the inflate workers, either
+		/// held in compressed or in a memory mapped file.
+		char compressionMode;
+		std::vector<char> compressed;
+		const char* compressedView;
+		size_t compressedSize;
+		/// Stored size of the inflated data, 0 for legacy blocks.
+		uint32_t uncompressedSize;
+		/// False until an inflate worker has filled data, guarded by _inflateMutex.
+		bool inflated;
+		std::string error;
+	};
+
+	/// A complete file section as read by the read-ahead thread.
+	struct ReadAheadSection
+	{
+		std::string info;
+		std::deque<ReadAheadBlock> blocks;
+		/// File positions of the section begin, after the header and after the end marker.
+		int64_t begin;
+		int64_t headerEnd;
+		int64_t end;
+		/// Set if reading failed after the last block, thrown when the consumer gets there.
+		std::string error;
+		bool complete;
+		/// Number of sections rejected by the section filter before this one.
+		unsigned long skipped;
+	};
+
+	static void* inflateThread(void* reader);
+	void inflateLoop();
+	void startInflateThreads();
+	void stopInflateThreads();
+	void waitInflated(ReadAheadBlock& block);
+	bool readPayload(uint32_t size, std::vector<char>& storage, const char*& data);
+	void releaseZstd();
+	void skipBlocks(int64_t& position);
+
+	static void* readAheadThread(void* reader);
+	void readAheadLoop();
+	bool readAheadSection(ReadAheadSection& section, int64_t& position);
+	void startReadAhead();
+	ReadAheadSection* popReadAheadSection();
+	bool readHeaderAhead(skipMode skip, infoMode checkInfo,
+			const std::string& infoCondition);
+	bool readBlockAhead(skipMode skip, infoMode checkInfo,
+			const std::string& infoCondition);
+
 	ChunkReader(const ChunkReader& original) : _stream(original._stream)
 	{
 	}
@@ -211,10 +394,46 @@ private:
 	/// Status flag. 0 at end of event, 1 at end of block.
 	statusFlag _status;
 	unsigned long _sectionCount;
+	std::string _sectionInfo;
+	std::string _blockInfo;
 	fileMode _seekMode;
 	
 	unsigned char* _inputBuffer;
 	unsigned char* _outputBuffer;
+
+	size_t _readAheadDepth;
+	bool _readAheadRunning;
+	bool _readAheadStop;
+	bool _readAheadFinished;
+	/// File position up to which the consumer has read.
+	int64_t _readAheadConsumed;
+	/// File position up to which the read-ahead thread has read complete sections.
+	int64_t _readAheadPosition;
+	size_t _readAheadSize;
+	pthread_t _readAheadThread;
+	mutable pthread_mutex_t _readAheadMutex;
+	mutable pthread_cond_t _readAheadNotEmpty;
+	mutable pthread_cond_t _readAheadNotFull;
+	std::deque<ReadAheadSection*> _readAheadQueue;
+	ReadAheadSection* _currentSection;
+	size_t _currentBlock;
+
+	size_t _inflateThreadCount;
+	std::vector<pthread_t> _inflateThreads;
+	bool _inflateStop;
+	pthread_mutex_t _inflateMutex;
+	pthread_cond_t _inflateWork;
+	pthread_cond_t _inflateDone;
+	std::deque<ReadAheadBlock*> _inflateJobs;
+
+	const InfoCondition* _sectionFilter;
+
+	/// Compressed payload of the current block if it cannot be inflated in place.
+	std::vector<char> _compressedBuffer;
+
+	/// Zstandard decompression context and dictionary, opaque to keep zstd.h internal.
+	void* _zstdContext;
+	void* _zstdDictionary;
 };
 
 } //namespace pxl
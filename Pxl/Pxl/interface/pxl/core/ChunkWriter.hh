@@ -17,6 +17,7 @@
 
 #include "Pxl/Pxl/interface/pxl/core/Stream.hh"
 #include "Pxl/Pxl/interface/pxl/core/File.hh"
+#include "Pxl/Pxl/interface/pxl/core/FileIndex.hh"
 
 namespace pxl
 {
@@ -27,19 +28,35 @@ namespace pxl
  PXL I/O allows the storage of complete physics events and information chunks.
  Each event or information chunk makes up a section in the output file. 
  Each section consists of a header, and a number of blocks which can be compressed individually.
- The compression is incorporated via zlib.
+ The compression is incorporated via zlib. Compressed blocks are marked 'Z', or 'z' if
+ the uncompressed size is stored in front of the compressed data, which lets readers
+ allocate the output once and inflate blocks in parallel. Optionally, blocks are
+ compressed with LZ4 ('L') or Zstandard ('S'), which always store the uncompressed size.
  The entry point for the standard user is the class OutputFile. 
  */
 class PXL_DLL_EXPORT ChunkWriter
 {
 public:
+	/// The compression algorithm used for the blocks. LZ4 and Zstandard
+	/// require PXL to be compiled with PXL_ENABLE_LZ4 and PXL_ENABLE_ZSTD.
+	enum compressionAlgorithm
+	{
+		zlibCompression = 0,
+		lz4Compression,
+		zstdCompression
+	};
+
 	ChunkWriter(FileImpl& stream, char compressionMode = '1') :
-		_stream(stream), _nBytes(0), _compressionMode(compressionMode)
+		_stream(stream), _nBytes(0), _compressionMode(compressionMode),
+		_storeUncompressedSize(false), _algorithm(zlibCompression),
+		_compressionLevel(0), _zstdContext(0), _zstdDictionary(0),
+		_index(0), _sectionBegin(0), _sectionData(0)
 	{
 	}
 
 	~ChunkWriter()
 	{
+		releaseZstd();
 	}
 
 	/// Writes the current block to the output file stream.
@@ -72,6 +89,7 @@ public:
 	void setCompressionMode(char compressionMode)
 	{
 			_compressionMode = compressionMode;
+			_algorithm = zlibCompression;
 	}
 	
 	void setCompressionMode(int compressionMode)
@@ -80,6 +98,44 @@ public:
 		  _compressionMode = '0' + compressionMode;
     else
       throw std::runtime_error("Invalid compression mode");
+		_algorithm = zlibCompression;
+	}
+
+	/// Selects the compression algorithm and level (zlib: 0-9, LZ4: 0 for the fast
+	/// compressor, 1-12 for LZ4HC, Zstandard: 1-22). Files compressed with LZ4 or
+	/// Zstandard cannot be read by PXL versions without support for them.
+	void setCompression(compressionAlgorithm algorithm, int level);
+
+	/// Uses the passed dictionary (e.g. trained with "zstd --train" on typical blocks)
+	/// for Zstandard compression. Readers need the same dictionary.
+	/// An empty string removes the dictionary.
+	void setZstdDictionary(const std::string& dictionary);
+
+	/// Stores the uncompressed size of each compressed block (marker 'z').
+	/// Files written this way cannot be read by PXL versions without support for it.
+	void setStoreUncompressedSize(bool store)
+	{
+		_storeUncompressedSize = store;
+	}
+
+	bool getStoreUncompressedSize() const
+	{
+		return _storeUncompressedSize;
+	}
+
+	/// Adds an entry for every file section written from now on to \p index,
+	/// 0 stops indexing. The index is not owned by the ChunkWriter.
+	void setIndex(FileIndex* index)
+	{
+		_index = index;
+	}
+
+	/// Marks the begin of an object in the current block for the index.
+	/// Called before an object is serialized to the output stream.
+	void markObject()
+	{
+		if (_index)
+			_objectOffsets.push_back(_sectionData + _buffer.buffer.size());
 	}
 	
 protected:
@@ -87,6 +143,11 @@ protected:
 	bool writeFlag(char cEvtMarker);
 	
 private:
+	/// Compresses the buffer with LZ4 or Zstandard into the returned array of size length.
+	char* compressBuffer(const char* buffer, int32_t lengthBuffer,
+			unsigned long& length);
+	void releaseZstd();
+
 	ChunkWriter(const ChunkWriter& original) : _stream(original._stream)
 	{
 	}
@@ -100,6 +161,21 @@ private:
 	BufferOutput _buffer;
 	int32_t _nBytes;
 	char _compressionMode;
+	bool _storeUncompressedSize;
+	compressionAlgorithm _algorithm;
+	int _compressionLevel;
+
+	/// Zstandard compression context and dictionary, opaque to keep zstd.h internal.
+	void* _zstdContext;
+	void* _zstdDictionary;
+	std::string _zstdDictionaryData;
+
+	FileIndex* _index;
+	int64_t _sectionBegin;
+	std::string _sectionInfo;
+	/// Uncompressed size of the blocks written in the current section.
+	uint32_t _sectionData;
+	std::vector<uint32_t> _objectOffsets;
 };
 }
 #endif /*PXL_IO_CHUNKWRITER_HH*/
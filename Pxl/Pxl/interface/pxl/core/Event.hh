@@ -24,23 +24,66 @@ class PXL_DLL_EXPORT Event: public Serializable, public UserRecordHelper
 {
 public:
 	Event() :
-		Serializable()
+		Serializable(), _arena(0)
+	{
+	}
+
+	explicit Event(const NoInit& tag) :
+		Serializable(tag), _arena(0)
 	{
 	}
 
 	Event(const Event& event) :
-		Serializable(event), UserRecordHelper(event), _objects(event._objects)
+		Serializable(event), UserRecordHelper(event), _objects(event._objects), _arena(
+				0)
 	{
 	}
 
 	explicit Event(const Event* event) :
 		Serializable(*event), UserRecordHelper(*event), _objects(
-				event->_objects)
+				event->_objects), _arena(0)
 	{
 	}
 
 	virtual ~Event()
 	{
+		_objects.clearContainer();
+		if (_arena)
+			_arena->release();
+	}
+
+	/// Copies the content of \p event, keeping the own arena.
+	Event& operator=(const Event& event)
+	{
+		if (this != &event)
+		{
+			Serializable::operator=(event);
+			UserRecordHelper::operator=(event);
+			clearObjects();
+			ObjectArena::Scope scope(_arena);
+			_objects = event._objects;
+		}
+		return *this;
+	}
+
+	/// With \p enabled, the objects of this event (including those created
+	/// while reading it) are allocated in an ObjectArena owned by the event,
+	/// which is reused for the next event read into it, see
+	/// InputHandler::readNextEvent.
+	void setArena(bool enabled)
+	{
+		if (enabled == (_arena != 0))
+			return;
+		if (_arena)
+			_arena->release();
+		_arena = enabled ? new ObjectArena() : 0;
+		_objects.setArena(_arena);
+	}
+
+	/// Returns the arena of this event, 0 if disabled.
+	ObjectArena* getArena() const
+	{
+		return _arena;
 	}
 
 	virtual const Id& getTypeId() const
@@ -139,6 +182,8 @@ public:
 	inline void clearObjects()
 	{
 		_objects.clearContainer();
+		if (_arena)
+			_arena->reset();
 	}
 
 	/// Searches the index for the \p key and returns a dynamically casted
@@ -182,6 +227,7 @@ public:
 
 private:
 	ObjectOwner _objects;
+	ObjectArena* _arena;
 };
 
 } // namespace pxl
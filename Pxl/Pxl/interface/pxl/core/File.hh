@@ -26,7 +26,8 @@ enum SeekDirectionEnum
 
 enum OpenModeEnum
 {
-	OpenRead = 1, OpenWrite = 2, OpenOverwrite = 4
+	OpenRead = 1, OpenWrite = 2, OpenOverwrite = 4, OpenMapped = 8,
+	OpenAsync = 16, OpenDirect = 32
 };
 
 class PXL_DLL_EXPORT FileImpl
@@ -51,6 +52,15 @@ public:
 	virtual int64_t write(const char *s, size_t count) = 0;
 	virtual void ignore(int64_t count) = 0;
 
+	/// Returns a pointer to the next \p count bytes and advances the position,
+	/// if the implementation can expose its data without copying (e.g. a memory
+	/// mapping). Otherwise 0 is returned and the position is unchanged.
+	/// The pointer stays valid until the file is closed.
+	virtual const char *readView(size_t count)
+	{
+		return 0;
+	}
+
 	virtual void destroy() = 0;
 };
 
@@ -80,6 +90,7 @@ public:
 	virtual int64_t read(char *s, size_t count);
 	virtual int64_t write(const char *s, size_t count);
 	virtual void ignore(int64_t count);
+	virtual const char *readView(size_t count);
 	virtual void destroy();
 };
 
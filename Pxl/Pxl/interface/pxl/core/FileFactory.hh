@@ -14,6 +14,7 @@
 
 #include "Pxl/Pxl/interface/pxl/core/Id.hh"
 #include "Pxl/Pxl/interface/pxl/core/File.hh"
+#include "Pxl/Pxl/interface/pxl/core/BufferedFileImpl.hh"
 
 namespace pxl
 {
@@ -70,6 +71,19 @@ public:
 	}
 };
 
+/// Producer for file implementations of remote protocols, wrapped into a
+/// BufferedFileImpl so that peeks and small reads do not reach the network.
+template<class T>
+class BufferedFileProducerTemplate: public FileProducerTemplate<T>
+{
+public:
+
+	FileImpl *create() const
+	{
+		return new BufferedFileImpl(new T());
+	}
+};
+
 } // namespace pxl
 
 #endif // PXL_IO_OBJECT_FACTORY_HH
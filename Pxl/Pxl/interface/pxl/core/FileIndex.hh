@@ -0,0 +1,148 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#ifndef PXL_IO_FILE_INDEX_HH
+#define PXL_IO_FILE_INDEX_HH
+#include "Pxl/Pxl/interface/pxl/core/macros.hh"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace pxl
+{
+
+// io
+/**
+ This class holds the byte offset, the size and the info string of every
+ file section in a PXL I/O file. It is written by the OutputFile next to the
+ file it belongs to (see getIndexFileName) and used by the RandomAccessInputFile
+ to jump to any file section directly. The size of the indexed file is stored
+ as well, so an index that does not match its file anymore can be detected.
+ Indices written by the OutputFile also hold the offsets of the objects within
+ the uncompressed data of each section, which allows seeking to single objects
+ in sections holding several of them (see OutputHandler::setPackEvents).
+ */
+class PXL_DLL_EXPORT FileIndex
+{
+public:
+
+	struct Entry
+	{
+		/// Position of the section marker in the file.
+		int64_t offset;
+		/// Size of the section on disk, including the trailing size word.
+		uint32_t size;
+		std::string info;
+		/// Offsets of the objects in the uncompressed data of all blocks of
+		/// the section, empty if not known (e.g. for indices built by scanning).
+		std::vector<uint32_t> objectOffsets;
+	};
+
+	FileIndex() :
+		_fileSize(0), _objectCount(0), _objectOffsetsComplete(true)
+	{
+	}
+
+	void clear()
+	{
+		_entries.clear();
+		_firstObject.clear();
+		_fileSize = 0;
+		_objectCount = 0;
+		_objectOffsetsComplete = true;
+	}
+
+	void add(int64_t offset, uint32_t size, const std::string& info,
+			const std::vector<uint32_t>& objectOffsets = std::vector<uint32_t>())
+	{
+		_entries.push_back(Entry());
+		Entry& entry = _entries.back();
+		entry.offset = offset;
+		entry.size = size;
+		entry.info = info;
+		entry.objectOffsets = objectOffsets;
+		addObjects(entry);
+	}
+
+	size_t size() const
+	{
+		return _entries.size();
+	}
+
+	bool empty() const
+	{
+		return _entries.empty();
+	}
+
+	const Entry& operator[](size_t i) const
+	{
+		return _entries[i];
+	}
+
+	/// Returns true if the object offsets of all sections are known.
+	bool hasObjectOffsets() const
+	{
+		return _objectOffsetsComplete && !_entries.empty();
+	}
+
+	/// Returns the number of objects in the file, only valid if hasObjectOffsets().
+	uint64_t getObjectCount() const
+	{
+		return _objectCount;
+	}
+
+	/// Looks up the section holding the object \p object (with 0 being the first
+	/// object) and its offset within the section data. Returns false if the object
+	/// is not in the file or the object offsets are not known.
+	bool findObject(uint64_t object, size_t& section, uint32_t& offset) const;
+
+	/// Size of the indexed file in bytes.
+	int64_t getFileSize() const
+	{
+		return _fileSize;
+	}
+
+	void setFileSize(int64_t size)
+	{
+		_fileSize = size;
+	}
+
+	/// Returns the name of the index file belonging to the PXL I/O file \p filename.
+	static std::string getIndexFileName(const std::string& filename)
+	{
+		return filename + ".pxlidx";
+	}
+
+	/// Writes the index to \p filename. Returns false if the file cannot be written.
+	bool write(const std::string& filename) const;
+
+	/// Reads the index from \p filename. Returns false and leaves the index
+	/// empty if the file does not exist or is not a valid index.
+	bool read(const std::string& filename);
+
+private:
+	void addObjects(const Entry& entry)
+	{
+		_firstObject.push_back(_objectCount);
+		_objectCount += entry.objectOffsets.size();
+		if (entry.objectOffsets.empty())
+			_objectOffsetsComplete = false;
+	}
+
+	std::vector<Entry> _entries;
+	/// Number of the first object of each section.
+	std::vector<uint64_t> _firstObject;
+	int64_t _fileSize;
+	uint64_t _objectCount;
+	bool _objectOffsetsComplete;
+};
+
+} //namespace pxl
+
+#endif // PXL_IO_FILE_INDEX_HH
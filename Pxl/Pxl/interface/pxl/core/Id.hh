@@ -13,12 +13,23 @@
 #include "Pxl/Pxl/interface/pxl/core/Random.hh"
 #include "Pxl/Pxl/interface/pxl/core/macros.hh"
 
+#include <cstring>
 #include <iostream>
+#include <stdint.h>
 
 #include "Pxl/Pxl/interface/pxl/core/Stream.hh"
 
 namespace pxl {
 
+/**
+ Tag for the constructors of Id and the Serializable classes which leave the
+ UUID unset, for objects which are filled by deserialize() right away (see
+ ObjectFactory::create).
+ */
+struct NoInit
+{
+};
+
 /**
  This class contains an implementation of a unique 
 identification (or UUID) for various objects used in PXL, e.g. Object Id
@@ -30,10 +41,19 @@ class PXL_DLL_EXPORT Id
 private:
 	unsigned char bytes[16]; /// Storage for the actual 16-digit ID.
 
+	/// Marks the random bytes as version 4 UUID.
+	void setVersion();
+
 public:
 	/// Constructor, creates a new UUID.
 	Id();
 
+	/// Constructor, leaves the UUID undefined. It has to be set by
+	/// deserialize() or generate() before use.
+	explicit Id(const NoInit&)
+	{
+	}
+
 	/// Constructor, reads a UUID from the InputStream \p in..
 	Id (const InputStream& in);
 	
@@ -49,7 +69,8 @@ public:
 	/// Geneate an ID with explicit passing of a Random object \p rand.
 	void generate(Random& rand);
 	
-	/// Generate an ID.
+	/// Generate an ID with a fast random number generator of the calling
+	/// thread, seeded from /dev/urandom.
 	void generate();
 	
 	/// Sets the ID to 0 (i.e. all components to 0).
@@ -61,6 +82,19 @@ public:
 	bool operator ==(const Id& id) const;
 	bool operator !=(const Id& id) const;
 	
+	/// Returns a 64 bit hash of the UUID, used by IdMap.
+	uint64_t hash() const
+	{
+		uint64_t low, high;
+		std::memcpy(&low, bytes, 8);
+		std::memcpy(&high, bytes + 8, 8);
+		uint64_t h = low ^ (high * 0x9E3779B97F4A7C15ULL);
+		h ^= h >> 32;
+		h *= 0xD6E8FEB86659FD93ULL;
+		h ^= h >> 32;
+		return h;
+	}
+
 	/// Less-than-operator, provides ordering of IDs.
 	bool operator <(const Id& op) const;
 
@@ -0,0 +1,291 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#ifndef PXL_BASE_ID_MAP_HH
+#define PXL_BASE_ID_MAP_HH
+
+#include "Pxl/Pxl/interface/pxl/core/macros.hh"
+
+#include <vector>
+
+#include "Pxl/Pxl/interface/pxl/core/Id.hh"
+
+namespace pxl
+{
+
+/**
+ Hash table mapping Ids to values of type \p T, used for the UUID lookups of
+ ObjectOwner, BasicContainer and ObjectFactory. The entries are stored in one
+ array (open addressing with linear probing) and found by Id::hash(), which
+ is stored with each entry so that only matching hashes compare the UUIDs.
+ The interface follows std::map, but the iteration order is unspecified and
+ inserting or erasing entries invalidates all iterators.
+ */
+template<class T> class IdMap
+{
+public:
+
+	/// Entry of the table, first is the key, second the value.
+	struct Entry
+	{
+		Entry() :
+			first(NoInit()), second(), hash(0)
+		{
+		}
+
+		Id first;
+		T second;
+		/// Id::hash() of the key, 0 for unused entries.
+		uint64_t hash;
+	};
+
+	typedef Entry value_type;
+
+	class const_iterator
+	{
+	public:
+		const_iterator() :
+			_entry(0), _end(0)
+		{
+		}
+
+		const_iterator(const Entry* entry, const Entry* end) :
+			_entry(entry), _end(end)
+		{
+			skipUnused();
+		}
+
+		const Entry& operator*() const
+		{
+			return *_entry;
+		}
+
+		const Entry* operator->() const
+		{
+			return _entry;
+		}
+
+		const_iterator& operator++()
+		{
+			++_entry;
+			skipUnused();
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator original = *this;
+			++(*this);
+			return original;
+		}
+
+		bool operator==(const const_iterator& other) const
+		{
+			return _entry == other._entry;
+		}
+
+		bool operator!=(const const_iterator& other) const
+		{
+			return _entry != other._entry;
+		}
+
+	private:
+		void skipUnused()
+		{
+			while (_entry != _end && _entry->hash == 0)
+				++_entry;
+		}
+
+		const Entry* _entry;
+		const Entry* _end;
+	};
+
+	IdMap() :
+		_size(0)
+	{
+	}
+
+	size_t size() const
+	{
+		return _size;
+	}
+
+	bool empty() const
+	{
+		return _size == 0;
+	}
+
+	const_iterator begin() const
+	{
+		if (_entries.empty())
+			return const_iterator();
+		return const_iterator(&_entries[0], &_entries[0] + _entries.size());
+	}
+
+	const_iterator end() const
+	{
+		if (_entries.empty())
+			return const_iterator();
+		const Entry* end = &_entries[0] + _entries.size();
+		return const_iterator(end, end);
+	}
+
+	/// Removes all entries, but keeps the table for reuse.
+	void clear()
+	{
+		if (_size == 0)
+			return;
+		for (size_t i = 0; i < _entries.size(); i++)
+		{
+			_entries[i].hash = 0;
+			_entries[i].second = T();
+		}
+		_size = 0;
+	}
+
+	const_iterator find(const Id& id) const
+	{
+		const Entry* entry = lookup(id);
+		if (!entry)
+			return end();
+		return const_iterator(entry, &_entries[0] + _entries.size());
+	}
+
+	/// Returns the value for \p id, or \p notFound if there is none.
+	T get(const Id& id, T notFound = T()) const
+	{
+		const Entry* entry = lookup(id);
+		return entry ? entry->second : notFound;
+	}
+
+	/// Inserts \p value for \p id if \p id is not in the table yet. Returns
+	/// false if it was.
+	bool insert(const Id& id, const T& value)
+	{
+		uint64_t hash = hashOf(id);
+		size_t pos = position(id, hash);
+		if (_entries[pos].hash != 0)
+			return false;
+		fill(pos, id, hash, value);
+		return true;
+	}
+
+	/// Inserts the pair \p value, like std::map::insert.
+	bool insert(const std::pair<Id, T>& value)
+	{
+		return insert(value.first, value.second);
+	}
+
+	T& operator[](const Id& id)
+	{
+		uint64_t hash = hashOf(id);
+		size_t pos = position(id, hash);
+		if (_entries[pos].hash == 0)
+			fill(pos, id, hash, T());
+		return _entries[pos].second;
+	}
+
+	/// Removes the entry of \p id and returns the number of removed entries.
+	size_t erase(const Id& id)
+	{
+		const Entry* entry = lookup(id);
+		if (!entry)
+			return 0;
+
+		// move the following entries of the probe sequence back into the
+		// gap, so that no entry is separated from its home position
+		size_t mask = _entries.size() - 1;
+		size_t gap = entry - &_entries[0];
+		size_t next = gap;
+		for (;;)
+		{
+			next = (next + 1) & mask;
+			if (_entries[next].hash == 0)
+				break;
+			size_t home = _entries[next].hash & mask;
+			if (((next - home) & mask) >= ((next - gap) & mask))
+			{
+				_entries[gap] = _entries[next];
+				gap = next;
+			}
+		}
+		_entries[gap].hash = 0;
+		_entries[gap].second = T();
+		_size--;
+		return 1;
+	}
+
+private:
+
+	static uint64_t hashOf(const Id& id)
+	{
+		uint64_t hash = id.hash();
+		return hash ? hash : 1;
+	}
+
+	const Entry* lookup(const Id& id) const
+	{
+		if (_size == 0)
+			return 0;
+		uint64_t hash = hashOf(id);
+		size_t mask = _entries.size() - 1;
+		for (size_t pos = hash & mask;; pos = (pos + 1) & mask)
+		{
+			const Entry& entry = _entries[pos];
+			if (entry.hash == 0)
+				return 0;
+			if (entry.hash == hash && entry.first == id)
+				return &entry;
+		}
+	}
+
+	/// Returns the position of \p id, or the free position it would go to.
+	/// The table is kept at most half full.
+	size_t position(const Id& id, uint64_t hash)
+	{
+		if (2 * (_size + 1) > _entries.size())
+			grow();
+		size_t mask = _entries.size() - 1;
+		size_t pos = hash & mask;
+		while (_entries[pos].hash != 0 && (_entries[pos].hash != hash
+				|| !(_entries[pos].first == id)))
+			pos = (pos + 1) & mask;
+		return pos;
+	}
+
+	void fill(size_t pos, const Id& id, uint64_t hash, const T& value)
+	{
+		_entries[pos].first = id;
+		_entries[pos].second = value;
+		_entries[pos].hash = hash;
+		_size++;
+	}
+
+	void grow()
+	{
+		std::vector<Entry> entries(_entries.empty() ? 16 : 2 * _entries.size());
+		entries.swap(_entries);
+		size_t mask = _entries.size() - 1;
+		for (size_t i = 0; i < entries.size(); i++)
+		{
+			if (entries[i].hash == 0)
+				continue;
+			size_t pos = entries[i].hash & mask;
+			while (_entries[pos].hash != 0)
+				pos = (pos + 1) & mask;
+			_entries[pos] = entries[i];
+		}
+	}
+
+	std::vector<Entry> _entries;
+	size_t _size;
+};
+
+} // namespace pxl
+
+#endif // PXL_BASE_ID_MAP_HH
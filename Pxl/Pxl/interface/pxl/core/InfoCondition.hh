@@ -0,0 +1,124 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#ifndef PXL_IO_INFO_CONDITION_HH
+#define PXL_IO_INFO_CONDITION_HH
+#include "Pxl/Pxl/interface/pxl/core/macros.hh"
+
+#include <string>
+#include <vector>
+#include <regex.h>
+
+namespace pxl
+{
+
+// io
+/**
+ This class provides a generic interface for a condition on the info string
+ of a file section. It is used to select file sections by their header only,
+ so that the blocks of all other sections are skipped without inflating them
+ (see InputHandler::nextFileSectionIf and InputHandler::setSectionFilter).
+ */
+class PXL_DLL_EXPORT InfoCondition
+{
+public:
+	virtual bool operator()(const std::string& info) const = 0;
+
+	virtual ~InfoCondition()
+	{
+	}
+};
+
+/**
+ Helper methods for info strings made of key=value pairs separated by
+ semicolons, e.g. "Run=1;LumiSection=2;EventNum=3", as written by the
+ OutputHandler for events (see OutputHandler::setSectionInfoKeys).
+ */
+class PXL_DLL_EXPORT SectionInfo
+{
+public:
+	/// Looks up \p key in \p info and sets \p value. Returns false if
+	/// the info string does not hold the key.
+	static bool getValue(const std::string& info, const std::string& key,
+			std::string& value);
+
+	/// Appends \p key=value to \p info.
+	static void addValue(std::string& info, const std::string& key,
+			const std::string& value);
+};
+
+/// Accepts info strings starting with the given prefix.
+class PXL_DLL_EXPORT InfoPrefixCondition : public InfoCondition
+{
+public:
+	InfoPrefixCondition(const std::string& prefix) :
+		_prefix(prefix)
+	{
+	}
+
+	virtual bool operator()(const std::string& info) const
+	{
+		return info.compare(0, _prefix.size(), _prefix) == 0;
+	}
+
+private:
+	std::string _prefix;
+};
+
+/// Accepts info strings matching a POSIX extended regular expression anywhere.
+class PXL_DLL_EXPORT InfoRegexCondition : public InfoCondition
+{
+public:
+	InfoRegexCondition(const std::string& pattern);
+
+	virtual ~InfoRegexCondition();
+
+	virtual bool operator()(const std::string& info) const;
+
+private:
+	InfoRegexCondition(const InfoRegexCondition& original)
+	{
+	}
+
+	InfoRegexCondition& operator= (const InfoRegexCondition& other)
+	{
+		return *this;
+	}
+
+	regex_t _regex;
+};
+
+/// Accepts info strings in which a key has one of the given values, see SectionInfo.
+/// Info strings without the key are accepted as well, unless \p acceptMissing
+/// is false, so files written without section info are read completely.
+class PXL_DLL_EXPORT InfoValueCondition : public InfoCondition
+{
+public:
+	InfoValueCondition(const std::string& key, const std::string& value,
+			bool acceptMissing = true) :
+		_key(key), _values(1, value), _acceptMissing(acceptMissing)
+	{
+	}
+
+	InfoValueCondition(const std::string& key,
+			const std::vector<std::string>& values, bool acceptMissing = true) :
+		_key(key), _values(values), _acceptMissing(acceptMissing)
+	{
+	}
+
+	virtual bool operator()(const std::string& info) const;
+
+private:
+	std::string _key;
+	std::vector<std::string> _values;
+	bool _acceptMissing;
+};
+
+} //namespace pxl
+
+#endif // PXL_IO_INFO_CONDITION_HH
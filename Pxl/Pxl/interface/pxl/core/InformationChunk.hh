@@ -29,6 +29,16 @@ class PXL_DLL_EXPORT InformationChunk: public Serializable,
 {
 public:
 
+	InformationChunk() :
+		Serializable()
+	{
+	}
+
+	explicit InformationChunk(const NoInit& tag) :
+		Serializable(tag)
+	{
+	}
+
 	/// Get the unique class ID  (UUID) of the InformationChunk.
 	virtual const Id& getTypeId() const
 	{
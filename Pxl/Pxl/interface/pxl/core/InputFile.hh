@@ -10,8 +10,10 @@
 #define PXL_IO_INPUTFILE_HH
 #include "Pxl/Pxl/interface/pxl/core/macros.hh"
 
+#include <algorithm>
 #include <fstream>
 #include <stdexcept>
+#include <vector>
 
 #include "Pxl/Pxl/interface/pxl/core/InputHandler.hh"
 #include "Pxl/Pxl/interface/pxl/core/ChunkReader.hh"
@@ -33,24 +35,48 @@ class InputFile: public InputHandler
 public:
 
 	InputFile() :
-			InputHandler(), _stream(), _reader(_stream)
+			InputHandler(), _stream(), _reader(_stream), _openMode(OpenRead)
 	{
 	}
 
 	InputFile(const std::string& filename) :
 			InputHandler(), _stream(), _reader(_stream,
-					ChunkReader::seekable)
+					ChunkReader::seekable), _openMode(OpenRead)
 	{
 		this->open(filename);
 	}
 
+	/// Local files are read through a memory mapping if enabled, which
+	/// avoids system calls and copies for each read. Takes effect with the next open().
+	void setMemoryMapped(bool mapped)
+	{
+		if (mapped)
+			_openMode |= OpenMapped;
+		else
+			_openMode &= ~OpenMapped;
+	}
+
+	/// Local files are read in large blocks, several of which are kept in flight
+	/// ahead of the read position (using io_uring where available). With
+	/// \p direct, the page cache is bypassed, which suits one-pass reading of
+	/// large files. Takes effect with the next open().
+	void setAsyncRead(bool async, bool direct = false)
+	{
+		_openMode &= ~(OpenAsync | OpenDirect);
+		if (async)
+			_openMode |= OpenAsync;
+		if (async && direct)
+			_openMode |= OpenDirect;
+	}
+
 	virtual void open(const std::string& filename)
 	{
+		_reader.stopReadAhead();
 		if (_stream.isOpen())
 			_stream.close();
 		_stream.clear();
 		reset();
-		_stream.open(filename.c_str(), OpenRead);
+		_stream.open(filename.c_str(), _openMode);
 		if (_stream.isBad())
 		{
 			PXL_LOG_ERROR << "Error opening file " << filename;
@@ -60,8 +86,27 @@ public:
 		_reader.setStatus(ChunkReader::preHeader);
 	}
 
+	/// Reads the first \p bytes of a freshly opened file and goes back to its
+	/// beginning, so that they are in the page cache (local files) or the
+	/// buffer of remote files when reading starts.
+	void warmUp(size_t bytes)
+	{
+		std::vector<char> buffer(std::min(bytes, (size_t) 1048576));
+		for (size_t done = 0; done < bytes && !buffer.empty();)
+		{
+			int64_t count = _stream.read(&buffer[0],
+					std::min(bytes - done, buffer.size()));
+			if (count <= 0)
+				break;
+			done += count;
+		}
+		_stream.clear();
+		_stream.seek(0, SeekBegin);
+	}
+
 	virtual void close()
 	{
+		_reader.stopReadAhead();
 		if (_stream.isOpen())
 			_stream.close();
 		reset();
@@ -70,6 +115,7 @@ public:
 
 	virtual ~InputFile()
 	{
+		_reader.stopReadAhead();
 		if (_stream.isOpen())
 			_stream.close();
 	}
@@ -81,11 +127,16 @@ public:
 
 	virtual bool good()
 	{
+		// the file itself is ahead of the sections handed out so far
+		if (_reader.isReadingAhead())
+			return !_reader.eof();
 		return _stream.isGood();
 	}
 
 	virtual bool eof()
 	{
+		if (_reader.isReadingAhead())
+			return _reader.eof();
 		return _stream.isEof();
 	}
 
@@ -96,7 +147,7 @@ public:
 
 private:
 	InputFile(const InputFile& original) :
-			_stream(), _reader(_stream, ChunkReader::seekable)
+			_stream(), _reader(_stream, ChunkReader::seekable), _openMode(OpenRead)
 	{
 	}
 
@@ -107,6 +158,7 @@ private:
 
 	File _stream;
 	ChunkReader _reader;
+	int32_t _openMode;
 
 };
 
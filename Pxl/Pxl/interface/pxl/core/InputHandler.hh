@@ -12,6 +12,8 @@
 
 #include <iostream>
 #include <stdexcept>
+#include <set>
+#include <vector>
 
 #include "Pxl/Pxl/interface/pxl/core/ChunkReader.hh"
 #include "Pxl/Pxl/interface/pxl/core/Id.hh"
@@ -65,6 +67,23 @@ public:
 		return false;
 	}
 
+	/// Reads in the next file section whose info string fulfils \p condition,
+	/// e.g. an InfoValueCondition on the run number. The sections in between
+	/// are skipped by their headers, without reading or inflating their blocks.
+	bool nextFileSectionIf(const InfoCondition& condition, skipMode doSkip = on)
+	{
+		return getChunkReader().next(condition, doSkip);
+	}
+
+	/// Skips all file sections whose info string does not fulfil \p filter
+	/// whenever a section header is read, also in readNextObject(). The filter
+	/// is not owned and must stay valid while it is set, 0 removes it. When
+	/// reading ahead, it is evaluated in the read-ahead thread.
+	void setSectionFilter(const InfoCondition* filter)
+	{
+		getChunkReader().setSectionFilter(filter);
+	}
+
 
 	/// Use this method in case the file contains pxl::Events after a next-statement. 
 	/// A pxl::Event is passed to this method and filled with the current event.
@@ -119,7 +138,7 @@ public:
 	int skipFileSections(int n);
 
 	/// seek to the desired file section (with 0 being the first file section)
-	bool seekToFileSection(int index);
+	virtual bool seekToFileSection(int index);
 	
 	/// Reads in the next block.
 	bool readBlock()
@@ -137,8 +156,9 @@ public:
 	template<class objecttype> bool readObject(objecttype* obj) ;
 
 	/// Seek to the desired object (with 0 being the first object).
-	/// Current implementation inefficient due to missing file index.
-	Serializable* seekToObject(size_t index) ;
+	/// Reads all objects up to the desired one, the RandomAccessInputFile
+	/// jumps there directly using its file index.
+	virtual Serializable* seekToObject(size_t index) ;
 	
 	/// This method reads in the next object from the file, regardless of file section boundaries.
 	/// In case there are no more objects to be read, a zero pointer is returned.
@@ -146,6 +166,13 @@ public:
 	/// deletion responsibility.
 	Serializable* readNextObject() ;
 
+	/// Reads the next pxl::Event from the file into \p event, regardless of file
+	/// section boundaries, and skips other objects on the way. The previous
+	/// content of \p event is replaced, so one event object can be reused for
+	/// the whole file instead of creating (and copying) a new one per event.
+	/// Returns false if there are no more events.
+	bool readNextEvent(Event& event) ;
+
 	/// This method reads in the previous object from the file, regardless of file section boundaries.
 	/// Attention: This method returns an object which was created with new. The user takes
 	/// deletion responsibility.	
@@ -177,6 +204,52 @@ public:
 		getChunkReader().reset();
 	}
 	
+	/// Reads and inflates up to \p sections file sections ahead in a background thread
+	/// while the current one is processed. Pays off for sequential reading with
+	/// nextFileSection() or readNextObject(), seeking stops the thread until the next
+	/// section header is read. 0 disables reading ahead.
+	void setReadAhead(size_t sections)
+	{
+		getChunkReader().setReadAhead(sections);
+	}
+
+	/// Inflates the blocks read ahead on \p threads worker threads, see ChunkReader::setInflateThreads.
+	void setInflateThreads(size_t threads)
+	{
+		getChunkReader().setInflateThreads(threads);
+	}
+
+	/// Sets the dictionary for Zstandard compressed files written with one.
+	void setZstdDictionary(const std::string& dictionary)
+	{
+		getChunkReader().setZstdDictionary(dictionary);
+	}
+
+	/// Decodes the objects in EventViews only when they are first accessed,
+	/// e.g. with getObjectsOfType(). Saves the time spent on views that an
+	/// analysis reads but never looks into, e.g. "Gen" for data.
+	void setLazyEventViews(bool lazy)
+	{
+		getChunkReader().setDeferredContent(lazy);
+	}
+
+	/// Decodes the objects of the EventViews named in \p names right away and
+	/// those of all other views only when they are first accessed.
+	/// An empty list decodes all views right away.
+	void setEventViewAllowList(const std::vector<std::string>& names)
+	{
+		getChunkReader().setDeferredContent(!names.empty(),
+				std::set<std::string>(names.begin(), names.end()));
+	}
+
+	/// Keeps the values of user records serialized and decodes each of them
+	/// when it is first read. Saves the time spent on the records of the
+	/// particles that an analysis never looks at.
+	void setLazyUserRecords(bool lazy)
+	{
+		getChunkReader().setLazyUserRecords(lazy);
+	}
+
 	/// Returns the size of the associated file.
 	size_t getSize()
 	{
@@ -189,6 +262,12 @@ public:
 		return getChunkReader().getPosition();
 	}
 	
+protected:
+	/// Sets the number of read objects, for derived classes positioning the file themselves.
+	void setObjectCount(size_t count)
+	{
+		_objectCount = count;
+	}
 
 private:
 	InputHandler(const InputHandler& original)
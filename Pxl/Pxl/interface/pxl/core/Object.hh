@@ -37,6 +37,11 @@ public:
 	{
 	}
 
+	explicit Object(const NoInit& tag) :
+		Relative(tag), _locked(0), _workflag(0)
+	{
+	}
+
 	Object(const Object& original) :
 		Relative(original), UserRecordHelper(original), _locked(original._locked), _workflag(
 				original._workflag)
@@ -64,6 +69,9 @@ public:
 
 	virtual void deserialize(const InputStream &in);
 
+	/// Reads past a serialized Object without decoding it, see ObjectFactory::skip.
+	static void skipSerialized(const InputStream &in);
+
 	/// Creates a deep copy and returns a C++ pointer to the newly-created object.
 	virtual Serializable* clone() const
 	{
@@ -0,0 +1,108 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#ifndef PXL_BASE_OBJECT_ARENA_HH
+#define PXL_BASE_OBJECT_ARENA_HH
+
+#include "Pxl/Pxl/interface/pxl/core/macros.hh"
+
+#include <vector>
+
+namespace pxl
+{
+
+/**
+ Memory for the pxl::Relative derivatives (particles, vertices, event views, ...)
+ of an event. While an arena is the current one of a thread (see Scope), the
+ objects created in that thread are placed one after another in large chunks
+ instead of getting a heap allocation each. Deleting such an object only
+ counts it, and reset() makes the chunks of deleted objects available again,
+ so that reading the next event into the same pxl::Event does not go through
+ malloc and free for every object.
+ Objects which outlive the event (e.g. taken out of it) keep their chunk, and
+ the arena, alive until they are deleted. Objects created outside of any
+ arena, and large ones, are allocated on the heap as usual.
+ */
+class PXL_DLL_EXPORT ObjectArena
+{
+public:
+
+	explicit ObjectArena(size_t chunkSize = 65536);
+
+	/// Makes \p arena the current arena of this thread (0 for the heap)
+	/// while the scope exists.
+	class Scope
+	{
+		ObjectArena* _previous;
+	public:
+		explicit Scope(ObjectArena* arena);
+		~Scope();
+	};
+
+	/// Returns the current arena of this thread, 0 if objects go to the heap.
+	static ObjectArena* current();
+
+	/// Allocates \p size bytes in the current arena, or on the heap.
+	/// Used by Relative::operator new.
+	static void* allocate(size_t size);
+
+	/// Frees memory obtained from allocate(). Used by Relative::operator delete.
+	static void deallocate(void* p);
+
+	/// Makes the memory of all deleted objects available for new ones. Chunks
+	/// with objects still alive are left to them.
+	void reset();
+
+	/// Called by the owner instead of deleting the arena, which is deleted
+	/// as soon as no objects in it are alive anymore.
+	void release();
+
+	/// Returns the number of objects alive in the arena.
+	size_t getObjectCount() const
+	{
+		return _objectCount;
+	}
+
+	/// Returns the number of chunks used for new objects.
+	size_t getChunkCount() const
+	{
+		return _chunks.size();
+	}
+
+private:
+
+	struct Chunk
+	{
+		ObjectArena* arena;
+		char* data;
+		size_t used;
+		size_t objectCount;
+		/// Set when the chunk is left to the objects still alive in it.
+		bool retired;
+	};
+
+	~ObjectArena();
+
+	void* allocateInChunk(size_t size);
+	void freeChunk(Chunk* chunk);
+
+	size_t _chunkSize;
+	std::vector<Chunk*> _chunks;
+	std::vector<Chunk*> _retired;
+	/// Chunk new objects are placed in.
+	size_t _current;
+	size_t _objectCount;
+	bool _released;
+
+	ObjectArena(const ObjectArena&);
+	ObjectArena& operator=(const ObjectArena&);
+};
+
+} // namespace pxl
+
+#endif // PXL_BASE_OBJECT_ARENA_HH
@@ -14,6 +14,7 @@
 
 #include "Pxl/Pxl/interface/pxl/core/Serializable.hh"
 #include "Pxl/Pxl/interface/pxl/core/Id.hh"
+#include "Pxl/Pxl/interface/pxl/core/IdMap.hh"
 
 // io
 /**
@@ -28,22 +29,45 @@ class ObjectProducerInterface;
 
 class PXL_DLL_EXPORT ObjectFactory
 {
+public:
+
+	/// Function reading past the serialized data of an object without creating it.
+	typedef void (*SkipFunction)(const InputStream& in);
+
+	typedef IdMap<const ObjectProducerInterface *> ProducerMap;
+
 private:
 
 	ObjectFactory();
 
-	std::map<Id, const ObjectProducerInterface *> _Producers;
+	ProducerMap _Producers;
+	IdMap<SkipFunction> _skipFunctions;
+	/// Changed with every (un)registered producer, invalidates the cached
+	/// producers of create().
+	unsigned long _generation;
 
 public:
 
 	static ObjectFactory& instance();
 
+	/// Creates an object of the type \p id to be filled by deserialize(),
+	/// its UUID is not set. Returns 0 if the type is unknown.
 	Serializable *create(const Id& id);
 
+	/// Reads past the serialized data of an object of type \p id, which is
+	/// used for content that is decoded later (see ObjectManager). Types
+	/// without skip function are deserialized into a temporary object.
+	/// Returns false if the type is unknown.
+	bool skip(const Id& id, const InputStream& in);
+
 	void
 			registerProducer(const Id& id,
 					const ObjectProducerInterface* producer);
 	void unregisterProducer(const ObjectProducerInterface* producer);
+
+	/// Registers \p function for skipping objects of exactly the type \p id.
+	void registerSkipFunction(const Id& id, SkipFunction function);
+	void unregisterSkipFunction(const Id& id);
 };
 
 class ObjectProducerInterface
@@ -54,6 +78,13 @@ public:
 	}
 
 	virtual Serializable *create() const = 0;
+
+	/// Creates an object which is filled by deserialize() right away,
+	/// producers may skip the generation of its UUID.
+	virtual Serializable *create(const NoInit&) const
+	{
+		return create();
+	}
 };
 
 template<class T>
@@ -77,6 +108,21 @@ public:
 	}
 };
 
+/// Producer for types with a constructor taking pxl::NoInit, which is used
+/// for objects that are deserialized right away.
+template<class T>
+class NoInitObjectProducerTemplate: public ObjectProducerTemplate<T>
+{
+public:
+
+	using ObjectProducerTemplate<T>::create;
+
+	virtual Serializable *create(const NoInit& tag) const
+	{
+		return new T(tag);
+	}
+};
+
 } // namespace pxl
 
 #endif // PXL_IO_OBJECT_FACTORY_HH
@@ -27,25 +27,40 @@ namespace pxl
  corresponding service methods. This way, physics objects (like instances of the classes
  pxl::Particle, pxl::Vertex or pxl::Collision as well as other arbitrary pxl::Relative derivatives can be
  aggregated and managed.
+ When read from a stream with deferred content (see InputStream::setDeferredContent),
+ the contained objects are kept serialized and decoded on the first access to them.
  */
 class PXL_DLL_EXPORT ObjectManager : public Object
 {
 public:
 	ObjectManager() :
-		Object(), _objects()
+		Object(), _objects(), _lazyUserRecords(false)
 	{
+		// the contained objects go where this object was created
+		_objects.setArena(ObjectArena::current());
+	}
+	explicit ObjectManager(const NoInit& tag) :
+		Object(tag), _objects(), _lazyUserRecords(false)
+	{
+		_objects.setArena(ObjectArena::current());
 	}
 	/// This copy constructor performs a deep copy of \p original
 	/// with all contained objects and their (redirected) relations.
 	ObjectManager(const ObjectManager& original) :
-		Object(original), _objects(original._objects)
+		Object(original), _objects(original._objects),
+		_deferredContent(original._deferredContent),
+		_lazyUserRecords(original._lazyUserRecords)
 	{
+		_objects.setArena(ObjectArena::current());
 	}
 	/// This copy constructor performs a deep copy of \p original
 	/// with all contained objects and their (redirected) relations.
 	explicit ObjectManager(const ObjectManager* original) :
-		Object(original), _objects(original->_objects)
+		Object(original), _objects(original->_objects),
+		_deferredContent(original->_deferredContent),
+		_lazyUserRecords(original->_lazyUserRecords)
 	{
+		_objects.setArena(ObjectArena::current());
 	}
 
 	virtual const Id& getTypeId() const
@@ -59,16 +74,17 @@ public:
 		return id;
 	}
 
-	virtual void serialize(const OutputStream &out) const
-	{
-		Object::serialize(out);
-		_objects.serialize(out);
-	}
+	virtual void serialize(const OutputStream &out) const;
+
+	virtual void deserialize(const InputStream &in);
 
-	virtual void deserialize(const InputStream &in)
+	/// Reads past a serialized ObjectManager without decoding it, see ObjectFactory::skip.
+	static void skipSerialized(const InputStream &in);
+
+	/// Returns true if the contained objects are still serialized.
+	bool hasDeferredContent() const
 	{
-		Object::deserialize(in);
-		_objects.deserialize(in);
+		return !_deferredContent.empty();
 	}
 
 	/// Creates a deep copy and returns a C++ pointer to the newly-created object.
@@ -83,6 +99,7 @@ public:
 	/// the newly-created instance is owned and will be deleted by the object owner.
 	template<class datatype> datatype* create()
 	{
+		decodeContent();
 		return _objects.create<datatype>();
 	}
 
@@ -90,6 +107,7 @@ public:
 	/// Acts like create() and registers the newly-created instance under \p key in the index.
 	template<class datatype> datatype* createIndexed(const std::string& key)
 	{
+		decodeContent();
 		datatype* obj = _objects.create<datatype>();
 		setIndexEntry(key, obj);
 		return obj;
@@ -98,12 +116,14 @@ public:
 	/// Inserts \p obj in the container of the object owner and takes deletion responsability.
 	inline void insertObject(Relative* obj)
 	{
+		decodeContent();
 		_objects.insert(obj);
 	}
 
 	/// Inserts \p obj with the \p key in the container of the object owner and takes deletion responsability.
 	inline void insertObject(Relative* obj, const std::string& key)
 	{
+		decodeContent();
 		_objects.insert(obj);
 		setIndexEntry(key, obj);
 	}
@@ -112,24 +132,28 @@ public:
 	/// please notice, that obj must be owned by this object owner and \p key must not be a zero length string.
 	inline bool setIndexEntry(const std::string& key, Relative* obj)
 	{
+		decodeContent();
 		return _objects.setIndexEntry(key, obj);
 	}
 
 	/// Provides access to the object owner.
 	inline ObjectOwner& getObjectOwner()
 	{
+		decodeContent();
 		return _objects;
 	}
 
 	/// Provides const access to the object owner.
 	inline const ObjectOwner& getObjectOwner() const
 	{
+		decodeContent();
 		return _objects;
 	}
 
 	/// Returns a const reference to the underlying vector with pointers to all contained objects.
 	inline const std::vector<Relative*>& getObjects() const
 	{
+		decodeContent();
 		return _objects.getObjects();
 	}
 
@@ -139,24 +163,28 @@ public:
 	template<class objecttype> inline void getObjectsOfType(
 			std::vector<objecttype*>& vec) const
 	{
+		decodeContent();
 		_objects.getObjectsOfType<objecttype>(vec);
 	}
 
 	/// Deletes the object \p obj.
 	inline void removeObject(Relative* obj)
 	{
+		decodeContent();
 		_objects.remove(obj);
 	}
 
 	/// Takes the object \p obj from the object owner.
 	inline void takeObject(Relative* obj)
 	{
+		decodeContent();
 		_objects.take(obj);
 	}
 
 	/// Clears the object owner and deletes all owned objects.
 	inline void clearObjects()
 	{
+		_deferredContent.clear();
 		_objects.clearContainer();
 	}
 
@@ -166,6 +194,7 @@ public:
 	template<class objecttype> inline objecttype* findObject(
 			const std::string key) const
 	{
+		decodeContent();
 		return _objects.findObject<objecttype>(key);
 	}
 
@@ -175,36 +204,42 @@ public:
 	template<class objecttype> inline objecttype* findCopyOf(
 			const Relative* original) const
 	{
+		decodeContent();
 		return _objects.findCopyOf<objecttype>(original);
 	}
 
 	/// Provides direct access to the copy history (created by the copy constructor).
-	inline const std::map<Id, Relative*>& getCopyHistory() const
+	inline const IdMap<Relative*>& getCopyHistory() const
 	{
+		decodeContent();
 		return _objects.getCopyHistory();
 	}
 
 	/// Clears the copy history  (created by the copy constructor).
 	inline void clearCopyHistory()
 	{
+		decodeContent();
 		_objects.clearCopyHistory();
 	}
 
 	/// Provides direct access to the index.
 	inline const std::map<std::string, Relative*>& getIndex() const
 	{
+		decodeContent();
 		return _objects.getIndexEntry();
 	}
 
 	/// Removes the index entry with the \p key; please notice: it does not remove the object itself.
 	inline void removeIndexEntry(const std::string& key)
 	{
+		decodeContent();
 		_objects.removeIndexEntry(key);
 	}
 
 	/// Clears the index; please notice: it does not remove the objects themself.
 	inline void clearIndex()
 	{
+		decodeContent();
 		_objects.clearIndex();
 	}
 
@@ -214,7 +249,21 @@ public:
 	}
 
 private:
+	/// Decodes the contained objects if they are still serialized.
+	void decodeContent() const
+	{
+		if (!_deferredContent.empty())
+			decodeDeferredContent();
+	}
+
+	void decodeDeferredContent() const;
+
 	ObjectOwner _objects;
+	/// Serialized contained objects, see deserialize().
+	mutable std::vector<char> _deferredContent;
+	/// Whether the user records in _deferredContent are decoded lazily, as
+	/// they would have been when read right away.
+	bool _lazyUserRecords;
 
 	ObjectManager& operator=(const ObjectManager& original)
 	{
@@ -13,7 +13,9 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <typeinfo>
 
+#include "Pxl/Pxl/interface/pxl/core/IdMap.hh"
 #include "Pxl/Pxl/interface/pxl/core/Relative.hh"
 #include "Pxl/Pxl/interface/pxl/core/weak_ptr.hh"
 
@@ -22,10 +24,27 @@ namespace pxl
 
 class ObjectOwner;
 
+/// Casts \p relative, which is known to be an \p objecttype, without RTTI
+/// if \p objecttype is derived from Relative. The second argument selects
+/// the overload, pass (objecttype*) 0.
+template<class objecttype> inline objecttype* relativeCast(Relative* relative,
+		const Relative*)
+{
+	return static_cast<objecttype*>(relative);
+}
+
+template<class objecttype> inline objecttype* relativeCast(Relative* relative,
+		const void*)
+{
+	return dynamic_cast<objecttype*>(relative);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - -
 /// For STL-style iteration on selective class: iterator class template;
 /// this iterator behaves like a normal STL iterator but ignores all objects
-/// that cannot be interpreted as type objecttype (tested by dynamic casts).
+/// that cannot be interpreted as type objecttype.
+/// If only objects of a single type match, the iterator walks the list the
+/// owner keeps of them, otherwise it tests all objects with dynamic casts.
 /// Use in STL-style, except that either begin gets the objecttype class as template argument,
 /// or a constructor of the TypeIterator is used.
 template<class objecttype> class ObjectOwnerTypeIterator
@@ -54,7 +73,20 @@ public:
 	inline bool operator!=(const_iterator iter);
 
 private:
+	void init();
+
+	/// Objects of the only matching type, 0 if all objects are tested. The
+	/// list is looked up by its type slot each time, creating objects may
+	/// move it.
+	const std::vector<Relative*>* objects() const;
+
 	const ObjectOwner* _containerRef;
+	/// True if only the objects of the type slot _type are walked.
+	bool _single;
+	size_t _type;
+	/// Position in the objects of _type, _iter is not used while they are
+	/// walked.
+	size_t _position;
 	const_iterator _iter;
 };
 
@@ -70,20 +102,22 @@ private:
  the contained objects, and re-establishes corresponding mother-daughter relations
  amongst the copied objects. For the convenience of a quick and targeted object access, the
  newly created owner carries a so-called copy history for mapping original and
- copied objects. This information is used by the findCopyOf() method:
+ copied objects, which is built from the copies on the first use. This information is used by the findCopyOf() method:
  provided a reference to the original object, this method returns a pointer to the copied object.
  A further, powerful tool for targeted object access is the so-called index, which
  allows to map objects to unique string identifiers, the key. The method findObject()
  can be used to directly access objects by their keys or object-ids.
  The ObjectOwner extends the functionality of the contained STL vector. It provides a selective iterator, the class template
  ObjectOwner::TypeIterator, that ignores all objects other than the
- specialized data type.
+ specialized data type. For these, and getObjectsOfType(), the owner keeps
+ a list of the objects of each C++ type, so that the objects of a type are
+ found without casting every contained object.
  */
 class PXL_DLL_EXPORT ObjectOwner
 {
 public:
 	ObjectOwner() :
-		_container(), _copyHistory(), _index(), _uuidSearchMap()
+		_container(), _copyHistory(), _copies(), _index(), _uuidSearchMap(), _types(), _arena(0)
 	{
 	}
 	/// This copy constructor performs a deep copy of object
@@ -91,7 +125,7 @@ public:
 	/// A copy history keeps track of originals and copies
 	/// and the findCopyOf() method allows quick access to the copies.
 	ObjectOwner(const ObjectOwner& original) :
-		_container(), _copyHistory(), _index(), _uuidSearchMap()
+		_container(), _copyHistory(), _copies(), _index(), _uuidSearchMap(), _types(), _arena(0)
 	{
 		this->init(original);
 	}
@@ -101,7 +135,7 @@ public:
 	/// A copy history keeps track of originals and copies
 	/// and the findCopyOf() method allows quick access to the copies.
 	explicit ObjectOwner(const ObjectOwner* original) :
-		_container(), _copyHistory(), _index(), _uuidSearchMap()
+		_container(), _copyHistory(), _copies(), _index(), _uuidSearchMap(), _types(), _arena(0)
 	{
 		this->init(*original);
 	}
@@ -125,15 +159,20 @@ public:
 
 	virtual void deserialize(const InputStream &in);
 
+	/// Reads past a serialized ObjectOwner without decoding its objects.
+	static void skipSerialized(const InputStream &in);
+
 	/// Creates a new instance of \p objecttype;
 	/// objecttype must be a class inheriting from Relative;
 	/// the newly-created instance is owned and will be deleted by this object owner.
 	template<class objecttype> objecttype* create()
 	{
+		ObjectArena::Scope scope(_arena);
 		objecttype* pitem = new objecttype;
 		pitem->_refObjectOwner = this;
 		_container.push_back(static_cast<Relative*>(pitem));
-		_uuidSearchMap.insert(std::pair<Id, Relative*>(pitem->getId(), pitem));
+		_uuidSearchMap.insert(pitem->getId(), pitem);
+		addToType(pitem, typeid(objecttype));
 		return pitem;
 	}
 
@@ -143,13 +182,27 @@ public:
 	template<class objecttype> objecttype* create(
 	const objecttype* original)
 	{
+		ObjectArena::Scope scope(_arena);
 		objecttype* pitem = new objecttype(*original);
 		pitem->_refObjectOwner = this;
 		_container.push_back(static_cast<Relative*>(pitem));
-		_uuidSearchMap.insert(std::pair<Id, Relative*>(pitem->getId(), pitem));
+		_uuidSearchMap.insert(pitem->getId(), pitem);
+		addToType(pitem, typeid(objecttype));
 		return pitem;
 	}
 
+	/// Objects created by this owner (create(), deserialize()) are allocated
+	/// in \p arena, 0 allocates them on the heap. The arena is not owned.
+	void setArena(ObjectArena* arena)
+	{
+		_arena = arena;
+	}
+
+	ObjectArena* getArena() const
+	{
+		return _arena;
+	}
+
 	/// Inserts \p value in the container of this object owner and takes deletion responsibility.
 	void set(Relative* value) 
 	{
@@ -198,12 +251,9 @@ public:
 
 	/// Returns a Relative pointer for a contained object with the passed ID.
 	/// In case the Relative is not in the container, 0 is returned.
-	Relative* getById(Id id) const
+	Relative* getById(const Id& id) const
 	{
-		std::map<Id, Relative*>::const_iterator found = _uuidSearchMap.find(id);
-		if ( found != _uuidSearchMap.end() )
-		return found->second;
-		return 0;
+		return _uuidSearchMap.get(id);
 	}
 
 	/// Searches the copy history to locate the copy of \p original and
@@ -213,21 +263,21 @@ public:
 	const Relative* original) const // goes via CopyHistory & casts
 
 	{
-		std::map<Id, Relative*>::const_iterator it = _copyHistory.find(original->id());
-		if (it!=_copyHistory.end())
-		return dynamic_cast<objecttype*>(it->second);
-		return 0;
+		buildCopyHistory();
+		return dynamic_cast<objecttype*>(_copyHistory.get(original->id()));
 	}
 
 	/// Provides direct access to the copy history (created by the copy constructor).
-	inline const std::map<Id, Relative*>& getCopyHistory() const
+	inline const IdMap<Relative*>& getCopyHistory() const
 	{
+		buildCopyHistory();
 		return _copyHistory;
 	}
 	/// Clears the copy history  (created by the copy constructor).
 	inline void clearCopyHistory()
 	{
 		_copyHistory.clear();
+		_copies.clear();
 	}
 
 	/// Registers the object \p obj with the \p key in the index and returns true in case of success;
@@ -295,15 +345,55 @@ public:
 	template<class objecttype> size_t getObjectsOfType(std::vector<objecttype*>& vec) const
 	{
 		size_t size = vec.size();
-		for (ObjectOwner::const_iterator iter = begin(); iter!=end(); ++iter)
+		size_t type = 0;
+		size_t types = findTypes<objecttype>(type);
+		if (types == 1)
 		{
-			objecttype* obj = dynamic_cast<objecttype*>(*iter);
-			if (obj!=0)
-			vec.push_back(obj);
+			const std::vector<Relative*>* objects = &getTypeObjects(type);
+			vec.reserve(size + objects->size());
+			for (const_iterator iter = objects->begin(); iter != objects->end(); ++iter)
+			vec.push_back(relativeCast<objecttype>(*iter, (objecttype*) 0));
+		}
+		else if (types > 1)
+		{
+			// several types, keep the order of the container
+			for (ObjectOwner::const_iterator iter = begin(); iter!=end(); ++iter)
+			{
+				objecttype* obj = dynamic_cast<objecttype*>(*iter);
+				if (obj!=0)
+				vec.push_back(obj);
+			}
 		}
 		return vec.size()-size;
 	}
 
+	/// Returns the number of C++ types of the contained objects which are
+	/// \p objecttype or derived from it. \p type is set to the slot of the
+	/// last of them, see getTypeObjects().
+	template<class objecttype> size_t findTypes(size_t& type) const
+	{
+		size_t types = 0;
+		for (size_t i = 0; i < _types.size(); i++)
+		{
+			// all objects of a type give the same result
+			if (!_types[i].objects.empty()
+					&& dynamic_cast<objecttype*>(_types[i].objects.front()))
+			{
+				type = i;
+				types++;
+			}
+		}
+		return types;
+	}
+
+	/// Returns the objects, in the order of the container, of the type slot
+	/// \p type found by findTypes(). A slot keeps its type until the
+	/// container is cleared, also when its last object is removed.
+	const std::vector<Relative*>& getTypeObjects(size_t type) const
+	{
+		return _types[type].objects;
+	}
+
 
 
 	/// This templated method provides an STL-style begin()-method to
@@ -319,59 +409,111 @@ public:
 	void sort(int (*comp)(Relative*, Relative*))
 	{
 		std::sort(_container.begin(), _container.end(), comp);
+		sortTypes();
 	}
 		
 
 private:
+	/// Contained objects of one C++ type.
+	struct TypeObjects
+	{
+		const std::type_info* type;
+		std::vector<Relative*> objects;
+	};
+
 	void init(const ObjectOwner& original);
 
+	void addToType(Relative* item, const std::type_info& type);
+	void removeFromType(Relative* item);
+	/// Restores the order of the container in the lists of the types.
+	void sortTypes();
+
+	/// Moves the copies made by init() into the copy history.
+	void buildCopyHistory() const
+	{
+		if (!_copies.empty())
+			fillCopyHistory();
+	}
+
+	void fillCopyHistory() const;
+
+	/// Removes \p item from the copy history.
+	void eraseCopy(const Relative* item);
+
 	std::vector<Relative*> _container;
-	std::map<Id, Relative*> _copyHistory;
+	mutable IdMap<Relative*> _copyHistory;
+	/// Ids of the originals and their copies, not yet in the copy history.
+	mutable std::vector<std::pair<Id, Relative*> > _copies;
 	std::map<std::string, Relative*> _index;
-	std::map<Id, Relative*> _uuidSearchMap;
+	IdMap<Relative*> _uuidSearchMap;
+	std::vector<TypeObjects> _types;
+	ObjectArena* _arena;
 
 };
 
 /// Copy constructor.
 template <class objecttype>
 ObjectOwnerTypeIterator<objecttype>::ObjectOwnerTypeIterator(const ObjectOwnerTypeIterator& other) :
-	_containerRef(other._containerRef), _iter(other._iter)
+	_containerRef(other._containerRef), _single(other._single),
+	_type(other._type), _position(other._position), _iter(other._iter)
 {
 }
 
 /// Constructor from ObjectOwner instance.
 template <class objecttype>
 ObjectOwnerTypeIterator<objecttype>::ObjectOwnerTypeIterator(const ObjectOwner& container) :
-	_containerRef(&container), _iter(container.begin())
+	_containerRef(&container), _single(false), _type(0), _position(0),
+	_iter(container.end())
 {
-	if ( _iter!=_containerRef->end() && dynamic_cast<objecttype*>(*_iter)==0)
-	(*this)++;
+	init();
 }
 
 /// Constructor from ObjectOwner instance.
 template <class objecttype>
 ObjectOwnerTypeIterator<objecttype>::ObjectOwnerTypeIterator(const ObjectOwner* container) :
-_containerRef(container), _iter(container->begin())
+_containerRef(container), _single(false), _type(0), _position(0),
+_iter(container->end())
 {
-	if ( _iter!=_containerRef->end() && dynamic_cast<objecttype*>(*_iter)==0)
-	(*this)++;
+	init();
+}
+
+template <class objecttype>
+void ObjectOwnerTypeIterator<objecttype>::init()
+{
+	size_t types = _containerRef->findTypes<objecttype>(_type);
+	_single = types == 1;
+	if (types > 1)
+	{
+		_iter = _containerRef->begin();
+		if ( _iter!=_containerRef->end() && dynamic_cast<objecttype*>(*_iter)==0)
+		(*this)++;
+	}
+}
+
+template <class objecttype>
+inline const std::vector<Relative*>* ObjectOwnerTypeIterator<objecttype>::objects() const
+{
+	return _single ? &_containerRef->getTypeObjects(_type) : 0;
 }
 
 template <class objecttype>
 const ObjectOwnerTypeIterator<objecttype> ObjectOwnerTypeIterator<objecttype>::operator++(int)
 {
 	ObjectOwnerTypeIterator orig = *this;
-	if (_iter!=_containerRef->end())
-	do
-	_iter++;
-	while (_iter!=_containerRef->end()
-	&& dynamic_cast<objecttype*>(*_iter)==0);
+	++(*this);
 	return orig;
 }
 
 template <class objecttype>
 const ObjectOwnerTypeIterator<objecttype>& ObjectOwnerTypeIterator<objecttype>::operator++()
 {
+	if (const std::vector<Relative*>* objects = this->objects())
+	{
+		if (_position<objects->size())
+		_position++;
+		return *this;
+	}
+
 	if (_iter!=_containerRef->end())
 	do
 	_iter++;
@@ -383,6 +525,8 @@ const ObjectOwnerTypeIterator<objecttype>& ObjectOwnerTypeIterator<objecttype>::
 template <class objecttype>
 inline objecttype* ObjectOwnerTypeIterator<objecttype>::operator*()
 {
+	if (const std::vector<Relative*>* objects = this->objects())
+	return _position<objects->size() ? relativeCast<objecttype>((*objects)[_position], (objecttype*) 0) : 0;
 	return _iter==_containerRef->end() ? 0
 	: dynamic_cast<objecttype*>(*_iter);
 }
@@ -390,13 +534,17 @@ inline objecttype* ObjectOwnerTypeIterator<objecttype>::operator*()
 template <class objecttype>
 inline bool ObjectOwnerTypeIterator<objecttype>::operator==(const_iterator iter)
 {
+	// the walk of a type ends at the current end of the container, which
+	// moves when objects are created
+	if (const std::vector<Relative*>* objects = this->objects())
+	return _position<objects->size() ? false : iter==_containerRef->end();
 	return (_iter==iter);
 }
 
 template <class objecttype>
 inline bool ObjectOwnerTypeIterator<objecttype>::operator!=(const_iterator iter)
 {
-	return (_iter!=iter);
+	return !(*this==iter);
 }
 
 
@@ -35,6 +35,20 @@ public:
 	virtual ChunkWriter& getChunkWriter();
 		
 	void setCompressionMode(int compressionMode);
+
+	/// Stores the uncompressed size of each block, see ChunkWriter::setStoreUncompressedSize.
+	void setStoreUncompressedSize(bool store);
+
+	/// Selects zlib, LZ4 or Zstandard compression, see ChunkWriter::setCompression.
+	void setCompression(ChunkWriter::compressionAlgorithm algorithm, int level);
+
+	/// Sets a dictionary for Zstandard compression, see ChunkWriter::setZstdDictionary.
+	void setZstdDictionary(const std::string& dictionary);
+
+	/// Writes an index of all file sections next to the file when it is closed,
+	/// named as given by FileIndex::getIndexFileName. It is used by the
+	/// RandomAccessInputFile. Must be set before the first file section is written.
+	void setWriteIndex(bool write);
 	
 private:
 	
@@ -44,6 +58,9 @@ private:
 	
 	File _stream;
 	ChunkWriter _writer;
+	std::string _filename;
+	bool _writeIndex;
+	FileIndex _index;
 };
 
 }//namespace pxl
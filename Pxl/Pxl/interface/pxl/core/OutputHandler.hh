@@ -11,6 +11,8 @@
 #include "Pxl/Pxl/interface/pxl/core/macros.hh"
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "Pxl/Pxl/interface/pxl/core/ChunkWriter.hh"
 #include "Pxl/Pxl/interface/pxl/core/InformationChunk.hh"
@@ -40,6 +42,7 @@ public:
 	/// Queues the passed object for later writing to the output file.
 	void streamObject(const Serializable* obj)
 	{
+		getChunkWriter().markObject();
 		obj->serialize(getChunkWriter().getOutputStream());
 		_nObjects++;
 		if ((_maxSize>0 && getOutputStream().buffer.size() > _maxSize) || (_maxNObjects>0 &&_nObjects > _maxNObjects))
@@ -50,6 +53,14 @@ public:
 	/// A file section is finished if the given maximum section size is reached.
 	void writeEvent(const Event* event)
 	{
+		if (_packEvents)
+		{
+			streamObject(event);
+			return;
+		}
+		if (!_sectionInfoKeys.empty())
+			newEventSection(*event);
+		getChunkWriter().markObject();
 		event->serialize(getChunkWriter().getOutputStream());
 		_nObjects++;
 //		if ((_maxSize>0 && getOutputStream().getSize() > _maxSize) || (_maxNObjects>0 &&_nObjects > _maxNObjects))
@@ -63,6 +74,7 @@ public:
 	/// Writes the passed pxl::InformationChunk to the output file.
 	void writeInformationChunk(const InformationChunk* infoChunk)
 	{
+		getChunkWriter().markObject();
 		infoChunk->serialize(getChunkWriter().getOutputStream());
 		_nObjects++;
 //		if ((_maxSize>0 && getOutputStream().getSize() > _maxSize) || (_maxNObjects>0 &&_nObjects > _maxNObjects))
@@ -75,6 +87,7 @@ public:
 	/// Writes the passed pxl::BasicContainer to the output file.
 	void writeBasicContainer(const BasicContainer* basicContainer)
 	{
+		getChunkWriter().markObject();
 		basicContainer->serialize(getChunkWriter().getOutputStream());
 		_nObjects++;
 // 		if ((_maxSize>0 && getOutputStream().getSize() > _maxSize) || (_maxNObjects>0 &&_nObjects > _maxNObjects))
@@ -125,9 +138,43 @@ public:
 	{
 		return _maxSize;
 	}
+
+	/// Packs several events into one file section instead of writing a section
+	/// per event. Like for streamObject(), the section is finished once it holds
+	/// more than getMaxNObjects() objects or getMaxSize() bytes. This gives better
+	/// compression and fewer blocks to inflate for small events. Packed events
+	/// are read with InputHandler::readNextObject(), readEvent() only reads the
+	/// first event of each block.
+	void setPackEvents(bool pack)
+	{
+		_packEvents = pack;
+	}
+
+	bool getPackEvents() const
+	{
+		return _packEvents;
+	}
+
+	/// Writes the user records \p keys of each event, e.g. "Run", "LumiSection"
+	/// and "EventNum", into the info string of its file section as key=value
+	/// pairs (see SectionInfo). Readers can then select events by their section
+	/// headers without inflating them, see InputHandler::setSectionFilter.
+	/// Not applied to packed events, which share their section.
+	void setSectionInfoKeys(const std::vector<std::string>& keys)
+	{
+		_sectionInfoKeys = keys;
+	}
+
+	const std::vector<std::string>& getSectionInfoKeys() const
+	{
+		return _sectionInfoKeys;
+	}
 	
 
 private:
+	/// Starts the file section of \p event with the info built from the section info keys.
+	void newEventSection(const Event& event);
+
 	OutputHandler(const OutputHandler& original)
 	{
 	}
@@ -141,6 +188,8 @@ private:
 	bool _newFileSection;
 	size_t _maxNObjects;
 	size_t _nObjects;
+	bool _packEvents;
+	std::vector<std::string> _sectionInfoKeys;
 };
 
 }
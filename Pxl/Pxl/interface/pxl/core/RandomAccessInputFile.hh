@@ -9,17 +9,20 @@
 #ifndef PXL_IO_RANDOMACCESSINPUTFILE_HH
 #define PXL_IO_RANDOMACCESSINPUTFILE_HH
 
-#include <fstream>
 #include <stdexcept>
 
 #include "Pxl/Pxl/interface/pxl/core/InputFile.hh"
+#include "Pxl/Pxl/interface/pxl/core/FileIndex.hh"
 
 namespace pxl
 {
 // io
 /**
- This class offers an easy handling of the PXL I/O. Various methods to access
- the content of I/O files are offered.
+ This class offers an easy handling of the PXL I/O. In addition to the InputFile,
+ it jumps to any file section (event) or object directly using a FileIndex. The
+ index is read from the index file written by the OutputFile (see OutputFile::setWriteIndex).
+ For files without a matching index file, it is built once by scanning the section
+ headers, which skips the blocks without reading them.
  */
 class RandomAccessInputFile : public InputFile
 {
@@ -27,116 +30,136 @@ public:
 
 	RandomAccessInputFile() :
 		InputFile(),
-		_currentIndex(0),
-		_eventCount(0),
-		_knowEventCount(false)
+		_indexLoaded(false)
 	{
 	}
 
 	RandomAccessInputFile(const std::string& filename) :
 		InputFile(filename),
-		_currentIndex(0),
-		_eventCount(0),
-		_knowEventCount(false)
+		_filename(filename),
+		_indexLoaded(false)
 	{
 	}
 
-	~RandomAccessInputFile()
+	virtual void open(const std::string& filename)
 	{
-		close();
+		InputFile::open(filename);
+		_filename = filename;
+		_index.clear();
+		_indexLoaded = false;
 	}
 
-	void open(const std::string& filename)
+	virtual void close()
 	{
-		_currentIndex = 0;
-		_eventCount = 0;
-		_knowEventCount = false;
-		_filename = filename;
-		InputFile::open(filename);
+		InputFile::close();
+		_index.clear();
+		_indexLoaded = false;
 	}
 
-	void close()
+	/// Returns the index of the file sections, which is loaded or built on first use.
+	const FileIndex& getIndex()
 	{
-		InputFile::close();
-		_currentIndex = 0;
-		_eventCount = 0;
-		_knowEventCount = false;
+		if (!_indexLoaded)
+			loadIndex();
+		return _index;
 	}
 
-	void reopen()
+	/// Returns the number of file sections (events) in the file.
+	size_t getEventCount()
 	{
-		// safe variables to restore it after opening
-		unsigned int eventCount = _eventCount;
-		bool knowEventCount = _knowEventCount;
-
-		close();
-	
-		try {
-			open(_filename);
-		} catch (std::exception &e) {
-			return false;
-		}
+		return getIndex().size();
+	}
 
-		// restore event count information
-		_eventCount = eventCount;
-		_knowEventCount = knowEventCount;
+	/// Seeks to the desired file section (with 0 being the first file section).
+	bool seekToEvent(unsigned int event)
+	{
+		return seekToFileSection(event);
 	}
-	
-    bool seekToEvent(unsigned int event)
+
+	/// Seeks to the desired file section (with 0 being the first file section)
+	/// without reading the sections in between.
+	virtual bool seekToFileSection(int index)
 	{
-		// reopen the file if we need to go back
-		if (event < _currentIndex)
-		{
-			//reopen();
-		}
-		
-		int toSkip = event - _currentIndex;
-		int skipped = 0;
-	
-		// skip to the needed event
-		while (skipped < toSkip && _inputFile.skip())
-		{
-			skipped += 1;
-			_currentIndex += 1;
-		}
-		while (skipped > toSkip && _inputFile.previous())
-		{
-			skipped -= 1;
-			_currentIndex -1= 1;
-		}
+		const FileIndex& fileIndex = getIndex();
+		if (index < 0 || (size_t) index > fileIndex.size())
+			return false;
 
-		// update eventCount
-		if (skipped < toSkip)
-		{
-			_eventCount = _currentIndex;
-			_knowEventCount = true;
-		}
-		else if (_currentIndex >= _eventCount)
-		{
-			_eventCount = _currentIndex + 1;
-		}
+		int64_t position = (size_t) index < fileIndex.size() ?
+				fileIndex[index].offset : fileIndex.getFileSize();
+		return getChunkReader().seekSection(position, index);
+	}
 
-		if (toSkip == skipped)
-			return true;
-	
-		return false;
+	/// Seeks to the desired object like InputHandler::seekToObject(), but jumps
+	/// directly to its section and offset if the index holds the object offsets.
+	virtual Serializable* seekToObject(size_t index)
+	{
+		const FileIndex& fileIndex = getIndex();
+		if (index == 0 || !fileIndex.hasObjectOffsets())
+			return InputFile::seekToObject(index);
+
+		size_t section = 0;
+		uint32_t offset = 0;
+		if (!fileIndex.findObject(index - 1, section, offset))
+			return 0;
+		if (!seekToFileSection(section) || !getChunkReader().next()
+				|| !getChunkReader().skipSectionData(offset))
+			return 0;
+
+		setObjectCount(index - 1);
+		return readNextObject();
+	}
+
+	/// Writes the index next to the file, e.g. after it has been built for a
+	/// file without index file. Returns false if the file cannot be written.
+	bool writeIndex()
+	{
+		return getIndex().write(FileIndex::getIndexFileName(_filename));
 	}
 
 private:
-	RandomAccessInputFile(const RandomAccessInputFile& original)
+	RandomAccessInputFile(const RandomAccessInputFile& original) :
+		InputFile(), _indexLoaded(false)
 	{
 	}
-	
+
 	RandomAccessInputFile& operator= (const RandomAccessInputFile& other)
 	{
 		return *this;
-	}		
-		
-	unsigned long _currentIndex;
-	unsigned long _eventCount;
-	bool _knowEventCount;
+	}
+
+	void loadIndex()
+	{
+		_indexLoaded = true;
+
+		int64_t fileSize = getChunkReader().getSize();
+		if (_index.read(FileIndex::getIndexFileName(_filename))
+				&& _index.getFileSize() == fileSize)
+			return;
+
+		// Scan a second handle on the file, which leaves the position
+		// and any read-ahead of this file untouched.
+		_index.clear();
+		File file(_filename, OpenRead);
+		if (!file.isOpen())
+			throw std::runtime_error(
+					"pxl::RandomAccessInputFile::loadIndex(): cannot open "
+							+ _filename);
+		ChunkReader scanner(file);
+
+		int64_t begin = 0;
+		while (scanner.next())
+		{
+			scanner.skip();
+			int64_t end = scanner.getPosition();
+			_index.add(begin, end - begin, scanner.getSectionInfo());
+			begin = end;
+		}
+		_index.setFileSize(fileSize);
+	}
+
 	std::string _filename;
-	InputFile _inputFile;
+	FileIndex _index;
+	bool _indexLoaded;
 };
 
 } //namespace pxl
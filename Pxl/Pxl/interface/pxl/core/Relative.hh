@@ -15,6 +15,7 @@
 
 #include "Pxl/Pxl/interface/pxl/core/Serializable.hh"
 #include "Pxl/Pxl/interface/pxl/core/Id.hh"
+#include "Pxl/Pxl/interface/pxl/core/ObjectArena.hh"
 #include "Pxl/Pxl/interface/pxl/core/WkPtrBase.hh"
 #include "Pxl/Pxl/interface/pxl/core/Relations.hh"
 #include "Pxl/Pxl/interface/pxl/core/SoftRelations.hh"
@@ -37,6 +38,17 @@ public:
 	/// Destructor, ensures safe deletion of all hard relations.
 	virtual ~Relative();
 
+	/// Relatives are allocated in the current ObjectArena, if there is one.
+	static void* operator new(size_t size)
+	{
+		return ObjectArena::allocate(size);
+	}
+
+	static void operator delete(void* p)
+	{
+		ObjectArena::deallocate(p);
+	}
+
 	/// Returns the PXL unique object-id (UUID)
 	inline Id id() const
 	{
@@ -80,6 +92,16 @@ public:
 		in.readBool(hasLayout);
 	}
 
+	/// Reads past a serialized Relative without decoding it, see ObjectFactory::skip.
+	static void skipSerialized(const InputStream &in)
+	{
+		// uuid
+		in.skipRaw(16);
+		SoftRelations::skipSerialized(in);
+		in.skipString();
+		in.skipRaw(1);
+	}
+
 	/// Returns a C++ pointer to the pxl::ObjectOwner it is owned by.  
 	inline ObjectOwner* owner() const
 	{
@@ -232,6 +254,13 @@ protected:
 	{
 	}
 
+	/// Constructor for deserialization, see pxl::NoInit.
+	explicit Relative(const NoInit& tag) :
+	Serializable(tag), _refWkPtrSpec(0), _refObjectOwner(0),
+	_name("default")
+	{
+	}
+
 	/// Copy constructor. Relations are not copied.
 	Relative(const Relative& original) :
 	Serializable(), _refWkPtrSpec(0), _refObjectOwner(0),
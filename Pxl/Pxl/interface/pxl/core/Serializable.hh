@@ -33,6 +33,13 @@ public:
 	{
 	}
 
+	/// Constructor for objects filled by deserialize(), the UUID is not
+	/// generated.
+	explicit Serializable(const NoInit& tag) :
+		_id(tag)
+	{
+	}
+
 	/// Copy constructor. A copied object gets a new unique ID.
 	Serializable(const Serializable& original) : _id()
 	{
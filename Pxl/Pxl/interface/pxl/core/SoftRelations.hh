@@ -49,6 +49,9 @@ public:
 	/// Replaces the current content with the content of passed stream, which is read in.
 	void deserialize(const InputStream &in);
 
+	/// Reads past serialized soft relations without decoding them.
+	static void skipSerialized(const InputStream &in);
+
 	/// Returns the first Serializable pointer which is contained in the passed object owner \p owner
 	/// and which is contained in these soft relations. If the name of the soft relation \p type
 	/// is also passed, the first Serializable which has the soft relation of the according type is returned.
@@ -13,6 +13,8 @@
 #include <iostream>
 #include <stdexcept>
 #include <vector>
+#include <set>
+#include <algorithm>
 
 #include <string.h>
 
@@ -167,6 +169,24 @@ public:
 		write(&c, 1);
 	}
 
+	/// Writes the size and the elements of the numeric array \p a. On little
+	/// endian machines the elements are written as one block.
+	template<class T> void writeArray(const std::vector<T>& a) const
+	{
+		writeUnsignedInt(a.size());
+#ifdef PXL_BIG_ENDIAN
+		for (size_t i = 0; i < a.size(); i++)
+		{
+			T t = a[i];
+			swap_endianess(t);
+			write(&t, sizeof(t));
+		}
+#else
+		if (!a.empty())
+			write(&a[0], a.size() * sizeof(T));
+#endif
+	}
+
 };
 
 /**
@@ -212,6 +232,11 @@ class PXL_DLL_EXPORT InputStream
 {
 
 public:
+	InputStream() :
+			_cursor(0), _end(0), _deferContent(false), _lazyUserRecords(false)
+	{
+	}
+
 	virtual ~InputStream()
 	{
 	}
@@ -219,78 +244,155 @@ public:
 	virtual void read(void *data, size_t size) const = 0;
 	virtual bool good() const = 0;
 
+	/// Reads \p size bytes. Streams reading from memory (BufferInput) provide a
+	/// window on their data, which is read here without a virtual call.
+	void readRaw(void *data, size_t size) const
+	{
+		if (size <= (size_t) (_end - _cursor))
+		{
+			memcpy(data, _cursor, size);
+			_cursor += size;
+		}
+		else
+			read(data, size);
+	}
+
+	/// Skips \p size bytes.
+	void skipRaw(size_t size) const
+	{
+		if (size <= (size_t) (_end - _cursor))
+		{
+			_cursor += size;
+			return;
+		}
+		char buffer[1024];
+		while (size)
+		{
+			size_t count = std::min(sizeof(buffer), size);
+			read(buffer, count);
+			size -= count;
+		}
+	}
+
+	/// Skips a string written with OutputStream::writeString().
+	void skipString() const
+	{
+		unsigned int size = 0;
+		readUnsignedInt(size);
+		skipRaw(size);
+	}
+
+	/// Returns the position in memory of the next byte to be read, or 0 if
+	/// the stream does not read from memory.
+	const char *getCursor() const
+	{
+		return _cursor;
+	}
+
+	/// Object managers (e.g. EventViews) read from this stream keep their content
+	/// serialized until it is first accessed, except those named in \p eager.
+	/// This saves decoding content that is never looked at. Requires a stream
+	/// reading from memory.
+	void setDeferredContent(bool defer,
+			const std::set<std::string>& eager = std::set<std::string>())
+	{
+		_deferContent = defer;
+		_eagerContent = eager;
+	}
+
+	/// Returns true if the content of the object manager \p name is to be deferred.
+	bool isContentDeferred(const std::string& name) const
+	{
+		return _deferContent && _eagerContent.find(name) == _eagerContent.end();
+	}
+
+	/// User records read from this stream keep their values serialized and
+	/// decode each of them when it is first accessed, see UserRecords. This
+	/// saves decoding the many records an analysis never reads. Requires a
+	/// stream reading from memory.
+	void setLazyUserRecords(bool lazy)
+	{
+		_lazyUserRecords = lazy;
+	}
+
+	/// Returns true if user records are to be decoded on first access.
+	bool hasLazyUserRecords() const
+	{
+		return _lazyUserRecords;
+	}
+
 	void read(char& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 	}
 
 	void read(unsigned char& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 	}
 
 	void read(int16_t& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void read(uint16_t& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void read(int32_t& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void read(uint32_t& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void read(int64_t& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void read(uint64_t& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void readChar(char& c) const
 	{
-		read(&c, sizeof(c));
+		readRaw(&c, sizeof(c));
 	}
 
 	void readUnsignedChar(unsigned char& c) const
 	{
-		read(&c, sizeof(c));
+		readRaw(&c, sizeof(c));
 	}
 
 	void readInt(int& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void readUnsignedInt(unsigned int& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void readLong(long& l) const
 	{
 		int i;
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 		l = i;
 	}
@@ -298,27 +400,27 @@ public:
 	void readUnsignedLong(unsigned long& l) const
 	{
 		unsigned int i;
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 		l = i;
 	}
 
 	void readShort(short& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void readUnsignedShort(unsigned short& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void readBool(bool& b) const
 	{
 		char c;
-		read(&c, sizeof(c));
+		readRaw(&c, sizeof(c));
 		b = (c != 0);
 	}
 
@@ -326,13 +428,19 @@ public:
 	{
 		unsigned int size = 0;
 		readUnsignedInt(size);
+		if (size <= (size_t) (_end - _cursor))
+		{
+			s.assign(_cursor, size);
+			_cursor += size;
+			return;
+		}
 		s.clear();
 		s.reserve(size);
 		std::string::value_type buffer[1024];
 		while (size)
 		{
 			size_t count = std::min(1024u, size);
-			read(buffer, count);
+			readRaw(buffer, count);
 			s.append(buffer, count);
 			size -= count;
 		}
@@ -340,40 +448,134 @@ public:
 
 	void readFloat(float& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
 
 	void readDouble(double& i) const
 	{
-		read(&i, sizeof(i));
+		readRaw(&i, sizeof(i));
 		swap_endianess(i);
 	}
+
+	/// Reads a numeric array written with OutputStream::writeArray().
+	template<class T> void readArray(std::vector<T>& a) const
+	{
+		unsigned int size = 0;
+		readUnsignedInt(size);
+		a.resize(size);
+		if (size)
+			readRaw(&a[0], size * sizeof(T));
+#ifdef PXL_BIG_ENDIAN
+		for (size_t i = 0; i < a.size(); i++)
+			swap_endianess(a[i]);
+#endif
+	}
+
+	/// Skips a numeric array of elements of \p elementSize bytes written with
+	/// OutputStream::writeArray().
+	void skipArray(size_t elementSize) const
+	{
+		unsigned int size = 0;
+		readUnsignedInt(size);
+		skipRaw(size * elementSize);
+	}
+
+protected:
+	/// Unread part of the data of streams reading from memory, empty otherwise.
+	mutable const char *_cursor;
+	mutable const char *_end;
+
+private:
+	bool _deferContent;
+	std::set<std::string> _eagerContent;
+	bool _lazyUserRecords;
 };
 
 // iotl
 /**
  This class serves the internal PXL I/O scheme by implementing how basic C++ types
- are read from an input buffer.
+ are read from an input buffer. After the first read, the unread data is exposed
+ to the InputStream helpers, which then read it without virtual calls. Therefore
+ clear() must be called before the buffer is filled again.
  */
 class PXL_DLL_EXPORT BufferInput: public InputStream
 {
+	/// Read position, not including the reads through the InputStream window.
 	mutable size_t _readPosition;
 
+	/// External data which is read instead of the buffer, if set.
+	const char *_view;
+	size_t _viewSize;
+
+	/// Takes over the reads done through the window.
+	void sync() const
+	{
+		if (_cursor)
+			_readPosition = _cursor - data();
+	}
+
+	/// Exposes the unread data to the InputStream helpers.
+	void openWindow() const
+	{
+		_cursor = data() + _readPosition;
+		_end = data() + size();
+	}
+
 public:
 
 	std::vector<char> buffer;
 
 	BufferInput() :
-			_readPosition(0)
+			_readPosition(0), _view(0), _viewSize(0)
+	{
+
+	}
+
+	/// Copies the unread data, the window is reopened by the next read.
+	BufferInput(const BufferInput& original) :
+			InputStream(), _readPosition(0), _view(original._view),
+			_viewSize(original._viewSize), buffer(original.buffer)
 	{
+		original.sync();
+		_readPosition = original._readPosition;
+	}
 
+	BufferInput& operator=(const BufferInput& other)
+	{
+		if (this != &other)
+		{
+			other.sync();
+			buffer = other.buffer;
+			_view = other._view;
+			_viewSize = other._viewSize;
+			_readPosition = other._readPosition;
+			_cursor = 0;
+			_end = 0;
+		}
+		return *this;
 	}
 
 	void clear()
 	{
 		buffer.clear();
 		_readPosition = 0;
+		_view = 0;
+		_viewSize = 0;
+		_cursor = 0;
+		_end = 0;
+	}
+
+	/// Reads from the passed memory instead of the internal buffer, which
+	/// avoids copying data that is already in memory (e.g. memory mapped files).
+	/// The memory must stay valid until clear() or setView() is called again.
+	void setView(const char *data, size_t size)
+	{
+		buffer.clear();
+		_readPosition = 0;
+		_view = data;
+		_viewSize = size;
+		openWindow();
 	}
 
 	bool good() const
@@ -382,9 +584,22 @@ public:
 		return (av > 0);
 	}
 
+	size_t size() const
+	{
+		return _view ? _viewSize : buffer.size();
+	}
+
+	const char *data() const
+	{
+		if (_view)
+			return _view;
+		return buffer.empty() ? 0 : &buffer[0];
+	}
+
 	size_t available() const
 	{
-		return (buffer.size() - _readPosition);
+		sync();
+		return (size() - _readPosition);
 	}
 
 	void read(void *data, size_t size) const
@@ -392,8 +607,19 @@ public:
 		if (available() < size)
 			throw std::runtime_error("buffer underrun!");
 
-		memcpy(data, &buffer[_readPosition], size);
+		memcpy(data, this->data() + _readPosition, size);
+		_readPosition += size;
+		openWindow();
+	}
+
+	/// Skips \p size bytes.
+	void skip(size_t size) const
+	{
+		if (available() < size)
+			throw std::runtime_error("buffer underrun!");
+
 		_readPosition += size;
+		openWindow();
 	}
 };
 
@@ -11,13 +11,14 @@
 #include "Pxl/Pxl/interface/pxl/core/macros.hh"
 
 #include <string>
-#include <map>
+#include <vector>
 #include <stdexcept>
 #include <sstream>
 
 #include "Pxl/Pxl/interface/pxl/core/Variant.hh"
 #include "Pxl/Pxl/interface/pxl/core/Stream.hh"
 #include "Pxl/Pxl/interface/pxl/core/Id.hh"
+#include "Pxl/Pxl/interface/pxl/core/UserRecordKeys.hh"
 
 namespace pxl
 {
@@ -26,6 +27,10 @@ namespace pxl
  of string-variant pairs.
  All PXL physics objects own user records and provide methods for quick
  access to individual user record entries.
+ The keys are stored as numbers of the process-wide pxl::UserRecordKeys table,
+ next to the values in a small array which is ordered by the key strings, so
+ that looking up a record compares numbers instead of strings. Copies share
+ the records until one of them is changed (copy-on-write).
  */
 class PXL_DLL_EXPORT UserRecords
 {
@@ -39,11 +44,15 @@ private:
 		{
 		}
 		DataSocket(const DataSocket& original) :
-			_references(1), _data(original._data)
+			_references(1), _keys(original._keys), _values(original._values),
+					_index(original._index), _serialized(original._serialized),
+					_offsets(original._offsets)
 		{
 		}
 		DataSocket(const DataSocket* original) :
-			_references(1), _data(original->_data)
+			_references(1), _keys(original->_keys), _values(original->_values),
+					_index(original->_index), _serialized(original->_serialized),
+					_offsets(original->_offsets)
 		{
 		}
 		virtual ~DataSocket()
@@ -56,25 +65,152 @@ private:
 			return new DataSocket(this);
 		}
 
-		// methods to grant data access
-		inline std::map<std::string, Variant>* getData()
+		/// Returns the position of the record \p key, or size() if there is none.
+		size_t position(uint32_t key) const
 		{
-			return &_data;
+			size_t size = _keys.size();
+			if (_index.empty())
+			{
+				for (size_t i = 0; i < size; i++)
+					if (_keys[i] == key)
+						return i;
+				return size;
+			}
+			size_t mask = _index.size() - 1;
+			for (size_t slot = indexSlot(key) & mask; _index[slot] != 0; slot
+					= (slot + 1) & mask)
+				if (_keys[_index[slot] - 1] == key)
+					return _index[slot] - 1;
+			return size;
 		}
-		inline void setData(const std::map<std::string, Variant>* object)
+
+		/// Returns the value at \p pos, which is decoded first if it is still
+		/// serialized.
+		const Variant& value(size_t pos) const
+		{
+			if (!_offsets.empty() && _offsets[pos] != _decoded)
+				decode(pos);
+			return _values[pos];
+		}
+
+		/// Decodes the value at \p pos from _serialized.
+		void decode(size_t pos) const;
+
+		/// Decodes all values still serialized and drops the serialized data.
+		void decodeAll();
+
+		/// Rebuilds the index after records were inserted or removed.
+		void reindex();
+
+		/// Updates the index after the record at \p pos was inserted.
+		void reindexInserted(size_t pos);
+
+		static uint32_t indexSlot(uint32_t key)
 		{
-			_data = *object;
+			return key * 2654435769u;
 		}
 
 		unsigned int _references;
-		std::map<std::string, Variant> _data;
+		/// Numbers of the keys, ordered by the key strings.
+		std::vector<uint32_t> _keys;
+		/// Values at the same positions as their keys.
+		std::vector<Variant> _values;
+		/// Hash table of the positions + 1 of the keys, only used for larger
+		/// records, where it is faster than searching through the keys.
+		std::vector<uint32_t> _index;
+		/// The records as read, if they are decoded lazily (see
+		/// InputStream::setLazyUserRecords), until they are changed.
+		std::vector<char> _serialized;
+		/// Offsets in _serialized of the type codes of the values, or _decoded
+		/// for values already decoded. Empty if all values are decoded.
+		std::vector<uint32_t> _offsets;
+		static const uint32_t _decoded = 0xffffffff;
 
 	}; //class Datasocket
 
 public:
-	typedef std::map<std::string, Variant> map_type;
-	typedef map_type::const_iterator const_iterator;
-	typedef map_type::iterator iterator;
+
+	/// A record as seen through const_iterator.
+	struct Record
+	{
+		Record(const std::string& key, const Variant& value) :
+			first(key), second(value)
+		{
+		}
+
+		const std::string& first;
+		const Variant& second;
+	};
+
+	/// Iterates over the records in the order of their keys.
+	class const_iterator
+	{
+	public:
+		class Pointer
+		{
+		public:
+			Pointer(const Record& record) :
+				_record(record)
+			{
+			}
+
+			const Record* operator->() const
+			{
+				return &_record;
+			}
+
+		private:
+			Record _record;
+		};
+
+		const_iterator() :
+			_socket(0), _position(0)
+		{
+		}
+
+		const_iterator(const DataSocket* socket, size_t position) :
+			_socket(socket), _position(position)
+		{
+		}
+
+		Record operator*() const
+		{
+			return Record(UserRecordKeys::getName(_socket->_keys[_position]),
+					_socket->value(_position));
+		}
+
+		Pointer operator->() const
+		{
+			return Pointer(**this);
+		}
+
+		const_iterator& operator++()
+		{
+			_position++;
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator original = *this;
+			_position++;
+			return original;
+		}
+
+		bool operator==(const const_iterator& other) const
+		{
+			return _position == other._position && _socket == other._socket;
+		}
+
+		bool operator!=(const const_iterator& other) const
+		{
+			return !(*this == other);
+		}
+
+	private:
+		const DataSocket* _socket;
+		size_t _position;
+	};
 
 	UserRecords()
 	{
@@ -96,57 +232,85 @@ public:
 	}
 
 	void serialize(const OutputStream &out) const;
+
+	/// Reads the records. If the stream has lazy user records enabled (see
+	/// InputStream::setLazyUserRecords), the values are kept serialized and
+	/// each of them is decoded when it is first read; they are all decoded
+	/// before the records are changed. Like deferred object managers, records
+	/// read lazily and shared by copies must not be read from several threads.
 	void deserialize(const InputStream &in);
 
+	/// Reads past serialized user records without decoding them.
+	static void skipSerialized(const InputStream &in);
+
 	/// This assignment operator acts directly on the aggregated data.
 	inline UserRecords& operator=(const UserRecords& original)
 	{
+		original._dataSocket->_references++;
 		dropDataSocket();
 		_dataSocket = original._dataSocket;
-		_dataSocket->_references++;
 		return *this;
 	}
 
 	/// Inserts (or replaces) the user record indetified by \p key.
 	void set(const std::string& key, const Variant& item)
 	{
-		findOrAlloc(key) = item;
+		set(UserRecordKeys::intern(key), item);
+	}
+
+	void set(const UserRecordKey& key, const Variant& item)
+	{
+		set(key.getId(), item);
 	}
 
 	/// Searches and returns the user record item indetified by \p key; a pxl::Exception is thrown in case the key is not found.
 	const Variant &get(const std::string& key) const
 	{
-		const Variant* value = find(key);
-		if (!value)
+		uint32_t id;
+		if (!UserRecordKeys::lookup(key, id))
 			throw std::runtime_error("pxl::UserRecord::get(...): key '" + key
 					+ "' not found");
-		return *value;
+		return get(id);
+	}
+
+	const Variant &get(const UserRecordKey& key) const
+	{
+		return get(key.getId());
 	}
 
 	/// find the user record entry identified by key. return 0 when no entry is found.
+	/// The pointer is valid until records are inserted or removed.
 	Variant* find(const std::string &key)
 	{
-		iterator found = setContainer()->find(key);
-		if (found == setContainer()->end())
-			return 0;
-		return &found->second;
+		uint32_t id;
+		return UserRecordKeys::lookup(key, id) ? find(id) : 0;
 	}
 
 	const Variant* find(const std::string &key) const
 	{
-		const_iterator found = getContainer()->find(key);
-		if (found == getContainer()->end())
-			return 0;
-		return &found->second;
+		uint32_t id;
+		return UserRecordKeys::lookup(key, id) ? find(id) : 0;
+	}
+
+	Variant* find(const UserRecordKey& key)
+	{
+		return find(key.getId());
+	}
+
+	const Variant* find(const UserRecordKey& key) const
+	{
+		return find(key.getId());
 	}
 
 	/// Checks if the user record entry identified by key is present.
 	bool has(const std::string& key) const
 	{
-		const_iterator found = getContainer()->find(key);
-		if (found == getContainer()->end())
-			return false;
-		return true;
+		return find(key) != 0;
+	}
+
+	bool has(const UserRecordKey& key) const
+	{
+		return find(key) != 0;
 	}
 
 	/// Checks if user record entry identified by \p key is present.
@@ -160,57 +324,70 @@ public:
 		return true;
 	}
 
+	template<typename datatype> bool get(const UserRecordKey& key, datatype& item) const
+	{
+		const Variant* value = find(key);
+		if (!value)
+			return false;
+		item = value->to<datatype>();
+		return true;
+	}
+
 	/// Checks if a user record entry identified by \p key is present,
 	/// and changes it to the passed value in case it is present. If not, an exception is thrown.
 	template<typename datatype> void change(const std::string& key,
 			datatype item)
 	{
-		iterator found = setContainer()->find(key);
-		if (found == getContainer()->end())
+		Variant* value = find(key);
+		if (!value)
 			throw std::runtime_error(
 					"pxl::UserRecord::change(...): UserRecord entry '" + key
 							+ "' not found");
 
-		Variant& value = found->second;
-		if (value.getTypeInfo() != typeid(datatype))
+		if (value->getTypeInfo() != typeid(datatype))
 			throw std::runtime_error(
 					"pxl::UserRecord::change(...): UserRecord entry '" + key
 							+ "' of wrong type");
 
-		value = item;
+		*value = item;
 	}
 
 	inline void clear()
 	{
-		setContainer()->clear();
+		DataSocket* socket = detachSocket();
+		socket->_keys.clear();
+		socket->_values.clear();
+		socket->_index.clear();
+		socket->_serialized.clear();
+		socket->_offsets.clear();
 	}
 
-	inline void erase(const std::string& key)
+	void erase(const std::string& key)
 	{
-		size_t s = setContainer()->erase(key);
-    if (s == 0)
-      throw std::runtime_error("Cannot erase unknown key: "+key);
+		uint32_t id;
+		if (!UserRecordKeys::lookup(key, id))
+			throw std::runtime_error("Cannot erase unknown key: " + key);
+		erase(id);
 	}
 
-	/// Grants read access to the aggregated data.
-	inline const std::map<std::string, Variant>* getContainer() const
+	void erase(const UserRecordKey& key)
 	{
-		return _dataSocket->getData();
+		erase(key.getId());
 	}
 
 	inline const_iterator begin() const
 	{
-		return getContainer()->begin();
+		return const_iterator(_dataSocket, 0);
 	}
 
 	inline const_iterator end() const
 	{
-		return getContainer()->end();
+		return const_iterator(_dataSocket, _dataSocket->_keys.size());
 	}
 
 	inline size_t size() const
 	{
-		return getContainer()->size();
+		return _dataSocket->_keys.size();
 	}
 
 	std::ostream
@@ -227,14 +404,24 @@ private:
 
 	/// Grants write access to the aggregated data;
 	/// if necessary, the copy-on-write mechanism performs a deep copy of the aggregated data first.
-	inline std::map<std::string, Variant>* setContainer()
+	/// Lazily read records are decoded, as they are about to change.
+	inline DataSocket* setSocket()
+	{
+		DataSocket* socket = detachSocket();
+		if (!socket->_offsets.empty())
+			socket->decodeAll();
+		return socket;
+	}
+
+	/// Like setSocket(), but leaves lazily read records serialized.
+	inline DataSocket* detachSocket()
 	{
 		if (_dataSocket->_references > 1)
 		{
 			_dataSocket->_references--;
 			_dataSocket = new DataSocket(*_dataSocket);
 		}
-		return _dataSocket->getData();
+		return _dataSocket;
 	}
 
 	inline void dropDataSocket()
@@ -243,23 +430,44 @@ private:
 			delete _dataSocket;
 	}
 
-	Variant& findOrAlloc(const std::string &key)
+	void set(uint32_t key, const Variant& item);
+
+	void erase(uint32_t key);
+
+	const Variant& get(uint32_t key) const
 	{
-		iterator insertPos = setContainer()->lower_bound(key);
-		if (insertPos == getContainer()->end() || insertPos->first != key)
-			return setContainer()->insert(insertPos, make_pair(key, Variant()))->second;
-		else
-			return insertPos->second;
+		const Variant* value = find(key);
+		if (!value)
+			throw std::runtime_error("pxl::UserRecord::get(...): key '"
+					+ UserRecordKeys::getName(key) + "' not found");
+		return *value;
 	}
 
-	Variant& setFast(iterator insertPos, const std::string &key,
-			const Variant& item)
+	Variant* find(uint32_t key)
 	{
-		Variant &v = setContainer()->insert(insertPos,
-				make_pair(key, Variant()))->second;
-		v = item;
-		return v;
+		size_t pos = _dataSocket->position(key);
+		if (pos == _dataSocket->_keys.size())
+			return 0;
+		return &setSocket()->_values[pos];
 	}
+
+	const Variant* find(uint32_t key) const
+	{
+		size_t pos = _dataSocket->position(key);
+		if (pos == _dataSocket->_keys.size())
+			return 0;
+		return &_dataSocket->value(pos);
+	}
+
+	/// Inserts the record \p key, which is not present yet, at the position
+	/// given by the order of the keys.
+	void insert(uint32_t key, const std::string& name, const Variant& item);
+
+	/// Reads \p size records, decoding the values.
+	void readRecords(const InputStream &in, unsigned int size);
+
+	/// Reads \p size records, keeping the values serialized.
+	void readRecordsLazily(const InputStream &in, unsigned int size);
 };
 
 class PXL_DLL_EXPORT UserRecordHelper
@@ -290,6 +498,11 @@ public:
 		_userRecords.erase(key);
 	}
 
+	void eraseUserRecord(const UserRecordKey& key)
+	{
+		_userRecords.erase(key);
+	}
+
 	const Variant &getUserRecord(const std::string& key) const
 
 	{
@@ -316,6 +529,33 @@ public:
 		return _userRecords.has(key);
 	}
 
+	inline void setUserRecord(const UserRecordKey& key, const Variant& value)
+	{
+		_userRecords.set(key, value);
+	}
+
+	const Variant &getUserRecord(const UserRecordKey& key) const
+	{
+		return _userRecords.get(key);
+	}
+
+	const Variant &getUserRecord_def(const UserRecordKey& key, const Variant& item) const
+	{
+		const Variant* value = _userRecords.find(key);
+		return value ? *value : item;
+	}
+
+	template<typename datatype> bool getUserRecord(const UserRecordKey& key,
+			datatype& item) const
+	{
+		return _userRecords.template get<datatype> (key, item);
+	}
+
+	inline bool hasUserRecord(const UserRecordKey& key) const
+	{
+		return _userRecords.has(key);
+	}
+
 	void serialize(const OutputStream &out) const
 	{
 		_userRecords.serialize(out);
@@ -326,6 +566,12 @@ public:
 		_userRecords.deserialize(in);
 	}
 
+	/// Reads past serialized user records without decoding them.
+	static void skipSerialized(const InputStream &in)
+	{
+		UserRecords::skipSerialized(in);
+	}
+
 private:
 	UserRecords _userRecords;
 };
@@ -0,0 +1,107 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#ifndef PXL_BASE_USER_RECORD_KEYS_HH
+#define PXL_BASE_USER_RECORD_KEYS_HH
+
+#include "Pxl/Pxl/interface/pxl/core/macros.hh"
+
+#include <string>
+#include <stdint.h>
+
+namespace pxl
+{
+
+/**
+ Process-wide table of the keys of the user records. Each distinct key is
+ stored once and identified by a number, so that UserRecords only keep the
+ numbers and compare them instead of the strings. Keys are never removed.
+ The table may be used from several threads; each thread looks keys up in a
+ cache of its own and only locks the table for keys new to the thread. Keys
+ not in the table are cached too, until a key is added.
+ */
+class PXL_DLL_EXPORT UserRecordKeys
+{
+public:
+
+	/// Returns the number of \p key, which is added to the table if needed.
+	static uint32_t intern(const std::string& key);
+
+	/// Puts the number of \p key into \p id and returns true if the key is in
+	/// the table. Unlike intern(), unknown keys are not added, so that
+	/// looking up records does not fill the table.
+	static bool lookup(const std::string& key, uint32_t& id);
+
+	/// Returns the key with the number \p id, which must have been returned
+	/// by intern().
+	static const std::string& getName(uint32_t id)
+	{
+		return _chunks[id >> _chunkBits][id & (_chunkSize - 1)];
+	}
+
+	/// Returns the number of keys in the table.
+	static uint32_t size();
+
+private:
+
+	static const uint32_t _chunkBits = 10;
+	static const uint32_t _chunkSize = 1 << _chunkBits;
+	static const uint32_t _maxChunks = 4096;
+
+	/// The names, in chunks which are never moved, so that getName() needs
+	/// no lock.
+	static std::string* _chunks[_maxChunks];
+};
+
+/**
+ Key of a user record, resolved in the UserRecordKeys table once when it is
+ constructed. Code accessing the same records for every event (selectors,
+ cuts) keeps such keys as members instead of passing strings, so that the
+ lookups neither build nor hash strings.
+ */
+class PXL_DLL_EXPORT UserRecordKey
+{
+public:
+
+	explicit UserRecordKey(const std::string& name) :
+		_id(UserRecordKeys::intern(name))
+	{
+	}
+
+	explicit UserRecordKey(const char* name) :
+		_id(UserRecordKeys::intern(name))
+	{
+	}
+
+	uint32_t getId() const
+	{
+		return _id;
+	}
+
+	const std::string& getName() const
+	{
+		return UserRecordKeys::getName(_id);
+	}
+
+	bool operator==(const UserRecordKey& other) const
+	{
+		return _id == other._id;
+	}
+
+	bool operator!=(const UserRecordKey& other) const
+	{
+		return _id != other._id;
+	}
+
+private:
+	uint32_t _id;
+};
+
+} // namespace pxl
+
+#endif // PXL_BASE_USER_RECORD_KEYS_HH
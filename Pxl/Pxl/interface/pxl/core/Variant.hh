@@ -25,6 +25,9 @@
 #include <limits>
 #include <stdint.h>
 #include <map>
+#include <new>
+#include <vector>
+#include <algorithm>
 
 #define VARIANT_ADD_TYPE_DECL_POD(NAME, TYPE, VALUE) \
 	bool is ## NAME() const { return (type == TYPE); } \
@@ -51,6 +54,16 @@
 	Variant &operator =(const VALUE &a) { if (type != TYPE) { clear(); data.__##NAME = new VALUE; } type = TYPE; (*data.__##NAME) = a; return *this; } \
 	Variant(const VALUE &a) { data.__ ## NAME = new VALUE(a); type = TYPE; }
 
+#define VARIANT_ADD_TYPE_DECL_INLINE(NAME, TYPE, VALUE) \
+	bool operator != (const VALUE &a) const { check(TYPE); return *inline ## NAME() != a; } \
+	bool operator == (const VALUE &a) const { check(TYPE); return *inline ## NAME() == a; } \
+	bool is ## NAME() const { return (type == TYPE); } \
+	VALUE &as ## NAME() { check(TYPE); return *inline ## NAME(); } \
+	const VALUE &as ## NAME() const	{ check(TYPE); return *inline ## NAME(); } \
+	static Variant from ## NAME(const VALUE &a) { return Variant(a); } \
+	Variant &operator =(const VALUE &a) { if (type != TYPE) { clear(); new (data.__buffer) VALUE; type = TYPE; } *inline ## NAME() = a; return *this; } \
+	Variant(const VALUE &a) { new (data.__buffer) VALUE(a); type = TYPE; }
+
 namespace pxl
 {
 
@@ -75,7 +88,10 @@ public:
 		TYPE_SERIALIZABLE,
 		TYPE_BASIC3VECTOR,
 		TYPE_LORENTZVECTOR,
-		TYPE_VECTOR
+		TYPE_VECTOR,
+		TYPE_FLOAT_ARRAY,
+		TYPE_DOUBLE_ARRAY,
+		TYPE_INT32_ARRAY
 	};
 
 	class bad_conversion: public std::exception
@@ -132,7 +148,8 @@ public:
 
 	Variant &operator =(const Variant &a)
 	{
-		copy(a);
+		if (this != &a)
+			copy(a);
 		return *this;
 	}
 
@@ -163,11 +180,11 @@ public:
 
 	VARIANT_ADD_TYPE_DECL_POD(Double, TYPE_DOUBLE, double)
 
-	VARIANT_ADD_TYPE_DECL_PTR(Basic3Vector, TYPE_BASIC3VECTOR, Basic3Vector)
+	VARIANT_ADD_TYPE_DECL_INLINE(Basic3Vector, TYPE_BASIC3VECTOR, Basic3Vector)
 
-	VARIANT_ADD_TYPE_DECL_PTR(LorentzVector, TYPE_LORENTZVECTOR, LorentzVector)
+	VARIANT_ADD_TYPE_DECL_INLINE(LorentzVector, TYPE_LORENTZVECTOR, LorentzVector)
 
-	VARIANT_ADD_TYPE_DECL_PTR(String, TYPE_STRING, std::string)
+	VARIANT_ADD_TYPE_DECL_INLINE(String, TYPE_STRING, std::string)
 	Variant(const char *s);
 	std::string toString() const;
 	static Variant fromString(const std::string &str, Type type);
@@ -178,7 +195,7 @@ public:
 	bool operator !=(const char *a) const
 	{
 		check(TYPE_STRING);
-		return data.__String->compare(a) != 0;
+		return inlineString()->compare(a) != 0;
 	}
 
 	// serializable
@@ -239,6 +256,18 @@ public:
 	const Variant &operator[](size_t i) const;
 	void resize(size_t i);
 
+	// numeric arrays, stored contiguously, e.g. per event weights
+	VARIANT_ADD_TYPE_DECL_PTR(FloatArray, TYPE_FLOAT_ARRAY, std::vector<float>)
+
+	VARIANT_ADD_TYPE_DECL_PTR(DoubleArray, TYPE_DOUBLE_ARRAY, std::vector<double>)
+
+	VARIANT_ADD_TYPE_DECL_PTR(Int32Array, TYPE_INT32_ARRAY, std::vector<int32_t>)
+
+	/// Exchanges the values of this and \p other. Strings, vectors and
+	/// serializables are handed over, not copied, so this is the cheap way to
+	/// pass a Variant on which is not needed anymore.
+	void swap(Variant &other);
+
 	// io
 	void serialize(const OutputStream &out) const;
 	void deserialize(const InputStream &in);
@@ -263,14 +292,56 @@ protected:
 		double __Double;
 		float __Float;
 		Serializable *__Serializable;
-		Basic3Vector *__Basic3Vector;
-		LorentzVector *__LorentzVector;
 		vector_t *__vec;
-		std::string *__String;
+		std::vector<float> *__FloatArray;
+		std::vector<double> *__DoubleArray;
+		std::vector<int32_t> *__Int32Array;
+		/// Strings, Basic3Vectors and LorentzVectors are constructed in
+		/// place here instead of on the heap.
+		char __buffer[sizeof(LorentzVector) > sizeof(std::string) ?
+				sizeof(LorentzVector) : sizeof(std::string)];
 	} data;
 
+	std::string *inlineString()
+	{
+		return reinterpret_cast<std::string*>(data.__buffer);
+	}
+
+	const std::string *inlineString() const
+	{
+		return reinterpret_cast<const std::string*>(data.__buffer);
+	}
+
+	Basic3Vector *inlineBasic3Vector()
+	{
+		return reinterpret_cast<Basic3Vector*>(data.__buffer);
+	}
+
+	const Basic3Vector *inlineBasic3Vector() const
+	{
+		return reinterpret_cast<const Basic3Vector*>(data.__buffer);
+	}
+
+	LorentzVector *inlineLorentzVector()
+	{
+		return reinterpret_cast<LorentzVector*>(data.__buffer);
+	}
+
+	const LorentzVector *inlineLorentzVector() const
+	{
+		return reinterpret_cast<const LorentzVector*>(data.__buffer);
+	}
+
 private:
+	/// Returns true for the types stored in data.__buffer.
+	static bool isInline(Type t)
+	{
+		return t == TYPE_STRING || t == TYPE_BASIC3VECTOR
+				|| t == TYPE_LORENTZVECTOR;
+	}
+
 	void copy(const Variant &a);
+	void moveFrom(Variant &a);
 	void check(const Type t) const;
 	void check(const Type t);
 };
@@ -291,8 +362,25 @@ VARIANT_TO_DECL(Float, float)
 VARIANT_TO_DECL(String, std::string)
 VARIANT_TO_DECL(Double, double)
 
+#define VARIANT_TO_DECL_ARRAY(NAME, VALUE) \
+	template<> inline VALUE Variant::to<VALUE>() const { return as ## NAME(); } \
+
+VARIANT_TO_DECL_ARRAY(FloatArray, std::vector<float>)
+VARIANT_TO_DECL_ARRAY(DoubleArray, std::vector<double>)
+VARIANT_TO_DECL_ARRAY(Int32Array, std::vector<int32_t>)
+
 PXL_DLL_EXPORT std::ostream& operator <<(std::ostream& os, const Variant &v);
 
 } // namespace pxl
 
+namespace std
+{
+
+template<> inline void swap(pxl::Variant &a, pxl::Variant &b)
+{
+	a.swap(b);
+}
+
+} // namespace std
+
 #endif // PXL_BASE_VARIANT_HH
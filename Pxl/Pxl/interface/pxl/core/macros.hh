@@ -25,6 +25,13 @@
 #	define PXL_UNLIKELY(expr)	(expr)
 #endif
 
+#undef PXL_THREAD_LOCAL
+#if defined(_MSC_VER)
+#	define PXL_THREAD_LOCAL		__declspec(thread)
+#else
+#	define PXL_THREAD_LOCAL		__thread
+#endif
+
 #ifdef offsetof
 #	define PXL_OFFSETOF(t, f)	((std::ptrdiff_t)offsetof(t, f))
 #else
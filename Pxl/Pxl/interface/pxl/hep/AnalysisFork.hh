@@ -31,6 +31,10 @@ public:
 		ObjectManager()
 	{
 	}
+	explicit AnalysisFork(const NoInit& tag) :
+		ObjectManager(tag)
+	{
+	}
 	AnalysisFork(const AnalysisFork& original) :
 		ObjectManager(original)
 	{
@@ -35,6 +35,10 @@ public:
 		ObjectManager()
 	{
 	}
+	explicit AnalysisProcess(const NoInit& tag) :
+		ObjectManager(tag)
+	{
+	}
 	AnalysisProcess(const AnalysisProcess& original) :
 		ObjectManager(original)
 	{
@@ -28,6 +28,10 @@ public:
 		Object()
 	{
 	}
+	explicit Collision(const NoInit& tag) :
+		Object(tag)
+	{
+	}
 	/// This copy constructor provides a deep copy of the event container \p original with all data members,
 	/// hep objects, and their (redirected) relations.
 	Collision(const Collision& original) :
@@ -46,6 +46,10 @@ public:
 		ObjectManager()
 	{
 	}
+	explicit EventView(const NoInit& tag) :
+		ObjectManager(tag)
+	{
+	}
 	/// This copy constructor provides a deep copy of the event container \p original with all data members, 
 	/// hep objects, and their (redirected) relations. 
 	EventView(const EventView& original) :
@@ -36,6 +36,11 @@ public:
 	{
 	}
 
+	explicit Particle(const NoInit& tag) :
+		Object(tag), _charge(0), _pdgNumber(0)
+	{
+	}
+
 	Particle(const Particle& original) :
 		Object(original), _vector(original._vector), _charge(original._charge),
 				_pdgNumber(original._pdgNumber)
@@ -75,6 +80,14 @@ public:
 		in.readInt(_pdgNumber);
 	}
 
+	/// Reads past a serialized Particle without decoding it, see ObjectFactory::skip.
+	static void skipSerialized(const InputStream &in)
+	{
+		Object::skipSerialized(in);
+		// vector, charge, pdg number
+		in.skipRaw(32 + 8 + 4);
+	}
+
 	/// This method grants read access to the vector.
 	inline const LorentzVector& getVector() const
 	{
@@ -34,6 +34,11 @@ public:
 	{
 	}
 
+	explicit Vertex(const NoInit& tag) :
+		Object(tag), _vector()
+	{
+	}
+
 	Vertex(const Vertex& original) :
 		Object(original), _vector(original._vector)
 	{
@@ -66,6 +71,13 @@ public:
 		_vector.deserialize(in);
 	}
 
+	/// Reads past a serialized Vertex without decoding it, see ObjectFactory::skip.
+	static void skipSerialized(const InputStream &in)
+	{
+		Object::skipSerialized(in);
+		in.skipRaw(24);
+	}
+
 	/// This method grants read access to the vector.
 	inline const Basic3Vector& getVector() const
 	{
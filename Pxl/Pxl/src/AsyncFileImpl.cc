@@ -0,0 +1,630 @@
+#ifndef _MSC_VER
+
+#include "AsyncFileImpl.hh"
+#include "Pxl/Pxl/interface/pxl/core/logging.hh"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef PXL_ENABLE_IO_URING
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#undef PXL_LOG_MODULE_NAME
+#define PXL_LOG_MODULE_NAME "pxl::AsyncFile"
+
+// size of the blocks read at once, a multiple of the O_DIRECT alignment
+#define PXL_ASYNC_BLOCK_SIZE 1048576
+// number of blocks kept in flight ahead of the read position
+#define PXL_ASYNC_DEPTH 8
+// alignment of buffers, offsets and sizes for O_DIRECT
+#define PXL_ASYNC_ALIGNMENT 4096
+
+namespace pxl
+{
+
+#if defined(PXL_ENABLE_IO_URING) && defined(__NR_io_uring_setup)
+
+struct AsyncFileImpl::Ring
+{
+	Ring() :
+		fd(-1), sqRing(0), sqRingSize(0), cqRing(0), cqRingSize(0), sqes(0),
+		sqesSize(0), sqTail(0), sqMask(0), sqArray(0), cqHead(0), cqTail(0),
+		cqMask(0), cqes(0), toSubmit(0)
+	{
+	}
+
+	int fd;
+	void *sqRing;
+	size_t sqRingSize;
+	void *cqRing;
+	size_t cqRingSize;
+	struct io_uring_sqe *sqes;
+	size_t sqesSize;
+	unsigned *sqTail;
+	unsigned *sqMask;
+	unsigned *sqArray;
+	unsigned *cqHead;
+	unsigned *cqTail;
+	unsigned *cqMask;
+	struct io_uring_cqe *cqes;
+	/// Entries filled since the last io_uring_enter.
+	unsigned toSubmit;
+	std::vector<struct iovec> iovecs;
+};
+
+bool AsyncFileImpl::openRing()
+{
+	struct io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	int fd = syscall(__NR_io_uring_setup, _slots.size(), &params);
+	if (fd < 0)
+	{
+		const char *reason = strerror(errno);
+		PXL_LOG_INFO << "io_uring not available, reading synchronously: "
+				<< reason;
+		return false;
+	}
+
+	Ring *ring = new Ring;
+	ring->fd = fd;
+	ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+	ring->cqRingSize = params.cq_off.cqes
+			+ params.cq_entries * sizeof(struct io_uring_cqe);
+	bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if (single && ring->cqRingSize > ring->sqRingSize)
+		ring->sqRingSize = ring->cqRingSize;
+
+	ring->sqRing = mmap(0, ring->sqRingSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	if (ring->sqRing == MAP_FAILED)
+		ring->sqRing = 0;
+	if (ring->sqRing && single)
+		ring->cqRing = ring->sqRing;
+	else if (ring->sqRing)
+	{
+		ring->cqRing = mmap(0, ring->cqRingSize, PROT_READ | PROT_WRITE,
+				MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+		if (ring->cqRing == MAP_FAILED)
+			ring->cqRing = 0;
+	}
+	ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+	void *sqes = mmap(0, ring->sqesSize, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+	ring->sqes = sqes == MAP_FAILED ? 0 : (struct io_uring_sqe *) sqes;
+
+	_ring = ring;
+	if (ring->sqRing == 0 || ring->cqRing == 0 || ring->sqes == 0)
+	{
+		PXL_LOG_ERROR << "Unable to map io_uring, reading synchronously.";
+		closeRing();
+		return false;
+	}
+
+	char *sq = (char *) ring->sqRing;
+	ring->sqTail = (unsigned *) (sq + params.sq_off.tail);
+	ring->sqMask = (unsigned *) (sq + params.sq_off.ring_mask);
+	ring->sqArray = (unsigned *) (sq + params.sq_off.array);
+	char *cq = (char *) ring->cqRing;
+	ring->cqHead = (unsigned *) (cq + params.cq_off.head);
+	ring->cqTail = (unsigned *) (cq + params.cq_off.tail);
+	ring->cqMask = (unsigned *) (cq + params.cq_off.ring_mask);
+	ring->cqes = (struct io_uring_cqe *) (cq + params.cq_off.cqes);
+	ring->iovecs.resize(_slots.size());
+
+	return true;
+}
+
+void AsyncFileImpl::closeRing()
+{
+	if (_ring == 0)
+		return;
+
+	if (_ring->sqes)
+		munmap(_ring->sqes, _ring->sqesSize);
+	if (_ring->cqRing && _ring->cqRing != _ring->sqRing)
+		munmap(_ring->cqRing, _ring->cqRingSize);
+	if (_ring->sqRing)
+		munmap(_ring->sqRing, _ring->sqRingSize);
+	::close(_ring->fd);
+	delete _ring;
+	_ring = 0;
+}
+
+void AsyncFileImpl::submit(Slot &slot, int64_t offset)
+{
+	// the kernel may still read into the buffer, which happens only if
+	// waiting for io_uring failed
+	if (slot.pending)
+	{
+		_bad = true;
+		return;
+	}
+
+	slot.offset = offset;
+	slot.size = 0;
+	slot.complete = false;
+
+	// nothing to read beyond the end of the file
+	if (offset >= _size)
+	{
+		slot.complete = true;
+		return;
+	}
+
+	// without io_uring, the block is read when it is needed
+	if (_ring == 0)
+		return;
+
+	size_t index = &slot - &_slots[0];
+	struct iovec &iov = _ring->iovecs[index];
+	iov.iov_base = slot.data;
+	iov.iov_len = _blockSize;
+
+	// at most one entry per slot is in flight, so the ring never overflows
+	unsigned tail = *_ring->sqTail;
+	unsigned entry = tail & *_ring->sqMask;
+	struct io_uring_sqe *sqe = &_ring->sqes[entry];
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = IORING_OP_READV;
+	sqe->fd = _fd;
+	sqe->off = offset;
+	sqe->addr = (unsigned long) &iov;
+	sqe->len = 1;
+	sqe->user_data = index;
+	_ring->sqArray[entry] = entry;
+	__atomic_store_n(_ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+	++_ring->toSubmit;
+	slot.pending = true;
+}
+
+void AsyncFileImpl::submitPending()
+{
+	if (_ring == 0 || _ring->toSubmit == 0)
+		return;
+
+	while (_ring->toSubmit > 0)
+	{
+		int submitted = syscall(__NR_io_uring_enter, _ring->fd,
+				_ring->toSubmit, 0, 0, 0, 0);
+		if (submitted < 0)
+		{
+			if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+			{
+				reap(false);
+				continue;
+			}
+			const char *reason = strerror(errno);
+			PXL_LOG_ERROR << "io_uring submission failed: " << reason;
+			_bad = true;
+			return;
+		}
+		_ring->toSubmit -= submitted;
+	}
+}
+
+bool AsyncFileImpl::reap(bool wait)
+{
+	unsigned head = *_ring->cqHead;
+	if (wait && head == __atomic_load_n(_ring->cqTail, __ATOMIC_ACQUIRE))
+	{
+		if (syscall(__NR_io_uring_enter, _ring->fd, 0, 1,
+				IORING_ENTER_GETEVENTS, 0, 0) < 0 && errno != EINTR)
+		{
+			const char *reason = strerror(errno);
+			PXL_LOG_ERROR << "Waiting for io_uring failed: " << reason;
+			_bad = true;
+			return false;
+		}
+	}
+
+	unsigned tail = __atomic_load_n(_ring->cqTail, __ATOMIC_ACQUIRE);
+	for (; head != tail; ++head)
+	{
+		struct io_uring_cqe *cqe = &_ring->cqes[head & *_ring->cqMask];
+		finish(_slots[cqe->user_data], cqe->res);
+	}
+	__atomic_store_n(_ring->cqHead, head, __ATOMIC_RELEASE);
+	return true;
+}
+
+#else
+
+struct AsyncFileImpl::Ring
+{
+};
+
+bool AsyncFileImpl::openRing()
+{
+	return false;
+}
+
+void AsyncFileImpl::closeRing()
+{
+}
+
+void AsyncFileImpl::submit(Slot &slot, int64_t offset)
+{
+	slot.offset = offset;
+	slot.size = 0;
+	slot.pending = false;
+	slot.complete = offset >= _size;
+}
+
+void AsyncFileImpl::submitPending()
+{
+}
+
+bool AsyncFileImpl::reap(bool wait)
+{
+	return true;
+}
+
+#endif
+
+AsyncFileImpl::AsyncFileImpl() :
+		_fd(-1), _size(0), _position(0), _eof(false), _bad(false), _mode(0),
+		_blockSize(PXL_ASYNC_BLOCK_SIZE), _current(0), _nextOffset(0), _ring(0)
+{
+
+}
+
+AsyncFileImpl::AsyncFileImpl(const std::string &filename, int32_t mode) :
+		_fd(-1), _size(0), _position(0), _eof(false), _bad(false), _mode(0),
+		_blockSize(PXL_ASYNC_BLOCK_SIZE), _current(0), _nextOffset(0), _ring(0)
+{
+	open(filename, mode);
+}
+
+AsyncFileImpl::~AsyncFileImpl()
+{
+	close();
+}
+
+bool AsyncFileImpl::open(const std::string &filename, int32_t mode)
+{
+	close();
+	_mode = mode;
+
+	if ((mode & OpenRead) == 0)
+	{
+		PXL_LOG_ERROR << "Asynchronous files can only be opened for reading: "
+				<< filename;
+		return false;
+	}
+
+	// accept both plain paths and async:// urls
+	std::string path = filename;
+	if (path.compare(0, 6, "async:") == 0)
+	{
+		path.erase(0, 6);
+		if (path.compare(0, 2, "//") == 0)
+			path.erase(0, 2);
+	}
+
+	int flags = O_RDONLY;
+#ifdef O_DIRECT
+	if (mode & OpenDirect)
+		flags |= O_DIRECT;
+#endif
+	_fd = ::open(path.c_str(), flags);
+	if (_fd < 0 && (flags & ~O_RDONLY) && errno == EINVAL)
+	{
+		// e.g. tmpfs does not support O_DIRECT
+		PXL_LOG_WARNING << "Direct I/O not supported for " << path
+				<< ", reading through the page cache.";
+		_fd = ::open(path.c_str(), O_RDONLY);
+	}
+	if (_fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(_fd, &st) != 0)
+	{
+		close();
+		return false;
+	}
+	_size = st.st_size;
+
+#ifdef POSIX_FADV_SEQUENTIAL
+	posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+	_slots.resize(PXL_ASYNC_DEPTH);
+	for (size_t i = 0; i < _slots.size(); ++i)
+	{
+		void *data = 0;
+		if (posix_memalign(&data, PXL_ASYNC_ALIGNMENT, _blockSize) != 0)
+		{
+			PXL_LOG_ERROR << "Unable to allocate read buffers for " << path;
+			close();
+			return false;
+		}
+		_slots[i].data = (char *) data;
+		_slots[i].pending = false;
+		_slots[i].complete = true;
+	}
+
+	openRing();
+	restart();
+
+	return true;
+}
+
+void AsyncFileImpl::close()
+{
+	drain();
+	closeRing();
+	for (size_t i = 0; i < _slots.size(); ++i)
+	{
+		// a buffer the kernel may still read into is leaked, not freed
+		if (_slots[i].pending)
+			PXL_LOG_ERROR << "Read still in flight, leaking its buffer.";
+		else
+			free(_slots[i].data);
+	}
+	_slots.clear();
+	if (_fd >= 0)
+		::close(_fd);
+	_fd = -1;
+	_size = 0;
+	_position = 0;
+	_eof = false;
+	_bad = false;
+	_current = 0;
+	_nextOffset = 0;
+}
+
+void AsyncFileImpl::finish(Slot &slot, int64_t result)
+{
+	slot.pending = false;
+	slot.complete = true;
+	if (result < 0)
+	{
+		const char *reason = strerror(-result);
+		PXL_LOG_ERROR << "Read failed: " << reason;
+		_bad = true;
+		slot.size = 0;
+		return;
+	}
+	slot.size = result;
+
+	// complete short reads within the file, which regular files rarely return
+	int64_t end = slot.offset + (int64_t) _blockSize;
+	if (end > _size)
+		end = _size;
+	while (result > 0 && slot.offset + slot.size < end)
+	{
+		result = pread(_fd, slot.data + slot.size, end - slot.offset - slot.size,
+				slot.offset + slot.size);
+		if (result < 0)
+			_bad = true;
+		else
+			slot.size += result;
+	}
+}
+
+bool AsyncFileImpl::waitCurrent()
+{
+	Slot &slot = _slots[_current];
+	while (!slot.complete && !_bad)
+	{
+		if (slot.pending)
+			reap(true);
+		else
+		{
+			ssize_t result = pread(_fd, slot.data, _blockSize, slot.offset);
+			finish(slot, result < 0 ? -errno : result);
+		}
+	}
+
+	return !_bad;
+}
+
+/// Waits until the kernel no longer reads into \p slot, also after a
+/// failure. Returns false if waiting for io_uring failed.
+bool AsyncFileImpl::waitSlot(Slot &slot)
+{
+	while (slot.pending)
+		if (!reap(true))
+			return false;
+
+	return true;
+}
+
+/// Waits for all reads in flight, so that their buffers can be reused or freed.
+void AsyncFileImpl::drain()
+{
+	if (_ring == 0)
+		return;
+
+	for (size_t i = 0; i < _slots.size(); ++i)
+		if (!waitSlot(_slots[i]))
+			return;
+}
+
+void AsyncFileImpl::restart()
+{
+	drain();
+	if (_slots.empty())
+		return;
+
+	int64_t offset = _position - _position % _blockSize;
+	for (size_t i = 0; i < _slots.size(); ++i)
+	{
+		submit(_slots[i], offset);
+		offset += _blockSize;
+	}
+	_current = 0;
+	_nextOffset = offset;
+	submitPending();
+}
+
+bool AsyncFileImpl::isEof()
+{
+	if (_fd < 0)
+		return true;
+
+	return _eof;
+}
+
+bool AsyncFileImpl::isOpen()
+{
+	return (_fd >= 0);
+}
+
+bool AsyncFileImpl::isBad()
+{
+	if (_fd < 0)
+		return true;
+
+	return _bad;
+}
+
+void AsyncFileImpl::clear()
+{
+	_eof = false;
+}
+
+bool AsyncFileImpl::isGood()
+{
+	if (_fd < 0)
+		return false;
+
+	return !_eof && !_bad;
+}
+
+int64_t AsyncFileImpl::tell()
+{
+	if (_fd < 0)
+		return 0;
+
+	return _position;
+}
+
+void AsyncFileImpl::seek(int64_t pos, int32_t d)
+{
+	int64_t newPosition;
+	if (d == SeekBegin)
+		newPosition = pos;
+	else if (d == SeekCurrent)
+		newPosition = _position + pos;
+	else if (d == SeekEnd)
+		newPosition = _size + pos;
+	else
+		throw std::runtime_error("Uninitialized value in AsyncFileImpl::seek. This never should happen!.");
+
+	// like fseek, a successful seek clears the eof state and
+	// positions beyond the end of the file are allowed
+	if (newPosition < 0)
+		return;
+	_position = newPosition;
+	_eof = false;
+	if (_slots.empty())
+		return;
+
+	// within the blocks in flight, pass on the blocks before the position,
+	// otherwise start reading anew at the position
+	if (_position >= _slots[_current].offset && _position < _nextOffset)
+	{
+		while (_position >= _slots[_current].offset + (int64_t) _blockSize)
+		{
+			waitSlot(_slots[_current]);
+			submit(_slots[_current], _nextOffset);
+			_nextOffset += _blockSize;
+			_current = (_current + 1) % _slots.size();
+		}
+		submitPending();
+	}
+	else
+		restart();
+}
+
+int32_t AsyncFileImpl::peek()
+{
+	if (_position >= _size || _slots.empty() || !waitCurrent())
+	{
+		_eof = true;
+		return EOF;
+	}
+
+	const Slot &slot = _slots[_current];
+	int64_t begin = _position - slot.offset;
+	if (begin >= slot.size)
+	{
+		_eof = true;
+		return EOF;
+	}
+
+	return (unsigned char) slot.data[begin];
+}
+
+int64_t AsyncFileImpl::read(char *s, size_t count)
+{
+	int64_t done = 0;
+	while (count > 0)
+	{
+		if (_position >= _size || _slots.empty() || !waitCurrent())
+		{
+			_eof = true;
+			break;
+		}
+
+		Slot &slot = _slots[_current];
+		int64_t begin = _position - slot.offset;
+		int64_t available = slot.size - begin;
+		if (available <= 0)
+		{
+			// the file was truncated while reading
+			_eof = true;
+			break;
+		}
+		if ((int64_t) count < available)
+			available = count;
+
+		memcpy(s, slot.data + begin, available);
+		s += available;
+		count -= available;
+		done += available;
+		_position += available;
+
+		// hand the consumed block to the next read
+		if (_position >= slot.offset + (int64_t) _blockSize)
+		{
+			submit(slot, _nextOffset);
+			_nextOffset += _blockSize;
+			_current = (_current + 1) % _slots.size();
+			submitPending();
+		}
+	}
+
+	return done;
+}
+
+int64_t AsyncFileImpl::write(const char *s, size_t count)
+{
+	return 0;
+}
+
+void AsyncFileImpl::ignore(int64_t count)
+{
+	seek(count, SeekCurrent);
+}
+
+void AsyncFileImpl::destroy()
+{
+	delete this;
+}
+
+}
+
+#endif
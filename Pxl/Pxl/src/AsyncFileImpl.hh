@@ -0,0 +1,85 @@
+#ifndef PXL_ASYNC_FILE_IMPL_HH_
+#define PXL_ASYNC_FILE_IMPL_HH_
+
+#include "Pxl/Pxl/interface/pxl/core/macros.hh"
+#include "Pxl/Pxl/interface/pxl/core/File.hh"
+
+#include <vector>
+
+namespace pxl
+{
+
+/// Read-only file implementation for streaming large local files. It keeps
+/// several large reads in flight ahead of the read position, submitted through
+/// io_uring if PXL is compiled with PXL_ENABLE_IO_URING and the kernel supports
+/// it, otherwise the blocks are read synchronously with pread. Opened with
+/// OpenDirect, the file is read with O_DIRECT into aligned buffers, bypassing
+/// the page cache for one-pass reads.
+class PXL_DLL_EXPORT AsyncFileImpl: public FileImpl
+{
+	/// A buffer holding the block of the file starting at offset.
+	struct Slot
+	{
+		char *data;
+		int64_t offset;
+		/// Number of valid bytes once the read is complete.
+		int64_t size;
+		bool pending;
+		bool complete;
+	};
+
+	int _fd;
+	int64_t _size;
+	int64_t _position;
+	bool _eof;
+	bool _bad;
+	int32_t _mode;
+	size_t _blockSize;
+	std::vector<Slot> _slots;
+	/// Slot holding the block at the read position.
+	size_t _current;
+	/// Offset of the block to be read by the next free slot.
+	int64_t _nextOffset;
+
+	/// The io_uring instance, opaque to keep the kernel headers internal.
+	struct Ring;
+	Ring *_ring;
+
+	bool openRing();
+	void closeRing();
+	void submit(Slot &slot, int64_t offset);
+	void submitPending();
+	bool reap(bool wait);
+	void finish(Slot &slot, int64_t result);
+	bool waitCurrent();
+	bool waitSlot(Slot &slot);
+	void drain();
+	void restart();
+
+public:
+
+	AsyncFileImpl();
+
+	AsyncFileImpl(const std::string &filename, int32_t mode);
+
+	~AsyncFileImpl();
+
+	virtual bool open(const std::string &filename, int32_t mode);
+	virtual void close();
+	virtual bool isEof();
+	virtual bool isOpen();
+	virtual bool isBad();
+	virtual void clear();
+	virtual bool isGood();
+	virtual int64_t tell();
+	virtual void seek(int64_t pos, int32_t d);
+	virtual int32_t peek();
+	virtual int64_t read(char *s, size_t count);
+	virtual int64_t write(const char *s, size_t count);
+	virtual void ignore(int64_t count);
+	virtual void destroy();
+};
+
+} // namespace pxl
+
+#endif /* PXL_ASYNC_FILE_IMPL_HH_ */
@@ -13,7 +13,7 @@ namespace pxl
 
 void BasicContainer::init(const BasicContainer& original)
 {
-	std::map<Id, Serializable*> copyHistory;
+	IdMap<Serializable*> copyHistory;
 
 	for (const_iterator iter = original._container.begin();
 			iter != original._container.end(); ++iter)
@@ -23,7 +23,7 @@ void BasicContainer::init(const BasicContainer& original)
 		Serializable* pNew = pOld->clone();
 
 		insertObject(pNew);
-		copyHistory.insert(std::pair<Id, Serializable*>(pOld->getId(), pNew));
+		copyHistory.insert(pOld->getId(), pNew);
 	}
 
 	// redirect index:
@@ -33,11 +33,7 @@ void BasicContainer::init(const BasicContainer& original)
 
 		Serializable* pOld = iter->second;
 
-		Serializable* pNew = 0;
-		std::map<Id, Serializable*>::const_iterator found = copyHistory.find(
-				pOld->getId());
-		if (found != copyHistory.end())
-			pNew = found->second;
+		Serializable* pNew = copyHistory.get(pOld->getId());
 
 		if (pNew)
 			_index.insert(map_t::const_iterator::value_type(iter->first, pNew));
@@ -58,7 +54,7 @@ void BasicContainer::clearContainer()
 void BasicContainer::insertObject(Serializable* value)
 {
 	_container.push_back(value);
-	_uuidSearchMap.insert(std::pair<Id, Serializable*>(value->getId(), value));
+	_uuidSearchMap.insert(value->getId(), value);
 }
 
 void BasicContainer::remove(Serializable* value)
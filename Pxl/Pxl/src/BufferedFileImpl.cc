@@ -0,0 +1,250 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#include "Pxl/Pxl/interface/pxl/core/BufferedFileImpl.hh"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace pxl
+{
+
+static size_t _defaultWindowSize = 4194304;
+
+void BufferedFileImpl::setDefaultWindowSize(size_t size)
+{
+	_defaultWindowSize = size;
+}
+
+size_t BufferedFileImpl::getDefaultWindowSize()
+{
+	return _defaultWindowSize;
+}
+
+BufferedFileImpl::BufferedFileImpl(FileImpl *impl, size_t windowSize) :
+		_impl(impl), _windowSize(windowSize), _bufferBegin(0), _bufferPosition(
+				0), _bufferSize(0), _eof(false), _bad(false), _mode(0)
+{
+	if (_windowSize == 0)
+		_windowSize = _defaultWindowSize;
+	if (_windowSize == 0)
+		_windowSize = 1;
+}
+
+BufferedFileImpl::~BufferedFileImpl()
+{
+	close();
+	if (_impl)
+		_impl->destroy();
+}
+
+bool BufferedFileImpl::open(const std::string &filename, int32_t mode)
+{
+	_mode = mode;
+	drop(0);
+	_eof = false;
+	_bad = false;
+	return _impl->open(filename, mode);
+}
+
+void BufferedFileImpl::close()
+{
+	if (_impl)
+		_impl->close();
+	drop(0);
+	std::vector<char>().swap(_buffer);
+	_eof = false;
+	_bad = false;
+}
+
+/// Empties the buffer, the next read starts at \p position,
+/// where the wrapped file is positioned.
+void BufferedFileImpl::drop(int64_t position)
+{
+	_bufferBegin = position;
+	_bufferPosition = 0;
+	_bufferSize = 0;
+}
+
+/// Reads the next window from the wrapped file, which is always positioned
+/// at the end of the buffered data. Returns false at the end of the file
+/// or if reading failed.
+bool BufferedFileImpl::fill()
+{
+	if (_buffer.size() != _windowSize)
+		_buffer.resize(_windowSize);
+
+	drop(_bufferBegin + _bufferSize);
+	int64_t count = _impl->read(&_buffer[0], _windowSize);
+	if (count > 0)
+		_bufferSize = count;
+	if (count < 0 || _impl->isBad())
+		_bad = true;
+
+	return _bufferSize > 0;
+}
+
+bool BufferedFileImpl::isEof()
+{
+	if (!isOpen())
+		return true;
+
+	return _eof;
+}
+
+bool BufferedFileImpl::isOpen()
+{
+	return _impl && _impl->isOpen();
+}
+
+bool BufferedFileImpl::isBad()
+{
+	// the wrapped file may be at its end or have failed while the buffer
+	// still holds data
+	return !isOpen() || (_bad && _bufferPosition >= _bufferSize);
+}
+
+void BufferedFileImpl::clear()
+{
+	_eof = false;
+	if (_impl)
+		_impl->clear();
+}
+
+bool BufferedFileImpl::isGood()
+{
+	return isOpen() && !_eof && !isBad();
+}
+
+int64_t BufferedFileImpl::tell()
+{
+	if (!isOpen())
+		return 0;
+
+	return _bufferBegin + _bufferPosition;
+}
+
+void BufferedFileImpl::seek(int64_t pos, int32_t d)
+{
+	int64_t position;
+	if (d == SeekBegin)
+		position = pos;
+	else if (d == SeekCurrent)
+		position = tell() + pos;
+	else if (d == SeekEnd)
+	{
+		_impl->seek(pos, SeekEnd);
+		drop(_impl->tell());
+		_eof = false;
+		return;
+	}
+	else
+		throw std::runtime_error("Uninitialized value in BufferedFileImpl::seek. This never should happen!.");
+
+	if (position < 0)
+		return;
+	_eof = false;
+
+	// positions within the buffer (including its end) need no access to the file
+	if (position >= _bufferBegin
+			&& position <= _bufferBegin + (int64_t) _bufferSize)
+	{
+		_bufferPosition = position - _bufferBegin;
+		return;
+	}
+
+	_impl->clear();
+	_impl->seek(position, SeekBegin);
+	drop(position);
+}
+
+int32_t BufferedFileImpl::peek()
+{
+	if (_bufferPosition >= _bufferSize && !fill())
+	{
+		_eof = true;
+		return EOF;
+	}
+
+	return (unsigned char) _buffer[_bufferPosition];
+}
+
+int64_t BufferedFileImpl::read(char *s, size_t count)
+{
+	if (_mode & OpenWrite)
+		return _impl->read(s, count);
+
+	int64_t done = 0;
+	while (count > 0)
+	{
+		size_t available = _bufferSize - _bufferPosition;
+		if (available == 0)
+		{
+			// large reads go to the file directly instead of through the buffer
+			if (count >= _windowSize)
+			{
+				drop(_bufferBegin + _bufferSize);
+				int64_t direct = _impl->read(s, count);
+				if (direct > 0)
+				{
+					_bufferBegin += direct;
+					done += direct;
+				}
+				if (direct < 0 || _impl->isBad())
+					_bad = true;
+				if (direct < (int64_t) count)
+					_eof = true;
+				break;
+			}
+			if (!fill())
+			{
+				_eof = true;
+				break;
+			}
+			available = _bufferSize;
+		}
+
+		if (available > count)
+			available = count;
+		memcpy(s, &_buffer[_bufferPosition], available);
+		_bufferPosition += available;
+		s += available;
+		count -= available;
+		done += available;
+	}
+
+	return done;
+}
+
+int64_t BufferedFileImpl::write(const char *s, size_t count)
+{
+	// the buffer only holds read data, so it is out of date now
+	if (_bufferSize > 0)
+	{
+		_impl->seek(tell(), SeekBegin);
+		drop(tell());
+	}
+	int64_t written = _impl->write(s, count);
+	if (written > 0)
+		_bufferBegin += written;
+	if (written < 0 || _impl->isBad())
+		_bad = true;
+	return written;
+}
+
+void BufferedFileImpl::ignore(int64_t count)
+{
+	seek(count, SeekCurrent);
+}
+
+void BufferedFileImpl::destroy()
+{
+	delete this;
+}
+
+}
@@ -8,15 +8,164 @@
 
 #include <stdexcept>
 #include <sstream>
+#include <algorithm>
 #include <zlib.h>
+#ifdef PXL_ENABLE_LZ4
+#include <lz4.h>
+#endif
+#ifdef PXL_ENABLE_ZSTD
+#include <zstd.h>
+#endif
 
 #include "Pxl/Pxl/interface/pxl/core/ChunkReader.hh"
 
 namespace pxl
 {
 
+/// Inflates a complete zlib stream held in memory. If the uncompressed size
+/// is known, the output is allocated once, otherwise it grows step by step.
+static void inflateBuffer(const char* input, size_t inputSize,
+		uint32_t uncompressedSize, std::vector<char>& output)
+{
+	z_stream strm;
+	strm.zalloc = Z_NULL;
+	strm.zfree = Z_NULL;
+	strm.opaque = Z_NULL;
+	strm.avail_in = inputSize;
+	strm.next_in = (Bytef *) input;
+
+	if (inflateInit(&strm) != Z_OK)
+		throw std::runtime_error("pxl::ChunkReader::inflateBuffer(): inflateInit failed.");
+
+	size_t step = uncompressedSize;
+	if (step == 0)
+		step = std::max(inputSize * 3, (size_t) 1024);
+
+	output.clear();
+	size_t length = 0;
+	int ret;
+	do
+	{
+		if (output.size() == length)
+			output.resize(output.size() + step);
+
+		strm.avail_out = output.size() - length;
+		strm.next_out = (Bytef *) (&output[length]);
+
+		ret = inflate(&strm, Z_NO_FLUSH);
+		if (ret == Z_STREAM_ERROR || ret == Z_NEED_DICT || ret == Z_DATA_ERROR
+				|| ret == Z_MEM_ERROR)
+		{
+			inflateEnd(&strm);
+			throw std::runtime_error("pxl::ChunkReader::inflateBuffer(): Corrupt compressed block.");
+		}
+
+		length = output.size() - strm.avail_out;
+	} while (ret != Z_STREAM_END && (strm.avail_in > 0 || strm.avail_out == 0));
+
+	inflateEnd(&strm);
+	output.resize(length);
+}
+
+/// Decompresses a block of the given compression mode ('Z' and 'z': zlib,
+/// 'L': LZ4, 'S': Zstandard). LZ4 and Zstandard blocks always store their
+/// uncompressed size.
+static void decompressBuffer(char compressionMode, const char* input,
+		size_t inputSize, uint32_t uncompressedSize, std::vector<char>& output,
+		void* zstdContext, const void* zstdDictionary)
+{
+	if (compressionMode=='Z' || compressionMode=='z')
+	{
+		inflateBuffer(input, inputSize, uncompressedSize, output);
+	}
+	else if (compressionMode=='L')
+	{
+#ifdef PXL_ENABLE_LZ4
+		output.resize(uncompressedSize);
+		if (uncompressedSize == 0)
+			return;
+		int length = LZ4_decompress_safe(input, &output[0], inputSize,
+				uncompressedSize);
+		if (length < 0 || (uint32_t) length != uncompressedSize)
+			throw std::runtime_error("pxl::ChunkReader::decompressBuffer(): Corrupt LZ4 block.");
+#else
+		throw std::runtime_error("pxl::ChunkReader::decompressBuffer(): LZ4 block found, but PXL was compiled without PXL_ENABLE_LZ4.");
+#endif
+	}
+	else if (compressionMode=='S')
+	{
+#ifdef PXL_ENABLE_ZSTD
+		output.resize(uncompressedSize);
+		if (uncompressedSize == 0)
+			return;
+		// raw content dictionaries leave no id in the frame, so a
+		// dictionary is always used once it is set
+		size_t length;
+		if (zstdDictionary)
+			length = ZSTD_decompress_usingDDict((ZSTD_DCtx*) zstdContext,
+					&output[0], uncompressedSize, input, inputSize,
+					(const ZSTD_DDict*) zstdDictionary);
+		else if (ZSTD_getDictID_fromFrame(input, inputSize) != 0)
+			throw std::runtime_error("pxl::ChunkReader::decompressBuffer(): Zstandard block needs a dictionary, see setZstdDictionary().");
+		else
+			length = ZSTD_decompressDCtx((ZSTD_DCtx*) zstdContext, &output[0],
+					uncompressedSize, input, inputSize);
+		if (ZSTD_isError(length) || length != uncompressedSize)
+			throw std::runtime_error("pxl::ChunkReader::decompressBuffer(): Corrupt Zstandard block.");
+#else
+		throw std::runtime_error("pxl::ChunkReader::decompressBuffer(): Zstandard block found, but PXL was compiled without PXL_ENABLE_ZSTD.");
+#endif
+	}
+	else
+	{
+		throw std::runtime_error("pxl::ChunkReader::readBlock(): Invalid compression mode.");
+	}
+}
+
+static void* createZstdContext()
+{
+#ifdef PXL_ENABLE_ZSTD
+	return ZSTD_createDCtx();
+#else
+	return 0;
+#endif
+}
+
+static void freeZstdContext(void* context)
+{
+#ifdef PXL_ENABLE_ZSTD
+	ZSTD_freeDCtx((ZSTD_DCtx*) context);
+#endif
+}
+
+void ChunkReader::setZstdDictionary(const std::string& dictionary)
+{
+	stopReadAhead();
+#ifdef PXL_ENABLE_ZSTD
+	ZSTD_freeDDict((ZSTD_DDict*) _zstdDictionary);
+	_zstdDictionary = 0;
+	if (!dictionary.empty())
+		_zstdDictionary = ZSTD_createDDict(dictionary.data(), dictionary.size());
+#else
+	if (!dictionary.empty())
+		throw std::runtime_error("pxl::ChunkReader::setZstdDictionary(): PXL was compiled without PXL_ENABLE_ZSTD.");
+#endif
+}
+
+void ChunkReader::releaseZstd()
+{
+	freeZstdContext(_zstdContext);
+	_zstdContext = 0;
+#ifdef PXL_ENABLE_ZSTD
+	ZSTD_freeDDict((ZSTD_DDict*) _zstdDictionary);
+#endif
+	_zstdDictionary = 0;
+}
+
 bool ChunkReader::skip()
 {
+	stopReadAhead();
+
 	if (_stream.peek()==EOF)
 		return false;
 
@@ -31,6 +180,17 @@ bool ChunkReader::skip()
 		_stream.ignore(infoSize);
 	}
 
+	int64_t position = 0;
+	skipBlocks(position);
+	_status = preHeader;
+
+	return true;
+}
+
+/// Skips the remaining blocks and the end of the current file section
+/// without reading the data. Adds the skipped bytes to position.
+void ChunkReader::skipBlocks(int64_t& position)
+{
 	//skip all blocks
 	while (nextBlockId()=='B' && !_stream.isEof() )
 	{
@@ -41,13 +201,41 @@ bool ChunkReader::skip()
 		_stream.ignore(1);
 
 		// read chunk size
-		int32_t chunkSize = 0;
+		uint32_t chunkSize = 0;
 		_stream.read((char *)&chunkSize, 4);
 		_stream.ignore(chunkSize);
+		position += 1 + 4 + infoSize + 1 + 4 + chunkSize;
 	}
 
 	_stream.ignore(4);
+	position += 1 + 4;
+}
+
+bool ChunkReader::seekSection(int64_t position, unsigned long sectionCount)
+{
+	if (_seekMode == nonSeekable)
+		return false;
+
+	stopReadAhead();
+
+	_stream.clear();
+	_stream.seek(position);
+	_sectionCount = sectionCount;
 	_status = preHeader;
+	_buffer.clear();
+
+	return !_stream.isBad();
+}
+
+bool ChunkReader::skipSectionData(size_t bytes)
+{
+	while (bytes >= _buffer.available())
+	{
+		bytes -= _buffer.available();
+		if (!nextBlock())
+			return false;
+	}
+	_buffer.skip(bytes);
 
 	return true;
 }
@@ -57,6 +245,8 @@ bool ChunkReader::previous()
 	if (_seekMode == nonSeekable)
 		return false;
 
+	stopReadAhead();
+
 	if (_status != preHeader)
 	{
 		endEvent();
@@ -87,6 +277,9 @@ bool ChunkReader::previous()
 bool ChunkReader::readBlock(skipMode skip, infoMode checkInfo,
 		const std::string& infoCondition) 
 {
+	if (_readAheadRunning)
+		return readBlockAhead(skip, checkInfo, infoCondition);
+
 	//if event header not read, return
 	if (_status == preHeader)
 		return false;
@@ -121,16 +314,13 @@ bool ChunkReader::readBlock(skipMode skip, infoMode checkInfo,
 
 	if (checkInfo == evaluate)
 	{
-		char* infoBuffer = new char[infoSize+1];
-		infoBuffer[infoSize]=0;
-		_stream.read(infoBuffer, infoSize);
-		std::string info;
-		info.assign(infoBuffer);
+		_blockInfo.resize(infoSize > 0 ? infoSize : 0);
+		if (infoSize > 0)
+			_stream.read(&_blockInfo[0], infoSize);
 		//the mode is set to -2 if the info condition is not fulfilled.
 		//rest of block must be skipped and false be returned.
-		if (infoCondition!=info)
+		if (infoCondition!=_blockInfo)
 			readStream = false;
-		delete infoBuffer;
 	}
 	else
 		_stream.ignore(infoSize);
@@ -160,6 +350,13 @@ bool ChunkReader::readBlock(skipMode skip, infoMode checkInfo,
 		{
 			//_buffer.destroy();
 			_buffer.clear();
+			// hand out the data directly if the file is held in memory
+			const char* view = _stream.readView(chunkSize);
+			if (view)
+			{
+				_buffer.setView(view, chunkSize);
+				return true;
+			}
 			_buffer.buffer.resize(chunkSize);
 			_stream.read(&_buffer.buffer[0], chunkSize);
 			if (_stream.isBad() || _stream.isEof() )
@@ -171,6 +368,22 @@ bool ChunkReader::readBlock(skipMode skip, infoMode checkInfo,
 			_buffer.clear();
 			unzipEventData(chunkSize);
 		}
+		else if (compressionMode=='z' || compressionMode=='L' || compressionMode=='S')
+		{
+			// compressed block preceded by its uncompressed size
+			_buffer.clear();
+			if (chunkSize < 4)
+				throw std::runtime_error("pxl::ChunkReader::readBlock(): Invalid chunk size.");
+			uint32_t uncompressedSize = 0;
+			_stream.read((char *)&uncompressedSize, 4);
+			const char* payload = 0;
+			if (!readPayload(chunkSize - 4, _compressedBuffer, payload))
+				return false;
+			if (compressionMode=='S' && _zstdContext == 0)
+				_zstdContext = createZstdContext();
+			decompressBuffer(compressionMode, payload, chunkSize - 4,
+					uncompressedSize, _buffer.buffer, _zstdContext, _zstdDictionary);
+		}
 		else
 		{
 			throw std::runtime_error("pxl::ChunkReader::readBlock(): Invalid compression mode.");
@@ -179,44 +392,73 @@ bool ChunkReader::readBlock(skipMode skip, infoMode checkInfo,
 	return true;
 }
 
+/// Reads size bytes from the file, directly from memory if possible, else into storage.
+bool ChunkReader::readPayload(uint32_t size, std::vector<char>& storage,
+		const char*& data)
+{
+	data = _stream.readView(size);
+	if (data)
+		return true;
+
+	storage.resize(size);
+	if (size > 0)
+		_stream.read(&storage[0], size);
+	data = storage.empty() ? 0 : &storage[0];
+
+	return !(_stream.isBad() || _stream.isEof());
+}
+
 bool ChunkReader::readHeader(readMode mode, skipMode doSkip,
 		infoMode checkInfo, const std::string& infoCondition)
 {
 	// if position is not before the header, end the previous event
 	endEvent();
+
+	if (_readAheadDepth > 0 && _seekMode == seekable)
+	{
+		if (!_readAheadRunning)
+			startReadAhead();
+		if (_readAheadRunning)
+			return readHeaderAhead(doSkip, checkInfo, infoCondition);
+	}
 	
-	++_sectionCount;
-	
-	if (_stream.peek()==EOF || _stream.isBad() )
-		return false;
+	while (true)
+	{
+		++_sectionCount;
 
-	_status = preBlock;
-	// Check for nextId? char nextId = 
-	nextBlockId();
+		if (_stream.peek()==EOF || _stream.isBad() )
+			return false;
 
-	// get size of info string
-	int32_t infoSize = 0;
-	_stream.read((char *)&infoSize, 4);
+		_status = preBlock;
+		// Check for nextId? char nextId = 
+		nextBlockId();
+
+		// get size of info string
+		int32_t infoSize = 0;
+		_stream.read((char *)&infoSize, 4);
+
+		_sectionInfo.resize(infoSize > 0 ? infoSize : 0);
+		if (infoSize > 0)
+			_stream.read(&_sectionInfo[0], infoSize);
+
+		if (_sectionFilter == 0 || (*_sectionFilter)(_sectionInfo)
+				|| _stream.isEof() || _stream.isBad())
+			break;
+
+		// skip sections rejected by the section filter without reading their blocks
+		int64_t position = 0;
+		skipBlocks(position);
+		_status = preHeader;
+	}
 
 	//if info string is to be checked
-	if (checkInfo==evaluate)
+	if (checkInfo==evaluate && infoCondition!=_sectionInfo)
 	{
-		char* infoBuffer = new char[infoSize+1];
-		infoBuffer[infoSize]=0;
-		_stream.read(infoBuffer, infoSize);
-		std::string info;
-		info.assign(infoBuffer);
-		delete infoBuffer;
-		if (infoCondition!=info)
-		{
-			if (doSkip == on)
-				return readHeader(mode, doSkip, checkInfo, infoCondition);
-			else
-				return false;
-		}
+		if (doSkip == on)
+			return readHeader(mode, doSkip, checkInfo, infoCondition);
+		else
+			return false;
 	}
-	else
-		_stream.ignore(infoSize);
 
 	if (_stream.isEof() || _stream.isBad() )
 		return false;
@@ -224,7 +466,30 @@ bool ChunkReader::readHeader(readMode mode, skipMode doSkip,
 	return true;
 }
 
-int ChunkReader::unzipEventData(uint32_t nBytes) 
+bool ChunkReader::next(const InfoCondition& condition, skipMode doSkip)
+{
+	while (readHeader(all, off, ignore, ""))
+	{
+		if (condition(_sectionInfo))
+			return true;
+		if (doSkip == off)
+			return false;
+
+		// sections read ahead are inflated already and only need to be dropped
+		if (_readAheadRunning)
+			endEvent();
+		else
+		{
+			int64_t position = 0;
+			skipBlocks(position);
+			_status = preHeader;
+		}
+	}
+
+	return false;
+}
+
+int ChunkReader::unzipEventData(uint32_t nBytes, std::vector<char>& buffer)
 {
 	size_t buffer_size_step = nBytes * 3;
 	
@@ -240,39 +505,51 @@ int ChunkReader::unzipEventData(uint32_t nBytes)
 	if (ret != Z_OK)
 		return 0;
 
+	// inflate directly from memory if the file is held in memory
+	const char* view = _stream.readView(nBytes);
+
 	// decompress until deflate stream ends or end of file
 	do
 	{
-		int size = nBytes;
-		if (size > iotl__iStreamer__lengthUnzipBuffer)
+		if (view)
 		{
-			size = iotl__iStreamer__lengthUnzipBuffer;
+			strm.avail_in = nBytes;
+			strm.next_in = (Bytef *) view;
+			nBytes = 0;
 		}
-
-		strm.avail_in = _stream.read((char*)_inputBuffer, size);
-		if (_stream.isBad())
+		else
 		{
-			inflateEnd(&strm);
-			return 0;
-		}
+			int size = nBytes;
+			if (size > iotl__iStreamer__lengthUnzipBuffer)
+			{
+				size = iotl__iStreamer__lengthUnzipBuffer;
+			}
 
-		nBytes -= strm.avail_in;
-		
-		if (_stream.isEof())
-			nBytes = 0;
+			strm.avail_in = _stream.read((char*)_inputBuffer, size);
+			if (_stream.isBad())
+			{
+				inflateEnd(&strm);
+				return 0;
+			}
+
+			nBytes -= strm.avail_in;
+
+			if (_stream.isEof())
+				nBytes = 0;
+
+			strm.next_in = _inputBuffer;
+		}
 
 		if (strm.avail_in == 0)
 			break;
 
-		strm.next_in = _inputBuffer;
-
 		// run inflate() on input until output buffer not full
 		do {
-			if ((_buffer.buffer.size() - length) < buffer_size_step)
-				_buffer.buffer.resize(_buffer.buffer.size() + buffer_size_step);
+			if ((buffer.size() - length) < buffer_size_step)
+				buffer.resize(buffer.size() + buffer_size_step);
 
-			strm.avail_out = _buffer.buffer.size() - length;
-			strm.next_out = (Bytef *)(&_buffer.buffer[length]);
+			strm.avail_out = buffer.size() - length;
+			strm.next_out = (Bytef *)(&buffer[length]);
 
 			ret = inflate(&strm, Z_NO_FLUSH);
 			switch (ret)
@@ -289,13 +566,13 @@ int ChunkReader::unzipEventData(uint32_t nBytes)
 				break;
 			}
 
-			size_t have = _buffer.buffer.size() - length  - strm.avail_out;
+			size_t have = buffer.size() - length  - strm.avail_out;
 			length += have;
 		} while (strm.avail_out == 0);
 	} while (nBytes > 0); // done when inflate() says it's done
 
 	inflateEnd(&strm);
-	_buffer.buffer.resize(length);
+	buffer.resize(length);
 
 	return length;
 }
@@ -304,6 +581,9 @@ int ChunkReader::unzipEventData(uint32_t nBytes)
 /// Returns the size of the associated file.
 size_t ChunkReader::getSize() const
 {
+	if (_readAheadRunning)
+		return _readAheadSize;
+
 	std::streampos pos = _stream.tell();
 	_stream.seek (0, SeekEnd);
 
@@ -313,5 +593,479 @@ size_t ChunkReader::getSize() const
 	return length;
 }
 
+/// Returns the current position in the associated file.
+size_t ChunkReader::getPosition() const
+{
+	if (_readAheadRunning)
+		return _readAheadConsumed;
+
+	return _stream.tell();
+}
+
+bool ChunkReader::eof() const
+{
+	if (!_readAheadRunning)
+		return _stream.peek()==EOF;
+
+	// within a section, only a truncated section ends the file
+	if (_status != preHeader)
+		return (_currentSection && !_currentSection->complete
+				&& _currentSection->error.empty()
+				&& _currentBlock >= _currentSection->blocks.size());
+
+	pthread_mutex_lock(&_readAheadMutex);
+	while (_readAheadQueue.empty() && !_readAheadFinished)
+		pthread_cond_wait(&_readAheadNotEmpty, &_readAheadMutex);
+	bool result = _readAheadQueue.empty();
+	pthread_mutex_unlock(&_readAheadMutex);
+
+	return result;
+}
+
+void ChunkReader::setReadAhead(size_t depth)
+{
+	if (depth == 0)
+		stopReadAhead();
+
+	pthread_mutex_lock(&_readAheadMutex);
+	_readAheadDepth = depth;
+	pthread_cond_broadcast(&_readAheadNotFull);
+	pthread_mutex_unlock(&_readAheadMutex);
+}
+
+void* ChunkReader::readAheadThread(void* reader)
+{
+	static_cast<ChunkReader*>(reader)->readAheadLoop();
+	return 0;
+}
+
+void ChunkReader::setInflateThreads(size_t threads)
+{
+	// the pool is set up together with the read-ahead thread
+	stopReadAhead();
+	_inflateThreadCount = threads;
+}
+
+void* ChunkReader::inflateThread(void* reader)
+{
+	static_cast<ChunkReader*>(reader)->inflateLoop();
+	return 0;
 }
 
+void ChunkReader::startInflateThreads()
+{
+	_inflateStop = false;
+	for (size_t i = 0; i < _inflateThreadCount; ++i)
+	{
+		pthread_t thread;
+		if (pthread_create(&thread, 0, inflateThread, this) != 0)
+			break;
+		_inflateThreads.push_back(thread);
+	}
+}
+
+void ChunkReader::stopInflateThreads()
+{
+	pthread_mutex_lock(&_inflateMutex);
+	_inflateStop = true;
+	_inflateJobs.clear();
+	pthread_cond_broadcast(&_inflateWork);
+	pthread_mutex_unlock(&_inflateMutex);
+
+	for (size_t i = 0; i < _inflateThreads.size(); ++i)
+		pthread_join(_inflateThreads[i], 0);
+	_inflateThreads.clear();
+}
+
+void ChunkReader::inflateLoop()
+{
+	void* zstdContext = createZstdContext();
+
+	pthread_mutex_lock(&_inflateMutex);
+	while (true)
+	{
+		while (_inflateJobs.empty() && !_inflateStop)
+			pthread_cond_wait(&_inflateWork, &_inflateMutex);
+		if (_inflateStop)
+			break;
+
+		ReadAheadBlock* block = _inflateJobs.front();
+		_inflateJobs.pop_front();
+		pthread_mutex_unlock(&_inflateMutex);
+
+		std::string error;
+		try
+		{
+			const char* input = block->compressedView;
+			if (input == 0 && !block->compressed.empty())
+				input = &block->compressed[0];
+			decompressBuffer(block->compressionMode, input,
+					block->compressedSize, block->uncompressedSize, block->data,
+					zstdContext, _zstdDictionary);
+		}
+		catch (std::exception& e)
+		{
+			error = e.what();
+		}
+		std::vector<char>().swap(block->compressed);
+
+		pthread_mutex_lock(&_inflateMutex);
+		block->error = error;
+		block->inflated = true;
+		pthread_cond_broadcast(&_inflateDone);
+	}
+	pthread_mutex_unlock(&_inflateMutex);
+
+	freeZstdContext(zstdContext);
+}
+
+void ChunkReader::waitInflated(ReadAheadBlock& block)
+{
+	pthread_mutex_lock(&_inflateMutex);
+	while (!block.inflated)
+		pthread_cond_wait(&_inflateDone, &_inflateMutex);
+	pthread_mutex_unlock(&_inflateMutex);
+
+	if (!block.error.empty())
+		throw std::runtime_error(block.error);
+}
+
+void ChunkReader::startReadAhead()
+{
+	_readAheadSize = getSize();
+	_readAheadConsumed = _readAheadPosition = _stream.tell();
+	_readAheadStop = false;
+	_readAheadFinished = false;
+	delete _currentSection;
+	_currentSection = 0;
+	_currentBlock = 0;
+
+	startInflateThreads();
+	if (pthread_create(&_readAheadThread, 0, readAheadThread, this) == 0)
+		_readAheadRunning = true;
+	else
+		stopInflateThreads();
+}
+
+void ChunkReader::stopReadAhead()
+{
+	if (!_readAheadRunning)
+		return;
+
+	pthread_mutex_lock(&_readAheadMutex);
+	_readAheadStop = true;
+	pthread_cond_broadcast(&_readAheadNotFull);
+	pthread_mutex_unlock(&_readAheadMutex);
+
+	pthread_join(_readAheadThread, 0);
+	stopInflateThreads();
+	_readAheadRunning = false;
+
+	while (!_readAheadQueue.empty())
+	{
+		delete _readAheadQueue.front();
+		_readAheadQueue.pop_front();
+	}
+	delete _currentSection;
+	_currentSection = 0;
+	_currentBlock = 0;
+
+	// continue where the consumer stopped, the status is still valid
+	_stream.clear();
+	_stream.seek(_readAheadConsumed);
+}
+
+void ChunkReader::readAheadLoop()
+{
+	while (true)
+	{
+		pthread_mutex_lock(&_readAheadMutex);
+		while (!_readAheadStop && _readAheadQueue.size() >= _readAheadDepth)
+			pthread_cond_wait(&_readAheadNotFull, &_readAheadMutex);
+		bool stop = _readAheadStop;
+		pthread_mutex_unlock(&_readAheadMutex);
+
+		if (stop)
+			break;
+
+		ReadAheadSection* section = new ReadAheadSection;
+		int64_t position = _readAheadPosition;
+		bool hasHeader = false;
+		try
+		{
+			hasHeader = readAheadSection(*section, position);
+		}
+		catch (std::exception& e)
+		{
+			section->error = e.what();
+		}
+
+		pthread_mutex_lock(&_readAheadMutex);
+		if (hasHeader)
+		{
+			_readAheadQueue.push_back(section);
+			if (section->complete && section->error.empty())
+				_readAheadPosition = position;
+			else
+				_readAheadFinished = true;
+		}
+		else
+		{
+			delete section;
+			_readAheadFinished = true;
+		}
+		bool finished = _readAheadFinished;
+		pthread_cond_signal(&_readAheadNotEmpty);
+		pthread_mutex_unlock(&_readAheadMutex);
+
+		if (finished)
+			break;
+	}
+}
+
+/// Reads a complete file section and inflates its blocks. Returns false
+/// if no section header could be read.
+bool ChunkReader::readAheadSection(ReadAheadSection& section, int64_t& position)
+{
+	section.complete = false;
+	section.skipped = 0;
+
+	int32_t infoSize = 0;
+	while (true)
+	{
+		section.begin = position;
+		section.headerEnd = position;
+		section.end = position;
+
+		if (_stream.peek()==EOF || _stream.isBad())
+			return false;
+
+		nextBlockId();
+		_stream.read((char *)&infoSize, 4);
+		section.info.resize(infoSize);
+		if (infoSize > 0)
+			_stream.read(&section.info[0], infoSize);
+		if (_stream.isEof() || _stream.isBad())
+			return false;
+		position += 5 + infoSize;
+		section.headerEnd = position;
+
+		if (_sectionFilter == 0 || (*_sectionFilter)(section.info))
+			break;
+
+		// drop sections rejected by the section filter before inflating them
+		skipBlocks(position);
+		++section.skipped;
+	}
+
+	bool pending = false;
+	try
+	{
+		while (_stream.peek()!=EOF)
+		{
+			char id = nextBlockId();
+			position += 1;
+
+			if (id=='e')
+			{
+				_stream.ignore(4);
+				position += 4;
+				section.end = position;
+				section.complete = true;
+				return true;
+			}
+			else if (id!='B')
+			{
+				std::stringstream ss;
+				ss << "pxl::ChunkReader::readBlock(): Unknown char identifier: " << id;
+				throw std::runtime_error(ss.str());
+			}
+
+			section.blocks.push_back(ReadAheadBlock());
+			pending = true;
+			ReadAheadBlock& block = section.blocks.back();
+			block.view = 0;
+			block.viewSize = 0;
+
+			_stream.read((char *)&infoSize, 4);
+			block.info.resize(infoSize);
+			if (infoSize > 0)
+				_stream.read(&block.info[0], infoSize);
+
+			char compressionMode;
+			_stream.read(&compressionMode, 1);
+
+			uint32_t chunkSize = 0;
+			_stream.read((char *)&chunkSize, 4);
+
+			if (_stream.isBad() || _stream.isEof())
+				break;
+
+			if (compressionMode==' ')
+			{
+				block.view = _stream.readView(chunkSize);
+				block.viewSize = chunkSize;
+				if (block.view == 0)
+				{
+					block.data.resize(chunkSize);
+					_stream.read(&block.data[0], chunkSize);
+					if (_stream.isBad() || _stream.isEof() )
+						break;
+				}
+			}
+			else if (compressionMode=='Z' && _inflateThreads.empty())
+			{
+				unzipEventData(chunkSize, block.data);
+			}
+			else if (compressionMode=='Z' || compressionMode=='z'
+					|| compressionMode=='L' || compressionMode=='S')
+			{
+				block.compressionMode = compressionMode;
+				uint32_t payloadSize = chunkSize;
+				if (compressionMode!='Z')
+				{
+					if (chunkSize < 4)
+						throw std::runtime_error("pxl::ChunkReader::readBlock(): Invalid chunk size.");
+					_stream.read((char *)&block.uncompressedSize, 4);
+					payloadSize -= 4;
+				}
+
+				const char* payload = 0;
+				if (!readPayload(payloadSize, block.compressed, payload))
+					break;
+				block.compressedView = block.compressed.empty() ? payload : 0;
+				block.compressedSize = payloadSize;
+
+				if (_inflateThreads.empty())
+				{
+					if (compressionMode=='S' && _zstdContext == 0)
+						_zstdContext = createZstdContext();
+					decompressBuffer(compressionMode, payload, payloadSize,
+							block.uncompressedSize, block.data, _zstdContext,
+							_zstdDictionary);
+					std::vector<char>().swap(block.compressed);
+				}
+				else
+				{
+					// the block stays in place in the deque until the section is deleted
+					pthread_mutex_lock(&_inflateMutex);
+					block.inflated = false;
+					_inflateJobs.push_back(&block);
+					pthread_cond_signal(&_inflateWork);
+					pthread_mutex_unlock(&_inflateMutex);
+				}
+			}
+			else
+			{
+				throw std::runtime_error("pxl::ChunkReader::readBlock(): Invalid compression mode.");
+			}
+
+			position += 4 + infoSize + 1 + 4 + chunkSize;
+			block.end = position;
+			pending = false;
+		}
+	}
+	catch (std::exception& e)
+	{
+		section.error = e.what();
+	}
+
+	// drop a block which could not be read completely
+	if (pending)
+		section.blocks.pop_back();
+
+	return true;
+}
+
+ChunkReader::ReadAheadSection* ChunkReader::popReadAheadSection()
+{
+	ReadAheadSection* section = 0;
+
+	pthread_mutex_lock(&_readAheadMutex);
+	while (_readAheadQueue.empty() && !_readAheadFinished)
+		pthread_cond_wait(&_readAheadNotEmpty, &_readAheadMutex);
+	if (!_readAheadQueue.empty())
+	{
+		section = _readAheadQueue.front();
+		_readAheadQueue.pop_front();
+		pthread_cond_signal(&_readAheadNotFull);
+	}
+	pthread_mutex_unlock(&_readAheadMutex);
+
+	return section;
+}
+
+bool ChunkReader::readHeaderAhead(skipMode doSkip, infoMode checkInfo,
+		const std::string& infoCondition)
+{
+	++_sectionCount;
+
+	delete _currentSection;
+	_currentSection = popReadAheadSection();
+	_currentBlock = 0;
+
+	if (_currentSection == 0)
+		return false;
+
+	_sectionCount += _currentSection->skipped;
+
+	_status = preBlock;
+	_readAheadConsumed = _currentSection->headerEnd;
+	_sectionInfo = _currentSection->info;
+
+	if (checkInfo==evaluate && infoCondition!=_currentSection->info)
+	{
+		if (doSkip == on)
+		{
+			endEvent();
+			return readHeaderAhead(doSkip, checkInfo, infoCondition);
+		}
+		else
+			return false;
+	}
+
+	return true;
+}
+
+bool ChunkReader::readBlockAhead(skipMode skip, infoMode checkInfo,
+		const std::string& infoCondition)
+{
+	if (_status == preHeader || _currentSection == 0)
+		return false;
+
+	while (_currentBlock < _currentSection->blocks.size())
+	{
+		ReadAheadBlock& block = _currentSection->blocks[_currentBlock++];
+		_readAheadConsumed = block.end;
+		waitInflated(block);
+
+		if (checkInfo == evaluate && infoCondition != block.info)
+		{
+			if (skip == on)
+				continue;
+			else
+				return false;
+		}
+
+		_buffer.clear();
+		if (block.view)
+			_buffer.setView(block.view, block.viewSize);
+		else
+			_buffer.buffer.swap(block.data);
+		return true;
+	}
+
+	if (!_currentSection->error.empty())
+		throw std::runtime_error(_currentSection->error);
+
+	// a truncated section leaves the status unchanged, like the end of file does
+	if (_currentSection->complete)
+	{
+		_status = preHeader;
+		_readAheadConsumed = _currentSection->end;
+	}
+
+	return false;
+}
+
+}
@@ -8,6 +8,13 @@
 
 #include <stdexcept>
 #include <zlib.h>
+#ifdef PXL_ENABLE_LZ4
+#include <lz4.h>
+#include <lz4hc.h>
+#endif
+#ifdef PXL_ENABLE_ZSTD
+#include <zstd.h>
+#endif
 
 #include "Pxl/Pxl/interface/pxl/core/ChunkWriter.hh"
 
@@ -16,6 +23,12 @@ namespace pxl
 
 bool ChunkWriter::newFileSection(const std::string& info, char cSectionMarker)
 {
+	if (_index)
+	{
+		_sectionBegin = _stream.tell();
+		_sectionInfo = info;
+	}
+
 	_stream.write(&cSectionMarker, 1);
 	if (_stream.isBad())
 	{
@@ -42,6 +55,12 @@ bool ChunkWriter::endFileSection()
 	// end event marker:
 	writeFlag('e');
 	_stream.write((char* ) &_nBytes, 4);
+	if (_index)
+	{
+		_index->add(_sectionBegin, _nBytes + 4, _sectionInfo, _objectOffsets);
+		_objectOffsets.clear();
+		_sectionData = 0;
+	}
 	_nBytes=0;
 	if (_stream.isBad())
 	{
@@ -74,7 +93,9 @@ bool ChunkWriter::write(std::string info)
 	_nBytes+=lengthInfo;
 
 	// write out compression mode
-	char compressed = 'Z';
+	char compressed = _storeUncompressedSize ? 'z' : 'Z';
+	if (_algorithm == lz4Compression) compressed = 'L';
+	else if (_algorithm == zstdCompression) compressed = 'S';
 	if (_compressionMode == ' ') compressed = ' ';
 	_stream.write((char *) &compressed, 1);
 	_nBytes+=1;
@@ -93,6 +114,12 @@ bool ChunkWriter::write(std::string info)
 	{
 		// no compression requires no action...
 	}
+	else if (compressed == 'L' || compressed == 'S')
+	{
+		cZipSpace = compressBuffer(cBuffer, lengthBuffer, lengthZipSpace);
+		cZip = cZipSpace;
+		lengthZip = lengthZipSpace;
+	}
 	else if (_compressionMode >= '0' && _compressionMode <= '9')
 	{
 		// data compression a la Gero, i.e. compression level = 6:
@@ -122,14 +149,26 @@ bool ChunkWriter::write(std::string info)
 	else
 		throw std::runtime_error("pxl::FileChunkWriter::write(): Invalid compression mode.");
 
-	_stream.write((char *) &lengthZip, 4);
-	_nBytes+=4;
+	if (compressed != 'Z' && compressed != ' ')
+	{
+		// the chunk size covers the stored uncompressed size
+		int32_t lengthChunk = lengthZip + 4;
+		_stream.write((char *) &lengthChunk, 4);
+		_stream.write((char *) &lengthBuffer, 4);
+		_nBytes+=8;
+	}
+	else
+	{
+		_stream.write((char *) &lengthZip, 4);
+		_nBytes+=4;
+	}
 	_stream.write(cZip, lengthZip);
 	_nBytes+=lengthZip;
 
 	if (cZipSpace)
 		delete[] cZipSpace;
 
+	_sectionData += lengthBuffer;
 	_buffer.clear();
 
 	if (_stream.isBad())
@@ -139,4 +178,111 @@ bool ChunkWriter::write(std::string info)
 	return true;
 }
 
+void ChunkWriter::setCompression(compressionAlgorithm algorithm, int level)
+{
+	if (algorithm == zlibCompression)
+	{
+		setCompressionMode(level);
+		return;
+	}
+#ifndef PXL_ENABLE_LZ4
+	if (algorithm == lz4Compression)
+		throw std::runtime_error("pxl::ChunkWriter::setCompression(): PXL was compiled without PXL_ENABLE_LZ4.");
+#endif
+#ifndef PXL_ENABLE_ZSTD
+	if (algorithm == zstdCompression)
+		throw std::runtime_error("pxl::ChunkWriter::setCompression(): PXL was compiled without PXL_ENABLE_ZSTD.");
+#endif
+	_algorithm = algorithm;
+	_compressionLevel = level;
+	if (_compressionMode == ' ')
+		_compressionMode = '1';
+
+#ifdef PXL_ENABLE_ZSTD
+	// the dictionary is digested for a given level
+	ZSTD_freeCDict((ZSTD_CDict*) _zstdDictionary);
+	_zstdDictionary = 0;
+#endif
+}
+
+void ChunkWriter::setZstdDictionary(const std::string& dictionary)
+{
+#ifdef PXL_ENABLE_ZSTD
+	ZSTD_freeCDict((ZSTD_CDict*) _zstdDictionary);
+	_zstdDictionary = 0;
+	_zstdDictionaryData = dictionary;
+#else
+	if (!dictionary.empty())
+		throw std::runtime_error("pxl::ChunkWriter::setZstdDictionary(): PXL was compiled without PXL_ENABLE_ZSTD.");
+#endif
+}
+
+char* ChunkWriter::compressBuffer(const char* buffer, int32_t lengthBuffer,
+		unsigned long& length)
+{
+	char* output = 0;
+#ifdef PXL_ENABLE_LZ4
+	if (_algorithm == lz4Compression)
+	{
+		int capacity = LZ4_compressBound(lengthBuffer);
+		output = new char[capacity];
+		int result;
+		if (_compressionLevel > 0)
+			result = LZ4_compress_HC(buffer, output, lengthBuffer, capacity,
+					_compressionLevel);
+		else
+			result = LZ4_compress_default(buffer, output, lengthBuffer,
+					capacity);
+		if (result <= 0)
+		{
+			delete[] output;
+			throw std::runtime_error("pxl::ChunkWriter::write(): lz4: compression failed");
+		}
+		length = result;
+	}
+#endif
+#ifdef PXL_ENABLE_ZSTD
+	if (_algorithm == zstdCompression)
+	{
+		if (_zstdContext == 0)
+			_zstdContext = ZSTD_createCCtx();
+		if (_zstdDictionary == 0 && !_zstdDictionaryData.empty())
+			_zstdDictionary = ZSTD_createCDict(_zstdDictionaryData.data(),
+					_zstdDictionaryData.size(), _compressionLevel);
+
+		size_t capacity = ZSTD_compressBound(lengthBuffer);
+		output = new char[capacity];
+		size_t result;
+		if (_zstdDictionary)
+			result = ZSTD_compress_usingCDict((ZSTD_CCtx*) _zstdContext, output,
+					capacity, buffer, lengthBuffer,
+					(const ZSTD_CDict*) _zstdDictionary);
+		else
+			result = ZSTD_compressCCtx((ZSTD_CCtx*) _zstdContext, output,
+					capacity, buffer, lengthBuffer, _compressionLevel);
+		if (ZSTD_isError(result))
+		{
+			delete[] output;
+			throw std::runtime_error(
+					std::string("pxl::ChunkWriter::write(): zstd: ")
+							+ ZSTD_getErrorName(result));
+		}
+		length = result;
+	}
+#endif
+	if (output == 0)
+		throw std::runtime_error("pxl::ChunkWriter::write(): Invalid compression mode.");
+	return output;
+}
+
+void ChunkWriter::releaseZstd()
+{
+#ifdef PXL_ENABLE_ZSTD
+	ZSTD_freeCCtx((ZSTD_CCtx*) _zstdContext);
+	ZSTD_freeCDict((ZSTD_CDict*) _zstdDictionary);
+#endif
+	_zstdContext = 0;
+	_zstdDictionary = 0;
+}
+
 } //namespace pxl
@@ -9,6 +9,8 @@
 
 #include "Pxl/Pxl/interface/pxl/core/FileFactory.hh"
 #include "LocalFileImpl.hh"
+#include "MMapFileImpl.hh"
+#include "AsyncFileImpl.hh"
 
 #ifdef PXL_ENABLE_SFTP
 #include "sFTPFileImpl.hh"
@@ -22,19 +24,23 @@ namespace pxl
 
 static bool _initialized = false;
 
-static ObjectProducerTemplate<BasicContainer> _BasicContainerProducer;
-static ObjectProducerTemplate<BasicMatrix> _BasicMatrixProducer;
-static ObjectProducerTemplate<BasicNVector> _BasicNVectorProducer;
-static ObjectProducerTemplate<Event> _EventProducer;
-static ObjectProducerTemplate<InformationChunk> _InformationChunkProducer;
-static ObjectProducerTemplate<Object> _ObjectProducer;
-static ObjectProducerTemplate<ObjectManager> _ObjectManagerProducer;
+static NoInitObjectProducerTemplate<BasicContainer> _BasicContainerProducer;
+static NoInitObjectProducerTemplate<BasicMatrix> _BasicMatrixProducer;
+static NoInitObjectProducerTemplate<BasicNVector> _BasicNVectorProducer;
+static NoInitObjectProducerTemplate<Event> _EventProducer;
+static NoInitObjectProducerTemplate<InformationChunk> _InformationChunkProducer;
+static NoInitObjectProducerTemplate<Object> _ObjectProducer;
+static NoInitObjectProducerTemplate<ObjectManager> _ObjectManagerProducer;
 static FileProducerTemplate<LocalFileImpl> _LocalFileProducer;
+#ifndef _MSC_VER
+static FileProducerTemplate<MMapFileImpl> _MMapFileProducer;
+static FileProducerTemplate<AsyncFileImpl> _AsyncFileProducer;
+#endif
 #ifdef PXL_ENABLE_SFTP
-static FileProducerTemplate<sFTPFileImpl> _sFTPFileProducer;
+static BufferedFileProducerTemplate<sFTPFileImpl> _sFTPFileProducer;
 #endif
 #ifdef PXL_ENABLE_DCAP
-static FileProducerTemplate<dCapFileImpl> _dCapFileProducer;
+static BufferedFileProducerTemplate<dCapFileImpl> _dCapFileProducer;
 #endif
 void Core::initialize()
 {
@@ -48,7 +54,15 @@ void Core::initialize()
 	_InformationChunkProducer.initialize();
 	_ObjectProducer.initialize();
 	_ObjectManagerProducer.initialize();
+	ObjectFactory::instance().registerSkipFunction(Object::getStaticTypeId(),
+			&Object::skipSerialized);
+	ObjectFactory::instance().registerSkipFunction(
+			ObjectManager::getStaticTypeId(), &ObjectManager::skipSerialized);
 	_LocalFileProducer.initialize("local");
+#ifndef _MSC_VER
+	_MMapFileProducer.initialize("mmap");
+	_AsyncFileProducer.initialize("async");
+#endif
 #ifdef PXL_ENABLE_SFTP
 	_sFTPFileProducer.initialize("ssh");
 #endif
@@ -70,7 +84,14 @@ void Core::shutdown()
 	_InformationChunkProducer.shutdown();
 	_ObjectProducer.shutdown();
 	_ObjectManagerProducer.shutdown();
+	ObjectFactory::instance().unregisterSkipFunction(Object::getStaticTypeId());
+	ObjectFactory::instance().unregisterSkipFunction(
+			ObjectManager::getStaticTypeId());
 	_LocalFileProducer.shutdown();
+#ifndef _MSC_VER
+	_MMapFileProducer.shutdown();
+	_AsyncFileProducer.shutdown();
+#endif
 #ifdef PXL_ENABLE_SFTP
 	_sFTPFileProducer.shutdown();
 #endif
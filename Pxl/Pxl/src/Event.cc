@@ -21,6 +21,8 @@ void Event::serialize(const OutputStream &out) const
 void Event::deserialize(const InputStream &in)
 {
 	Serializable::deserialize(in);
+	// replaces the content, so that events can be read into the same object
+	clearObjects();
 	_objects.deserialize(in);
 	UserRecordHelper::deserialize(in);
 }
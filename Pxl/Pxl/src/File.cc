@@ -3,6 +3,8 @@
 #include "Pxl/Pxl/interface/pxl/core/FileFactory.hh"
 
 #include "LocalFileImpl.hh"
+#include "MMapFileImpl.hh"
+#include "AsyncFileImpl.hh"
 #ifdef PXL_ENABLE_SFTP
 #include "sFTPFileImpl.hh"
 #endif
@@ -108,6 +110,12 @@ void File::ignore(int64_t count)
 		throw std::runtime_error("invalid File implementation!");
 	impl->ignore(count);
 }
+const char *File::readView(size_t count)
+{
+	if (impl == 0)
+		throw std::runtime_error("invalid File implementation!");
+	return impl->readView(count);
+}
 void File::destroy()
 {
 	delete this;
@@ -131,7 +139,14 @@ bool File::open(const std::string &filename, int32_t mode)
 
 	if (isLocal)
 	{
-		impl = new LocalFileImpl();
+#ifndef _MSC_VER
+		if ((mode & OpenMapped) && (mode & OpenRead))
+			impl = new MMapFileImpl();
+		else if ((mode & OpenAsync) && (mode & OpenRead))
+			impl = new AsyncFileImpl();
+		else
+#endif
+			impl = new LocalFileImpl();
 	}
 	else
 	{
@@ -0,0 +1,143 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#include "Pxl/Pxl/interface/pxl/core/FileIndex.hh"
+#include "Pxl/Pxl/interface/pxl/core/File.hh"
+#include "Pxl/Pxl/interface/pxl/core/Stream.hh"
+#include "Pxl/Pxl/interface/pxl/core/logging.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#undef PXL_LOG_MODULE_NAME
+#define PXL_LOG_MODULE_NAME "pxl::FileIndex"
+
+namespace pxl
+{
+
+static const char* fileIndexTag = "pxlidx";
+/// Version 2 added the object offsets.
+static const uint32_t fileIndexVersion = 2;
+
+bool FileIndex::write(const std::string& filename) const
+{
+	BufferOutput buffer;
+	const OutputStream& out = buffer;
+	out.writeString(fileIndexTag);
+	out.write(fileIndexVersion);
+	out.write(_fileSize);
+	out.write((uint64_t) _entries.size());
+	for (std::vector<Entry>::const_iterator iter = _entries.begin();
+			iter != _entries.end(); ++iter)
+	{
+		out.write(iter->offset);
+		out.write(iter->size);
+		out.writeString(iter->info);
+		out.write((uint32_t) iter->objectOffsets.size());
+		for (std::vector<uint32_t>::const_iterator offset =
+				iter->objectOffsets.begin(); offset != iter->objectOffsets.end();
+				++offset)
+			out.write(*offset);
+	}
+
+	File file;
+	if (!file.open(filename, OpenWrite))
+	{
+		PXL_LOG_ERROR << "Cannot write index file " << filename;
+		return false;
+	}
+	if (!buffer.buffer.empty())
+		file.write(&buffer.buffer[0], buffer.buffer.size());
+	bool good = !file.isBad();
+	file.close();
+	return good;
+}
+
+bool FileIndex::read(const std::string& filename)
+{
+	clear();
+
+	File file;
+	if (!file.open(filename, OpenRead))
+		return false;
+
+	BufferInput buffer;
+	const InputStream& in = buffer;
+	file.seek(0, SeekEnd);
+	int64_t size = file.tell();
+	file.seek(0);
+	if (size <= 0)
+		return false;
+	buffer.buffer.resize(size);
+	if (file.read(&buffer.buffer[0], size) != size)
+		return false;
+	file.close();
+
+	try
+	{
+		std::string tag;
+		uint32_t version = 0;
+		in.readString(tag);
+		in.read(version);
+		if (tag != fileIndexTag || version < 1 || version > fileIndexVersion)
+		{
+			PXL_LOG_ERROR << "Unknown index format in " << filename;
+			return false;
+		}
+
+		uint64_t count = 0;
+		in.read(_fileSize);
+		in.read(count);
+		// every entry takes at least 16 bytes
+		if (count > buffer.available() / 16)
+			throw std::runtime_error("truncated index");
+		_entries.reserve(count);
+		for (uint64_t i = 0; i < count; ++i)
+		{
+			_entries.push_back(Entry());
+			Entry& entry = _entries.back();
+			in.read(entry.offset);
+			in.read(entry.size);
+			in.readString(entry.info);
+			if (version >= 2)
+			{
+				uint32_t objects = 0;
+				in.read(objects);
+				if (objects > buffer.available() / 4)
+					throw std::runtime_error("truncated index");
+				entry.objectOffsets.resize(objects);
+				for (uint32_t j = 0; j < objects; ++j)
+					in.read(entry.objectOffsets[j]);
+			}
+			addObjects(entry);
+		}
+	} catch (std::exception& e)
+	{
+		PXL_LOG_ERROR << "Corrupt index file " << filename;
+		clear();
+		return false;
+	}
+
+	return true;
+}
+
+bool FileIndex::findObject(uint64_t object, size_t& section,
+		uint32_t& offset) const
+{
+	if (!hasObjectOffsets() || object >= _objectCount)
+		return false;
+
+	// last section starting at or before the object
+	std::vector<uint64_t>::const_iterator first = std::upper_bound(
+			_firstObject.begin(), _firstObject.end(), object) - 1;
+	section = first - _firstObject.begin();
+	offset = _entries[section].objectOffsets[object - *first];
+	return true;
+}
+
+} //namespace pxl
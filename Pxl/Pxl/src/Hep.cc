@@ -14,12 +14,12 @@ namespace pxl
 
 static bool _initialized = false;
 
-static ObjectProducerTemplate<AnalysisFork> _AnalysisForkProducer;
-static ObjectProducerTemplate<AnalysisProcess> _AnalysisProcessProducer;
-static ObjectProducerTemplate<Collision> _CollisionProducer;
-static ObjectProducerTemplate<Particle> _ParticleProducer;
-static ObjectProducerTemplate<Vertex> _VertexProducer;
-static ObjectProducerTemplate<EventView> _EventViewProducer;
+static NoInitObjectProducerTemplate<AnalysisFork> _AnalysisForkProducer;
+static NoInitObjectProducerTemplate<AnalysisProcess> _AnalysisProcessProducer;
+static NoInitObjectProducerTemplate<Collision> _CollisionProducer;
+static NoInitObjectProducerTemplate<Particle> _ParticleProducer;
+static NoInitObjectProducerTemplate<Vertex> _VertexProducer;
+static NoInitObjectProducerTemplate<EventView> _EventViewProducer;
 
 void Hep::initialize()
 {
@@ -33,6 +33,17 @@ void Hep::initialize()
 	_VertexProducer.initialize();
 	_EventViewProducer.initialize();
 
+	// Collision and EventView add nothing to the layout of their base classes
+	ObjectFactory& factory = ObjectFactory::instance();
+	factory.registerSkipFunction(Collision::getStaticTypeId(),
+			&Object::skipSerialized);
+	factory.registerSkipFunction(Particle::getStaticTypeId(),
+			&Particle::skipSerialized);
+	factory.registerSkipFunction(Vertex::getStaticTypeId(),
+			&Vertex::skipSerialized);
+	factory.registerSkipFunction(EventView::getStaticTypeId(),
+			&ObjectManager::skipSerialized);
+
 	_initialized = true;
 }
 
@@ -48,6 +59,12 @@ void Hep::shutdown()
 	_VertexProducer.shutdown();
 	_EventViewProducer.shutdown();
 
+	ObjectFactory& factory = ObjectFactory::instance();
+	factory.unregisterSkipFunction(Collision::getStaticTypeId());
+	factory.unregisterSkipFunction(Particle::getStaticTypeId());
+	factory.unregisterSkipFunction(Vertex::getStaticTypeId());
+	factory.unregisterSkipFunction(EventView::getStaticTypeId());
+
 	_initialized = false;
 }
 
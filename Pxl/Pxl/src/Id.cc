@@ -8,8 +8,60 @@
 
 #include "Pxl/Pxl/interface/pxl/core/Id.hh"
 
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <stdint.h>
+
 namespace pxl {
 
+/// xorshift128+ state of the calling thread, 0 until it is seeded.
+static PXL_THREAD_LOCAL uint64_t _state0 = 0;
+static PXL_THREAD_LOCAL uint64_t _state1 = 0;
+
+static uint64_t splitMix(uint64_t& x)
+{
+	uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static void seedThread()
+{
+	uint64_t seed[2] =
+	{ 0, 0 };
+	bool success = false;
+	FILE* urandom = fopen("/dev/urandom", "rb");
+	if (urandom)
+	{
+		success = fread(seed, sizeof(seed), 1, urandom) == 1;
+		fclose(urandom);
+	}
+	if (!success)
+	{
+		// the address of the state differs between the threads
+		uint64_t x = (uint64_t) time(NULL) ^ ((uint64_t) clock() << 32)
+				^ (uint64_t) (size_t) &_state0;
+		seed[0] = splitMix(x);
+		seed[1] = splitMix(x);
+	}
+	if (seed[0] == 0 && seed[1] == 0)
+		seed[1] = 1;
+	_state0 = seed[0];
+	_state1 = seed[1];
+}
+
+static inline uint64_t nextRandom()
+{
+	uint64_t s1 = _state0;
+	const uint64_t s0 = _state1;
+	_state0 = s0;
+	s1 ^= s1 << 23;
+	_state1 = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+	return _state1 + s0;
+}
+
 Id::Id()
 {
 	generate();
@@ -37,6 +89,11 @@ void Id::generate(Random& rand)
 		bytes[i*4+3] = c[3];
 	}
 
+	setVersion();
+}
+
+void Id::setVersion()
+{
 	/* set version 4 (random)*/
 	bytes[7] &= ((1 << 4) - 1);
 	bytes[7] |= 4 << 4;
@@ -48,37 +105,30 @@ void Id::generate(Random& rand)
 
 void Id::generate()
 {
-	static Random rand;
-	generate(rand);
+	if (PXL_UNLIKELY(_state0 == 0 && _state1 == 0))
+		seedThread();
+
+	uint64_t value[2];
+	value[0] = nextRandom();
+	value[1] = nextRandom();
+	std::memcpy(bytes, value, 16);
+
+	setVersion();
 }
 
 Id Id::create()
 {
-	Id id;
-	id.generate();
-	return id;
+	return Id();
 }
 
 bool Id::operator ==(const Id& id) const
 {
-	for (int i = 0; i < 16; i++)
-	{
-		if (bytes[i] != id.bytes[i])
-			return false;
-	}
-
-	return true;
+	return std::memcmp(bytes, id.bytes, 16) == 0;
 }
 
 bool Id::operator !=(const Id& id) const
 {
-	for (int i = 0; i < 16; i++)
-	{
-		if (bytes[i] != id.bytes[i])
-			return true;
-	}
-
-	return false;
+	return std::memcmp(bytes, id.bytes, 16) != 0;
 }
 
 void Id::reset()
@@ -109,8 +159,7 @@ void Id::serialize(const OutputStream &out) const
 
 void Id::deserialize(const InputStream &in)
 {
-	for (size_t i = 0; i < 16; i++)
-		in.readUnsignedChar(bytes[i]);
+	in.readRaw(bytes, 16);
 }
 	
 Id::Id(const char* id)
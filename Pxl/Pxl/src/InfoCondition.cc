@@ -0,0 +1,77 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#include "Pxl/Pxl/interface/pxl/core/InfoCondition.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace pxl
+{
+
+bool SectionInfo::getValue(const std::string& info, const std::string& key,
+		std::string& value)
+{
+	size_t begin = 0;
+	while (begin < info.size())
+	{
+		size_t end = info.find(';', begin);
+		if (end == std::string::npos)
+			end = info.size();
+
+		if (end - begin > key.size() && info[begin + key.size()] == '='
+				&& info.compare(begin, key.size(), key) == 0)
+		{
+			size_t valueBegin = begin + key.size() + 1;
+			value.assign(info, valueBegin, end - valueBegin);
+			return true;
+		}
+		begin = end + 1;
+	}
+
+	return false;
+}
+
+void SectionInfo::addValue(std::string& info, const std::string& key,
+		const std::string& value)
+{
+	if (!info.empty())
+		info += ';';
+	info += key;
+	info += '=';
+	info += value;
+}
+
+InfoRegexCondition::InfoRegexCondition(const std::string& pattern)
+{
+	if (regcomp(&_regex, pattern.c_str(), REG_EXTENDED | REG_NOSUB) != 0)
+		throw std::runtime_error(
+				"pxl::InfoRegexCondition::InfoRegexCondition(): invalid regular expression "
+						+ pattern);
+}
+
+InfoRegexCondition::~InfoRegexCondition()
+{
+	regfree(&_regex);
+}
+
+bool InfoRegexCondition::operator()(const std::string& info) const
+{
+	return regexec(&_regex, info.c_str(), 0, 0, 0) == 0;
+}
+
+bool InfoValueCondition::operator()(const std::string& info) const
+{
+	std::string value;
+	if (!SectionInfo::getValue(info, _key, value))
+		return _acceptMissing;
+
+	return std::find(_values.begin(), _values.end(), value) != _values.end();
+}
+
+} //namespace pxl
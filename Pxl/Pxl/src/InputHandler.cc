@@ -125,6 +125,40 @@ Serializable* InputHandler::readNextObject()
 	return obj;
 }
 
+bool InputHandler::readNextEvent(Event& event)
+{
+	while (true)
+	{
+		while (!getChunkReader().getInputStream().good())
+		{
+			if (getChunkReader().getStatus() == ChunkReader::preHeader)
+			{
+				if (!getChunkReader().next())
+				{
+					return false;
+				}
+			}
+			getChunkReader().nextBlock();
+			if (getChunkReader().eof())
+				return false;
+		}
+
+		_objectCount++;
+
+		Id id(getChunkReader().getInputStream());
+		if (id == Event::getStaticTypeId())
+		{
+			event.deserialize(getChunkReader().getInputStream());
+			return true;
+		}
+		else if (!ObjectFactory::instance().skip(id,
+				getChunkReader().getInputStream()))
+			throw std::runtime_error(
+					"InputHandler::readNextEvent(): unknown object in file: "
+							+ id.toString());
+	}
+}
+
 Serializable* InputHandler::readPreviousObject() 
 {
 	return seekToObject(_objectCount - 1);
@@ -0,0 +1,252 @@
+#ifndef _MSC_VER
+
+#include "MMapFileImpl.hh"
+#include "Pxl/Pxl/interface/pxl/core/logging.hh"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+
+#undef PXL_LOG_MODULE_NAME
+#define PXL_LOG_MODULE_NAME "pxl::MMapFile"
+
+// size of the window ahead of the read position for which the kernel
+// is asked to fetch pages in advance
+#define PXL_MMAP_WILLNEED_WINDOW 8388608
+
+namespace pxl
+{
+
+MMapFileImpl::MMapFileImpl() :
+		_fd(-1), _data(0), _size(0), _position(0), _adviseEnd(0), _eof(
+				false), _mode(0)
+{
+
+}
+
+MMapFileImpl::MMapFileImpl(const std::string &filename, int32_t mode) :
+		_fd(-1), _data(0), _size(0), _position(0), _adviseEnd(0), _eof(
+				false), _mode(0)
+{
+	open(filename, mode);
+}
+
+MMapFileImpl::~MMapFileImpl()
+{
+	close();
+}
+
+bool MMapFileImpl::open(const std::string &filename, int32_t mode)
+{
+	close();
+	_mode = mode;
+
+	if ((mode & OpenRead) == 0)
+	{
+		PXL_LOG_ERROR << "Memory mapped files can only be opened for reading: "
+				<< filename;
+		return false;
+	}
+
+	// accept both plain paths and mmap:// urls
+	std::string path = filename;
+	if (path.compare(0, 5, "mmap:") == 0)
+	{
+		path.erase(0, 5);
+		if (path.compare(0, 2, "//") == 0)
+			path.erase(0, 2);
+	}
+
+	_fd = ::open(path.c_str(), O_RDONLY);
+	if (_fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(_fd, &st) != 0)
+	{
+		close();
+		return false;
+	}
+	_size = st.st_size;
+
+	// mmap does not accept empty mappings, an empty file is simply at eof
+	if (_size > 0)
+	{
+		void *data = mmap(0, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+		if (data == MAP_FAILED)
+		{
+			const char *reason = strerror(errno);
+			PXL_LOG_ERROR << "Unable to map file " << path << ": " << reason;
+			close();
+			return false;
+		}
+		_data = (const char *) data;
+		madvise(data, _size, MADV_SEQUENTIAL);
+		adviseWillNeed();
+	}
+
+	return true;
+}
+
+void MMapFileImpl::close()
+{
+	if (_data)
+		munmap((void *) _data, _size);
+	if (_fd >= 0)
+		::close(_fd);
+	_fd = -1;
+	_data = 0;
+	_size = 0;
+	_position = 0;
+	_adviseEnd = 0;
+	_eof = false;
+}
+
+void MMapFileImpl::adviseWillNeed()
+{
+	// only renew the hint once half of the previous window is consumed
+	if (_data == 0 || _adviseEnd >= _size
+			|| _position + PXL_MMAP_WILLNEED_WINDOW / 2 < _adviseEnd)
+		return;
+
+	long pageSize = sysconf(_SC_PAGESIZE);
+	int64_t begin = (_position / pageSize) * pageSize;
+	int64_t end = _position + PXL_MMAP_WILLNEED_WINDOW;
+	if (end > _size)
+		end = _size;
+	if (begin >= end)
+		return;
+
+	madvise((void *) (_data + begin), end - begin, MADV_WILLNEED);
+	_adviseEnd = end;
+}
+
+bool MMapFileImpl::isEof()
+{
+	if (_fd < 0)
+		return true;
+
+	return _eof;
+}
+
+bool MMapFileImpl::isOpen()
+{
+	return (_fd >= 0);
+}
+
+bool MMapFileImpl::isBad()
+{
+	if (_fd < 0)
+		return true;
+
+	return false;
+}
+
+void MMapFileImpl::clear()
+{
+	_eof = false;
+}
+
+bool MMapFileImpl::isGood()
+{
+	if (_fd < 0)
+		return false;
+
+	return !_eof;
+}
+
+int64_t MMapFileImpl::tell()
+{
+	if (_fd < 0)
+		return 0;
+
+	return _position;
+}
+
+void MMapFileImpl::seek(int64_t pos, int32_t d)
+{
+	int64_t newPosition;
+	if (d == SeekBegin)
+		newPosition = pos;
+	else if (d == SeekCurrent)
+		newPosition = _position + pos;
+	else if (d == SeekEnd)
+		newPosition = _size + pos;
+	else
+		throw std::runtime_error("Uninitialized value in MMapFileImpl::seek. This never should happen!.");
+
+	// like fseek, a successful seek clears the eof state and
+	// positions beyond the end of the file are allowed
+	if (newPosition < 0)
+		return;
+	_position = newPosition;
+	_eof = false;
+	adviseWillNeed();
+}
+
+int32_t MMapFileImpl::peek()
+{
+	if (_position >= _size)
+	{
+		_eof = true;
+		return EOF;
+	}
+
+	return (unsigned char) _data[_position];
+}
+
+int64_t MMapFileImpl::read(char *s, size_t count)
+{
+	int64_t available = _size - _position;
+	if (available <= 0)
+	{
+		_eof = true;
+		return 0;
+	}
+
+	if ((int64_t) count > available)
+	{
+		count = available;
+		_eof = true;
+	}
+
+	memcpy(s, _data + _position, count);
+	_position += count;
+	adviseWillNeed();
+	return count;
+}
+
+int64_t MMapFileImpl::write(const char *s, size_t count)
+{
+	return 0;
+}
+
+void MMapFileImpl::ignore(int64_t count)
+{
+	seek(count, SeekCurrent);
+}
+
+const char *MMapFileImpl::readView(size_t count)
+{
+	if (_data == 0 || _position + (int64_t) count > _size)
+		return 0;
+
+	const char *view = _data + _position;
+	_position += count;
+	adviseWillNeed();
+	return view;
+}
+
+void MMapFileImpl::destroy()
+{
+	delete this;
+}
+
+}
+
+#endif
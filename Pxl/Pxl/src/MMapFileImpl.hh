@@ -0,0 +1,53 @@
+#ifndef PXL_MMAP_FILE_IMPL_HH_
+#define PXL_MMAP_FILE_IMPL_HH_
+
+#include "Pxl/Pxl/interface/pxl/core/macros.hh"
+#include "Pxl/Pxl/interface/pxl/core/File.hh"
+
+namespace pxl
+{
+
+/// Read-only file implementation which maps the whole file into memory.
+/// Reads, peeks and skips are served from the mapping without system calls,
+/// and readView() hands out pointers into the mapping, so that uncompressed
+/// blocks can be deserialized without copying them.
+class PXL_DLL_EXPORT MMapFileImpl: public FileImpl
+{
+	int _fd;
+	const char *_data;
+	int64_t _size;
+	int64_t _position;
+	int64_t _adviseEnd;
+	bool _eof;
+	int32_t _mode;
+
+	void adviseWillNeed();
+
+public:
+
+	MMapFileImpl();
+
+	MMapFileImpl(const std::string &filename, int32_t mode);
+
+	~MMapFileImpl();
+
+	virtual bool open(const std::string &filename, int32_t mode);
+	virtual void close();
+	virtual bool isEof();
+	virtual bool isOpen();
+	virtual bool isBad();
+	virtual void clear();
+	virtual bool isGood();
+	virtual int64_t tell();
+	virtual void seek(int64_t pos, int32_t d);
+	virtual int32_t peek();
+	virtual int64_t read(char *s, size_t count);
+	virtual int64_t write(const char *s, size_t count);
+	virtual void ignore(int64_t count);
+	virtual const char *readView(size_t count);
+	virtual void destroy();
+};
+
+} // namespace pxl
+
+#endif /* PXL_MMAP_FILE_IMPL_HH_ */
@@ -27,6 +27,14 @@ void Object::deserialize(const InputStream &in)
 	UserRecordHelper::deserialize(in);
 }
 
+void Object::skipSerialized(const InputStream &in)
+{
+	Relative::skipSerialized(in);
+	// locked, workflag
+	in.skipRaw(5);
+	UserRecordHelper::skipSerialized(in);
+}
+
 }
 std::ostream& pxl::Object::print(int level, std::ostream& os, int pan) const
 {
@@ -0,0 +1,190 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#include "Pxl/Pxl/interface/pxl/core/ObjectArena.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace pxl
+{
+
+/// Precedes every allocation, chunk is 0 for heap allocations.
+/// The union keeps the objects behind it aligned.
+union AllocationHeader
+{
+	void* chunk;
+	long double align;
+};
+
+static const size_t _headerSize = sizeof(AllocationHeader);
+
+static inline size_t alignedSize(size_t size)
+{
+	return (size + _headerSize - 1) / _headerSize * _headerSize;
+}
+
+static PXL_THREAD_LOCAL ObjectArena* _currentArena = 0;
+
+ObjectArena::Scope::Scope(ObjectArena* arena) :
+		_previous(_currentArena)
+{
+	_currentArena = arena;
+}
+
+ObjectArena::Scope::~Scope()
+{
+	_currentArena = _previous;
+}
+
+ObjectArena* ObjectArena::current()
+{
+	return _currentArena;
+}
+
+ObjectArena::ObjectArena(size_t chunkSize) :
+		_chunkSize(alignedSize(std::max(chunkSize, (size_t) 4096))), _current(
+				0), _objectCount(0), _released(false)
+{
+}
+
+ObjectArena::~ObjectArena()
+{
+	for (size_t i = 0; i < _chunks.size(); i++)
+	{
+		std::free(_chunks[i]->data);
+		delete _chunks[i];
+	}
+	for (size_t i = 0; i < _retired.size(); i++)
+	{
+		std::free(_retired[i]->data);
+		delete _retired[i];
+	}
+}
+
+void* ObjectArena::allocate(size_t size)
+{
+	ObjectArena* arena = _currentArena;
+	// large objects would waste most of a chunk
+	if (arena && size <= arena->_chunkSize / 8)
+		return arena->allocateInChunk(size);
+
+	AllocationHeader* header = static_cast<AllocationHeader*>(std::malloc(
+			_headerSize + size));
+	if (!header)
+		throw std::bad_alloc();
+	header->chunk = 0;
+	return header + 1;
+}
+
+void* ObjectArena::allocateInChunk(size_t size)
+{
+	size_t needed = _headerSize + alignedSize(size);
+	while (_current < _chunks.size()
+			&& _chunks[_current]->used + needed > _chunkSize)
+		_current++;
+
+	if (_current == _chunks.size())
+	{
+		Chunk* chunk = new Chunk();
+		chunk->arena = this;
+		chunk->data = static_cast<char*>(std::malloc(_chunkSize));
+		if (!chunk->data)
+		{
+			delete chunk;
+			throw std::bad_alloc();
+		}
+		chunk->used = 0;
+		chunk->objectCount = 0;
+		chunk->retired = false;
+		_chunks.push_back(chunk);
+	}
+
+	Chunk* chunk = _chunks[_current];
+	AllocationHeader* header =
+			reinterpret_cast<AllocationHeader*>(chunk->data + chunk->used);
+	header->chunk = chunk;
+	chunk->used += needed;
+	chunk->objectCount++;
+	_objectCount++;
+	return header + 1;
+}
+
+void ObjectArena::deallocate(void* p)
+{
+	if (!p)
+		return;
+
+	AllocationHeader* header = static_cast<AllocationHeader*>(p) - 1;
+	Chunk* chunk = static_cast<Chunk*>(header->chunk);
+	if (!chunk)
+	{
+		std::free(header);
+		return;
+	}
+
+	// the memory is reused with the next reset()
+	ObjectArena* arena = chunk->arena;
+	chunk->objectCount--;
+	arena->_objectCount--;
+	if (arena->_released && arena->_objectCount == 0)
+		delete arena;
+	else if (chunk->retired && chunk->objectCount == 0)
+		arena->freeChunk(chunk);
+}
+
+void ObjectArena::freeChunk(Chunk* chunk)
+{
+	_retired.erase(std::find(_retired.begin(), _retired.end(), chunk));
+	std::free(chunk->data);
+	delete chunk;
+}
+
+void ObjectArena::reset()
+{
+	size_t kept = 0;
+	for (size_t i = 0; i < _chunks.size(); i++)
+	{
+		Chunk* chunk = _chunks[i];
+		if (chunk->objectCount == 0)
+		{
+			chunk->used = 0;
+			_chunks[kept++] = chunk;
+		}
+		else
+		{
+			chunk->retired = true;
+			_retired.push_back(chunk);
+		}
+	}
+	_chunks.resize(kept);
+	_current = 0;
+}
+
+void ObjectArena::release()
+{
+	if (_objectCount == 0)
+	{
+		delete this;
+		return;
+	}
+
+	_released = true;
+	reset();
+	// the arena stays until its last object is deleted, but its chunks
+	// without objects are not needed anymore
+	for (size_t i = 0; i < _chunks.size(); i++)
+	{
+		std::free(_chunks[i]->data);
+		delete _chunks[i];
+	}
+	_chunks.clear();
+}
+
+} // namespace pxl
@@ -15,7 +15,13 @@
 namespace pxl
 {
 
-ObjectFactory::ObjectFactory()
+/// Entry of the type the calling thread created last, and the generation of
+/// the producers it belongs to.
+static PXL_THREAD_LOCAL const ObjectFactory::ProducerMap::Entry* _lastProducer = 0;
+static PXL_THREAD_LOCAL unsigned long _lastGeneration = 0;
+
+ObjectFactory::ObjectFactory() :
+		_generation(1)
 {
 }
 
@@ -27,12 +33,35 @@ ObjectFactory& ObjectFactory::instance()
 
 Serializable *ObjectFactory::create(const Id& id)
 {
-	std::map<Id, const ObjectProducerInterface *>::iterator result;
-	result = _Producers.find(id);
-	if (result == _Producers.end())
-		return 0;
-	else
-		return (*result).second->create();
+	// consecutive objects mostly have the same type
+	const ProducerMap::Entry* entry = _lastProducer;
+	if (!entry || _lastGeneration != _generation || entry->first != id)
+	{
+		ProducerMap::const_iterator result = _Producers.find(id);
+		if (result == _Producers.end())
+			return 0;
+		entry = &*result;
+		_lastProducer = entry;
+		_lastGeneration = _generation;
+	}
+	return entry->second->create(NoInit());
+}
+
+bool ObjectFactory::skip(const Id& id, const InputStream& in)
+{
+	SkipFunction function = _skipFunctions.get(id);
+	if (function)
+	{
+		function(in);
+		return true;
+	}
+
+	Serializable* obj = create(id);
+	if (obj == 0)
+		return false;
+	obj->deserialize(in);
+	delete obj;
+	return true;
 }
 
 void ObjectFactory::registerProducer(const Id& id,
@@ -40,21 +69,33 @@ void ObjectFactory::registerProducer(const Id& id,
 {
 	PXL_LOG_INFO << "register object producer for " << id;
 	_Producers[id] = producer;
+	_generation++;
 }
 
 void ObjectFactory::unregisterProducer(const ObjectProducerInterface* producer)
 {
-	std::map<Id, const ObjectProducerInterface *>::iterator i;
-	for (i = _Producers.begin(); i != _Producers.end(); i++)
+	for (ProducerMap::const_iterator i = _Producers.begin();
+			i != _Producers.end(); i++)
 	{
 		if (i->second == producer)
 		{
 			PXL_LOG_INFO << "unregister object producer for " << i->first;
-			_Producers.erase(i);
+			_Producers.erase(i->first);
+			_generation++;
 			return;
 		}
 	}
 }
 
+void ObjectFactory::registerSkipFunction(const Id& id, SkipFunction function)
+{
+	_skipFunctions[id] = function;
+}
+
+void ObjectFactory::unregisterSkipFunction(const Id& id)
+{
+	_skipFunctions.erase(id);
+}
+
 } // namespace pxl
 
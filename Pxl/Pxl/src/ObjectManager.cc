@@ -9,3 +9,51 @@
 #include "Pxl/Pxl/interface/pxl/core/ObjectManager.hh"
 
 
+
+namespace pxl
+{
+
+void ObjectManager::serialize(const OutputStream &out) const
+{
+	Object::serialize(out);
+	if (_deferredContent.empty())
+		_objects.serialize(out);
+	else
+		out.write(&_deferredContent[0], _deferredContent.size());
+}
+
+void ObjectManager::deserialize(const InputStream &in)
+{
+	Object::deserialize(in);
+
+	decodeContent();
+	const char* begin = in.getCursor();
+	if (begin && in.isContentDeferred(getName()))
+	{
+		ObjectOwner::skipSerialized(in);
+		_deferredContent.assign(begin, in.getCursor());
+		_lazyUserRecords = in.hasLazyUserRecords();
+	}
+	else
+		_objects.deserialize(in);
+}
+
+void ObjectManager::skipSerialized(const InputStream &in)
+{
+	Object::skipSerialized(in);
+	ObjectOwner::skipSerialized(in);
+}
+
+void ObjectManager::decodeDeferredContent() const
+{
+	std::vector<char> content;
+	content.swap(_deferredContent);
+
+	BufferInput in;
+	in.setView(&content[0], content.size());
+	in.setLazyUserRecords(_lazyUserRecords);
+	// the objects are part of the logical state, which is not changed
+	const_cast<ObjectOwner&>(_objects).deserialize(in);
+}
+
+} // namespace pxl
@@ -7,6 +7,7 @@
 //-------------------------------------------
 
 #include <iostream>
+#include <stdexcept>
 
 #include "Pxl/Pxl/interface/pxl/core/Relative.hh"
 #include "Pxl/Pxl/interface/pxl/core/ObjectOwner.hh"
@@ -20,81 +21,151 @@
 namespace pxl
 {
 
-void ObjectOwner::init(const ObjectOwner& original)
+static const size_t npos = (size_t) -1;
+
+/// Positions of the objects of a container, found by their address.
+class PositionMap
 {
-	// copy objects: loop in STL style
-	for (const_iterator iter = original._container.begin(); iter
-			!= original._container.end(); iter++)
+public:
+	explicit PositionMap(const std::vector<Relative*>& objects)
 	{
+		size_t capacity = 16;
+		while (capacity < 2 * objects.size())
+			capacity *= 2;
+		_mask = capacity - 1;
+		_slots.resize(capacity);
+		for (size_t i = 0; i < objects.size(); i++)
+		{
+			size_t pos = hash(objects[i]) & _mask;
+			while (_slots[pos].object)
+				pos = (pos + 1) & _mask;
+			_slots[pos].object = objects[i];
+			_slots[pos].position = i;
+		}
+	}
 
-		Relative* pOld = *iter;
-		Relative* pNew = dynamic_cast<Relative*>(pOld->clone());
+	/// Returns the position of \p object, or npos if it is not in the
+	/// container.
+	size_t find(const Relative* object) const
+	{
+		for (size_t pos = hash(object) & _mask;; pos = (pos + 1) & _mask)
+		{
+			if (_slots[pos].object == object)
+				return _slots[pos].position;
+			if (!_slots[pos].object)
+				return npos;
+		}
+	}
 
-		insert(pNew);
+private:
+	struct Slot
+	{
+		Slot() :
+			object(0), position(0)
+		{
+		}
+		const Relative* object;
+		size_t position;
+	};
 
-		std::map<Id, Relative*>::iterator insertPos =
-				_copyHistory.lower_bound(pOld->id());
-		if (insertPos == _copyHistory.end() || insertPos->first != pOld->id())
-			_copyHistory.insert(insertPos,
-					std::map<Id, Relative*>::iterator::value_type(pOld->id(), pNew));
-		else
-			insertPos->second = pNew;
+	static size_t hash(const Relative* object)
+	{
+		return (size_t) (((uint64_t) (size_t) object * 0x9E3779B97F4A7C15ULL)
+				>> 32);
 	}
 
-	// FIXME: possibly inefficient, might be done all in one loop
-	// redirect relations: loop in PTL style
-	for (const_iterator iter = original._container.begin(); iter
-			!=original._container.end(); iter++)
+	std::vector<Slot> _slots;
+	size_t _mask;
+};
+
+void ObjectOwner::init(const ObjectOwner& original)
+{
+	// the copies are found by the position of their original in the
+	// container, the copy history is only built when it is used
+	const std::vector<Relative*>& originals = original._container;
+	PositionMap positions(originals);
+
+	std::vector<Relative*> copies(originals.size());
+	_container.reserve(_container.size() + originals.size());
+	_copies.reserve(_copies.size() + originals.size());
+	bool foreignRelations = false;
+	for (size_t i = 0; i < originals.size(); i++)
 	{
-		Relative* pOld = *iter;
-		Relative* pNew = 0;
-		std::map<Id, Relative*>::const_iterator found = _copyHistory.find(pOld->id());
-		if (found != _copyHistory.end())
-			pNew = found->second;
-
-		// mother relations
-		for (Relations::const_iterator iter = pOld->getMotherRelations().begin(); iter!=pOld->getMotherRelations().end(); ++iter)
+		Relative* pOld = originals[i];
+		Relative* pNew = dynamic_cast<Relative*>(pOld->clone());
+
+		insert(pNew);
+		copies[i] = pNew;
+		_copies.push_back(std::pair<Id, Relative*>(pOld->id(), pNew));
+
+		// link the copies made so far, the following ones link this one
+		const Relations& mothers = pOld->getMotherRelations();
+		for (Relations::const_iterator iter = mothers.begin(); iter
+				!= mothers.end(); ++iter)
+		{
+			size_t position = positions.find(*iter);
+			if (position == npos)
+				foreignRelations = true;
+			else if (position <= i)
+				pNew->linkMother(copies[position]);
+		}
+
+		const Relations& daughters = pOld->getDaughterRelations();
+		for (Relations::const_iterator iter = daughters.begin(); iter
+				!= daughters.end(); ++iter)
 		{
-			Relative* pOldRel = *iter;
-			Relative* pNewRel = 0;
-			std::map<Id, Relative*>::const_iterator foundRel =
-					_copyHistory.find(pOldRel->id());
-			if (foundRel != _copyHistory.end())
-				pNewRel = foundRel->second;
-
-			if (pOldRel)
-			{
-				if (pNewRel)
-					pNew->linkMother(pNewRel);
-				else
-					PXL_LOG_WARNING << "ObjectOwner::init(const ObjectOwner&): WARNING: some original objects had relations to objects of other owners.";
-
-			}
-			else
-				PXL_LOG_WARNING << "ObjectOwner::init(const ObjectOwner&): WARNING: some originally related objects no longer exist.";
+			size_t position = positions.find(*iter);
+			if (position < i)
+				pNew->linkDaughter(copies[position]);
 		}
+	}
 
-		// daughter relations
-		// have been set automatically above
+	if (foreignRelations)
+	{
+		PXL_LOG_WARNING << "ObjectOwner::init(const ObjectOwner&): WARNING: some original objects had relations to objects of other owners.";
 	}
 
 	// redirect index:
 	for (std::map<std::string, Relative*>::const_iterator iter = original._index.begin(); iter
 			!=original._index.end(); ++iter)
 	{
+		size_t position = positions.find(iter->second);
+		if (position != npos)
+			_index.insert(_index.end(),
+					std::map<std::string, Relative*>::value_type(iter->first,
+							copies[position]));
+		else
+			PXL_LOG_WARNING << "pxl::ObjectOwner::ObjectOwner(...): WARNING: some original indices pointed to objects of other owners.";
+	}
+}
 
-		Relative* pOld = iter->second;
+void ObjectOwner::fillCopyHistory() const
+{
+	for (size_t i = 0; i < _copies.size(); i++)
+		_copyHistory[_copies[i].first] = _copies[i].second;
+	_copies.clear();
+}
 
-		Relative* pNew = 0;
-		std::map<Id, Relative*>::const_iterator found = _copyHistory.find(pOld->id());
-		if (found != _copyHistory.end())
-			pNew = found->second;
+void ObjectOwner::eraseCopy(const Relative* item)
+{
+	for (size_t i = 0; i < _copies.size(); i++)
+	{
+		if (_copies[i].second == item)
+		{
+			_copies[i] = _copies.back();
+			_copies.pop_back();
+			return; // multiple occurrences *not* possible!
+		}
+	}
 
-		if (pNew)
-			_index.insert(std::map<std::string, Relative*>::const_iterator::value_type(iter->first,
-					pNew));
-		else
-			PXL_LOG_WARNING << "pxl::ObjectOwner::ObjectOwner(...): WARNING: some original indices pointed to objects of other owners.";
+	for (IdMap<Relative*>::const_iterator iter = _copyHistory.begin(); iter
+			!= _copyHistory.end(); iter++)
+	{
+		if (item == iter->second)
+		{
+			_copyHistory.erase(iter->first);
+			return;
+		}
 	}
 }
 
@@ -107,8 +178,49 @@ void ObjectOwner::clearContainer()
 	}
 	_container.clear();
 	_copyHistory.clear();
+	_copies.clear();
 	_index.clear();
 	_uuidSearchMap.clear();
+	_types.clear();
+}
+
+void ObjectOwner::addToType(Relative* item, const std::type_info& type)
+{
+	for (size_t i = 0; i < _types.size(); i++)
+	{
+		if (*_types[i].type == type)
+		{
+			_types[i].objects.push_back(item);
+			return;
+		}
+	}
+
+	_types.push_back(TypeObjects());
+	_types.back().type = &type;
+	_types.back().objects.push_back(item);
+}
+
+void ObjectOwner::removeFromType(Relative* item)
+{
+	const std::type_info& type = typeid(*item);
+	for (size_t i = 0; i < _types.size(); i++)
+	{
+		if (*_types[i].type != type)
+			continue;
+
+		std::vector<Relative*>& objects = _types[i].objects;
+		objects.erase(std::find(objects.begin(), objects.end(), item));
+		// the slot is kept when it is empty, type iterators refer to it
+		return;
+	}
+}
+
+void ObjectOwner::sortTypes()
+{
+	for (size_t i = 0; i < _types.size(); i++)
+		_types[i].objects.clear();
+	for (const_iterator iter = _container.begin(); iter != _container.end(); ++iter)
+		addToType(*iter, typeid(**iter));
 }
 
 void ObjectOwner::insert(Relative* item) 
@@ -119,7 +231,8 @@ void ObjectOwner::insert(Relative* item)
 		throw std::runtime_error("Error in ObjectOwner::set: Object already has another object owner.");
 	item->_refObjectOwner = this;
 	_container.push_back(item);
-	_uuidSearchMap.insert(std::pair<Id, Relative*>(item->getId(), item));
+	_uuidSearchMap.insert(item->getId(), item);
+	addToType(item, typeid(*item));
 }
 
 void ObjectOwner::remove(Relative* item)
@@ -138,19 +251,10 @@ void ObjectOwner::remove(Relative* item)
 	}
 
 	// search & remove possible copy history
-	for (std::map<Id, Relative*>::const_iterator iter = _copyHistory.begin(); iter
-	!= _copyHistory.end(); iter++)
-	{
-
-		// FIXME: inefficient
-		if (item == iter->second)
-		{
-			_copyHistory.erase(iter->first);
-			break; // multiple occurrences *not* possible!
-		}
-	}
+	eraseCopy(item);
 
 	_uuidSearchMap.erase(item->getId());
+	removeFromType(item);
 
 	item->_refObjectOwner = 0;
 	for (iterator iter = _container.begin(); iter != _container.end(); iter++)
@@ -182,17 +286,10 @@ void ObjectOwner::take(Relative* item)
 	}
 
 	// search & remove possible copy history
-	for (std::map<Id, Relative*>::const_iterator iter = _copyHistory.begin(); iter
-	!= _copyHistory.end(); iter++)
-	{
-		if (item == iter->second)
-		{
-			_copyHistory.erase(iter->first);
-			break; // multiple occurrences *not* possible!
-		}
-	}
+	eraseCopy(item);
 
 	_uuidSearchMap.erase(item->getId());
+	removeFromType(item);
 
 	item->_refObjectOwner=0;
 	for (iterator iter = _container.begin(); iter != _container.end(); iter++)
@@ -280,7 +377,8 @@ void ObjectOwner::deserialize(const InputStream &in)
 	 * no error handling at the moment
 	 */
 
-	std::map<Id, Relative*> objIdMap;
+	ObjectArena::Scope scope(_arena);
+	IdMap<Relative*> objIdMap;
 	std::multimap<Relative*, Id> daughterRelationsMap;
 	std::multimap<Relative*, Id> motherRelationsMap;
 	std::multimap<Relative*, Id> flatRelationsMap;
@@ -294,7 +392,7 @@ void ObjectOwner::deserialize(const InputStream &in)
 		Relative* object = dynamic_cast<Relative*>(ObjectFactory::instance().create(typeId));
 		object->deserialize(in);
 		insert(object);
-		objIdMap.insert(std::pair<Id, Relative*>(object->id(), object));
+		objIdMap.insert(object->id(), object);
 
 		int msize = 0;
 		in.readInt(msize);
@@ -346,4 +444,34 @@ void ObjectOwner::deserialize(const InputStream &in)
 	}
 }
 
+void ObjectOwner::skipSerialized(const InputStream &in)
+{
+	unsigned int size = 0;
+	in.readUnsignedInt(size);
+	for (unsigned int i=0; i<size; ++i)
+	{
+		Id typeId (in);
+		if (!ObjectFactory::instance().skip(typeId, in))
+			throw std::runtime_error(
+					"pxl::ObjectOwner::skipSerialized(): unknown object "
+							+ typeId.toString());
+
+		// mother, daughter and flat relations
+		for (int j=0; j<3; ++j)
+		{
+			int rsize = 0;
+			in.readInt(rsize);
+			in.skipRaw(16 * rsize);
+		}
+	}
+
+	// index
+	in.readUnsignedInt(size);
+	for (unsigned int i=0; i<size; ++i)
+	{
+		in.skipString();
+		in.skipRaw(16);
+	}
+}
+
 } // namespace pxl
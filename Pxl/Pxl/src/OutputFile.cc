@@ -15,7 +15,7 @@ namespace pxl
 OutputFile::OutputFile(const std::string& filename, size_t maxBlockSize,
 		size_t maxNObjects) :
 		OutputHandler(maxBlockSize, maxNObjects), _stream(filename, OpenWrite), _writer(
-				_stream)
+				_stream), _filename(filename), _writeIndex(false)
 {
 	if (_stream.isGood() == false)
 		throw std::runtime_error(
@@ -30,6 +30,8 @@ OutputFile::~OutputFile()
 void OutputFile::open(const std::string& filename)
 {
 	_stream.open(filename.c_str(), OpenWrite);
+	_filename = filename;
+	_index.clear();
 	if (_stream.isGood() == false)
 		throw std::runtime_error(
 				"OutputFile: " + filename + " could not be opened.");
@@ -38,7 +40,15 @@ void OutputFile::open(const std::string& filename)
 void OutputFile::close()
 {
 	finish();
-	_stream.close();
+	if (_writeIndex && _stream.isOpen())
+	{
+		_index.setFileSize(_stream.tell());
+		_stream.close();
+		_index.write(FileIndex::getIndexFileName(_filename));
+		_index.clear();
+	}
+	else
+		_stream.close();
 }
 
 ChunkWriter& OutputFile::getChunkWriter()
@@ -51,8 +61,33 @@ void OutputFile::setCompressionMode(int compressionMode)
 	_writer.setCompressionMode(compressionMode);
 }
 
+void OutputFile::setStoreUncompressedSize(bool store)
+{
+	_writer.setStoreUncompressedSize(store);
+}
+
+void OutputFile::setCompression(ChunkWriter::compressionAlgorithm algorithm,
+		int level)
+{
+	_writer.setCompression(algorithm, level);
+}
+
+void OutputFile::setZstdDictionary(const std::string& dictionary)
+{
+	_writer.setZstdDictionary(dictionary);
+}
+
+void OutputFile::setWriteIndex(bool write)
+{
+	if (write && _stream.isOpen() && _stream.tell() != 0)
+		throw std::runtime_error(
+				"pxl::OutputFile::setWriteIndex(): file sections already written");
+	_writeIndex = write;
+	_writer.setIndex(write ? &_index : 0);
+}
+
 OutputFile::OutputFile(const OutputFile& original) :
-		_stream(), _writer(_stream)
+		_stream(), _writer(_stream), _writeIndex(false)
 {
 }
 
@@ -8,6 +8,7 @@
 
 #include "Pxl/Pxl/interface/pxl/core/OutputHandler.hh"
 #include "Pxl/Pxl/interface/pxl/core/Id.hh"
+#include "Pxl/Pxl/interface/pxl/core/InfoCondition.hh"
 #include "Pxl/Pxl/interface/pxl/core/logging.hh"
 
 #undef PXL_LOG_MODULE_NAME
@@ -19,7 +20,7 @@ namespace pxl
 
 OutputHandler::OutputHandler(size_t maxSize, size_t maxNObjects) :
 		_maxSize(maxSize), _newFileSection(true), _maxNObjects(maxNObjects), _nObjects(
-				0)
+				0), _packEvents(false)
 {
 }
 
@@ -40,6 +41,23 @@ bool OutputHandler::newFileSection(const std::string& info)
 	return true;
 }
 
+void OutputHandler::newEventSection(const Event& event)
+{
+	if (!_newFileSection)
+		return;
+
+	std::string info;
+	const UserRecords& records = event.getUserRecords();
+	for (std::vector<std::string>::const_iterator key = _sectionInfoKeys.begin();
+			key != _sectionInfoKeys.end(); ++key)
+	{
+		const Variant* value = records.find(*key);
+		if (value)
+			SectionInfo::addValue(info, *key, value->toString());
+	}
+	newFileSection(info);
+}
+
 /// Use this method to write out a block to file. This method is not needed if you use the writeEvent-method.
 bool OutputHandler::writeStream(const std::string& info)
 {
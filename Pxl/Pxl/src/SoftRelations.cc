@@ -41,6 +41,17 @@ void SoftRelations::deserialize(const InputStream &in)
 	}
 }
 	
+void SoftRelations::skipSerialized(const InputStream &in)
+{
+	unsigned int size;
+	in.readUnsignedInt(size);
+	for (size_t i=0; i<size; ++i)
+	{
+		in.skipString();
+		in.skipRaw(16);
+	}
+}
+
 Serializable* SoftRelations::getFirst(const ObjectOwner& owner,
 		const std::string& type) const
 {
@@ -10,17 +10,411 @@
 #include "Pxl/Pxl/interface/pxl/core/ObjectFactory.hh"
 #include "Pxl/Pxl/interface/pxl/core/logging.hh"
 
+#include <algorithm>
+
 #undef PXL_LOG_MODULE_NAME
 #define PXL_LOG_MODULE_NAME "pxl::UserRecords"
 
 namespace pxl
 {
 
+/// Number of records from which on they are found through the index.
+static const size_t _indexedSize = 16;
+
+void UserRecords::DataSocket::reindex()
+{
+	if (_keys.size() < _indexedSize)
+	{
+		_index.clear();
+		return;
+	}
+
+	size_t size = 64;
+	while (size < 2 * _keys.size())
+		size *= 2;
+	_index.assign(size, 0);
+	size_t mask = size - 1;
+	for (size_t i = 0; i < _keys.size(); i++)
+	{
+		size_t slot = indexSlot(_keys[i]) & mask;
+		while (_index[slot] != 0)
+			slot = (slot + 1) & mask;
+		_index[slot] = i + 1;
+	}
+}
+
+void UserRecords::DataSocket::reindexInserted(size_t pos)
+{
+	if (_index.empty() || 2 * _keys.size() > _index.size())
+	{
+		reindex();
+		return;
+	}
+
+	// the records behind pos moved up by one (written without a branch, so
+	// that the loop is vectorized)
+	uint32_t first = pos + 1;
+	for (size_t i = 0; i < _index.size(); i++)
+		_index[i] += (_index[i] >= first);
+	size_t mask = _index.size() - 1;
+	size_t slot = indexSlot(_keys[pos]) & mask;
+	while (_index[slot] != 0)
+		slot = (slot + 1) & mask;
+	_index[slot] = pos + 1;
+}
+
+/// Inserts \p count empty values at \p pos. The values behind are swapped
+/// back instead of being copied.
+static void insertValues(std::vector<Variant>& values, size_t pos,
+		size_t count)
+{
+	values.resize(values.size() + count);
+	for (size_t i = values.size() - 1; i >= pos + count; i--)
+		values[i].swap(values[i - count]);
+}
+
+/// Removes the values from \p first to \p last, swapping the values behind
+/// forward instead of copying them.
+static void eraseValues(std::vector<Variant>& values, size_t first,
+		size_t last)
+{
+	for (size_t i = last; i < values.size(); i++)
+		values[first + i - last].swap(values[i]);
+	values.resize(values.size() - (last - first));
+}
+
+/// Reads a value of the type \p cType into \p value, which keeps its memory
+/// if it already has the type. Returns false for unknown types.
+static bool readValue(char cType, const InputStream &in, Variant& value)
+{
+	//FIXME: temporary solution here - could also use static lookup-map,
+	//but leave this unchanged until decided if to switch to new UR implementation.
+	switch (cType)
+	{
+	case 'b':
+	{
+		bool b;
+		in.readBool(b);
+		value = b;
+		return true;
+	}
+	case 'c':
+	{
+		char c;
+		in.readChar(c);
+		value = c;
+		return true;
+	}
+	case 'C':
+	{
+		unsigned char c;
+		in.readUnsignedChar(c);
+		value = c;
+		return true;
+	}
+
+	case 'l':
+	case 'i':
+	{
+		int32_t ii;
+		in.read(ii);
+		value = ii;
+		return true;
+	}
+	case 'L':
+	case 'I':
+	{
+		uint32_t ui;
+		in.read(ui);
+		value = ui;
+		return true;
+	}
+	case 'o':
+	{
+		short s;
+		in.readShort(s);
+		value = s;
+		return true;
+	}
+	case 'O':
+	{
+		unsigned short us;
+		in.readUnsignedShort(us);
+		value = us;
+		return true;
+	}
+	case 'm':
+	{
+		int64_t l;
+		in.read(l);
+		value = l;
+		return true;
+	}
+	case 'M':
+	{
+		uint64_t ul;
+		in.read(ul);
+		value = ul;
+		return true;
+	}
+	case 'd':
+	{
+		double d;
+		in.readDouble(d);
+		value = d;
+		return true;
+	}
+	case 'f':
+	{
+		float f;
+		in.readFloat(f);
+		value = f;
+		return true;
+	}
+	case 's':
+	{
+		// read into the string of the previous event, if there is one
+		if (!value.isString())
+			value.clear();
+		in.readString(value.asString());
+		return true;
+	}
+	case 'S':
+	{
+		Id id(in);
+		Serializable* obj = ObjectFactory::instance().create(id);
+		obj->deserialize(in);
+		value = obj;
+		delete obj;
+		return true;
+	}
+	case 'V':
+	{
+		Basic3Vector obj;
+		double d;
+		in.readDouble(d);
+		obj.setX(d);
+		in.readDouble(d);
+		obj.setY(d);
+		in.readDouble(d);
+		obj.setZ(d);
+		value = obj;
+		return true;
+	}
+	case 'Z':
+	{
+		LorentzVector obj;
+		double d;
+		in.readDouble(d);
+		obj.setX(d);
+		in.readDouble(d);
+		obj.setY(d);
+		in.readDouble(d);
+		obj.setZ(d);
+		in.readDouble(d);
+		obj.setT(d);
+		value = obj;
+		return true;
+	}
+	case 'F':
+		if (!value.isFloatArray())
+			value.clear();
+		in.readArray(value.asFloatArray());
+		return true;
+	case 'D':
+		if (!value.isDoubleArray())
+			value.clear();
+		in.readArray(value.asDoubleArray());
+		return true;
+	case 'N':
+		if (!value.isInt32Array())
+			value.clear();
+		in.readArray(value.asInt32Array());
+		return true;
+
+	default:
+		PXL_LOG_WARNING << "Type " << cType << " not handled in pxl::Variant I/O.";
+		return false;
+	}
+}
+
+/// Reads past a value of the type \p cType. Returns false for unknown types.
+static bool skipValue(char cType, const InputStream &in)
+{
+	switch (cType)
+	{
+	case 'b':
+	case 'c':
+	case 'C':
+		in.skipRaw(1);
+		return true;
+	case 'o':
+	case 'O':
+		in.skipRaw(2);
+		return true;
+	case 'l':
+	case 'i':
+	case 'L':
+	case 'I':
+	case 'f':
+		in.skipRaw(4);
+		return true;
+	case 'm':
+	case 'M':
+	case 'd':
+		in.skipRaw(8);
+		return true;
+	case 's':
+		in.skipString();
+		return true;
+	case 'S':
+	{
+		Id id(in);
+		if (!ObjectFactory::instance().skip(id, in))
+			throw std::runtime_error(
+					"pxl::UserRecords::skipSerialized(): unknown object "
+							+ id.toString());
+		return true;
+	}
+	case 'V':
+		in.skipRaw(24);
+		return true;
+	case 'Z':
+		in.skipRaw(32);
+		return true;
+	case 'F':
+		in.skipArray(sizeof(float));
+		return true;
+	case 'D':
+		in.skipArray(sizeof(double));
+		return true;
+	case 'N':
+		in.skipArray(sizeof(int32_t));
+		return true;
+	default:
+		PXL_LOG_WARNING << "Type " << cType << " not handled in pxl::Variant I/O.";
+		return false;
+	}
+}
+
+void UserRecords::DataSocket::decode(size_t pos) const
+{
+	BufferInput in;
+	in.setView(&_serialized[_offsets[pos]], _serialized.size() - _offsets[pos]);
+	char cType;
+	in.readChar(cType);
+	// the value is part of the logical state, which is not changed
+	readValue(cType, in, const_cast<Variant&>(_values[pos]));
+	const_cast<uint32_t&>(_offsets[pos]) = _decoded;
+}
+
+void UserRecords::DataSocket::decodeAll()
+{
+	for (size_t i = 0; i < _values.size(); i++)
+		value(i);
+	_serialized.clear();
+	_offsets.clear();
+}
+
+void UserRecords::set(uint32_t key, const Variant& item)
+{
+	DataSocket* socket = setSocket();
+	size_t pos = socket->position(key);
+	if (pos < socket->_keys.size())
+		socket->_values[pos] = item;
+	else
+		insert(key, UserRecordKeys::getName(key), item);
+}
+
+void UserRecords::insert(uint32_t key, const std::string& name,
+		const Variant& item)
+{
+	DataSocket* socket = setSocket();
+	std::vector<uint32_t>& keys = socket->_keys;
+	size_t low = 0;
+	size_t high = keys.size();
+	while (low < high)
+	{
+		size_t middle = (low + high) / 2;
+		if (UserRecordKeys::getName(keys[middle]) < name)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	keys.insert(keys.begin() + low, key);
+	insertValues(socket->_values, low, 1);
+	socket->_values[low] = item;
+	socket->reindexInserted(low);
+}
+
+void UserRecords::erase(uint32_t key)
+{
+	size_t pos = _dataSocket->position(key);
+	if (pos == _dataSocket->_keys.size())
+		throw std::runtime_error("Cannot erase unknown key: "
+				+ UserRecordKeys::getName(key));
+	DataSocket* socket = setSocket();
+	socket->_keys.erase(socket->_keys.begin() + pos);
+	eraseValues(socket->_values, pos, pos + 1);
+	socket->reindex();
+}
+
+/// Orders records by the strings of their keys.
+class KeyOrder
+{
+public:
+	KeyOrder(const std::vector<uint32_t>& keys) :
+			_keys(keys)
+	{
+	}
+
+	bool operator()(size_t a, size_t b) const
+	{
+		return UserRecordKeys::getName(_keys[a])
+				< UserRecordKeys::getName(_keys[b]);
+	}
+
+private:
+	const std::vector<uint32_t>& _keys;
+};
+
+/// Brings records read in the wrong order into the order of their keys. Of
+/// records with the same key the last one is kept.
+static void sortRecords(std::vector<uint32_t>& keys,
+		std::vector<Variant>& values)
+{
+	std::vector<size_t> order(keys.size());
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::stable_sort(order.begin(), order.end(), KeyOrder(keys));
+
+	std::vector<uint32_t> sortedKeys;
+	std::vector<Variant> sortedValues;
+	sortedKeys.reserve(order.size());
+	sortedValues.reserve(order.size());
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		if (i + 1 < order.size() && keys[order[i + 1]] == keys[order[i]])
+			continue;
+		sortedKeys.push_back(keys[order[i]]);
+		sortedValues.push_back(Variant());
+		sortedValues.back().swap(values[order[i]]);
+	}
+	keys.swap(sortedKeys);
+	values.swap(sortedValues);
+}
+
 void UserRecords::serialize(const OutputStream &out) const
 {
-	out.writeUnsignedInt(getContainer()->size());
-	for (const_iterator iter = getContainer()->begin();
-			iter != getContainer()->end(); ++iter)
+	out.writeUnsignedInt(size());
+	const DataSocket* socket = _dataSocket;
+	if (!socket->_offsets.empty())
+	{
+		// records read lazily are written as they were read
+		out.write(&socket->_serialized[0], socket->_serialized.size());
+		return;
+	}
+	for (const_iterator iter = begin(); iter != end(); ++iter)
 	{
 		out.writeString(iter->first);
 		Variant::Type type = iter->second.getType();
@@ -114,6 +508,21 @@ void UserRecords::serialize(const OutputStream &out) const
 			out.writeDouble(L.getT());
 			break;
 		}
+		case Variant::TYPE_FLOAT_ARRAY:
+			cType = 'F';
+			out.writeChar(cType);
+			out.writeArray(iter->second.asFloatArray());
+			break;
+		case Variant::TYPE_DOUBLE_ARRAY:
+			cType = 'D';
+			out.writeChar(cType);
+			out.writeArray(iter->second.asDoubleArray());
+			break;
+		case Variant::TYPE_INT32_ARRAY:
+			cType = 'N';
+			out.writeChar(cType);
+			out.writeArray(iter->second.asInt32Array());
+			break;
 
 		default:
 			out.writeChar(cType);
@@ -126,158 +535,176 @@ void UserRecords::serialize(const OutputStream &out) const
 
 void UserRecords::deserialize(const InputStream &in)
 {
+	DataSocket* socket = detachSocket();
+	socket->_serialized.clear();
+	socket->_offsets.clear();
+
 	unsigned int size = 0;
 	in.readUnsignedInt(size);
+	if (size > 0 && in.hasLazyUserRecords() && in.getCursor())
+		readRecordsLazily(in, size);
+	else
+		readRecords(in, size);
+}
+
+void UserRecords::readRecords(const InputStream &in, unsigned int size)
+{
+	// The records are written in the order of their keys. Records already
+	// present (e.g. from the previous event read into the same object) are
+	// overwritten in place, those missing in the stream are removed. Only
+	// keys differing from the present record at their position are looked
+	// up in the key table.
+	DataSocket* socket = _dataSocket;
+	std::vector<uint32_t>& keys = socket->_keys;
+	std::vector<Variant>& values = socket->_values;
+	size_t next = 0;
+	bool ordered = true;
+	bool checkOrder = false;
+	bool moved = false;
+	std::string name;
+
+	if (keys.capacity() < size)
+	{
+		keys.reserve(size);
+		values.reserve(size);
+	}
 	for (unsigned int j = 0; j < size; ++j)
 	{
-		std::string name;
 		in.readString(name);
 		char cType;
 		in.readChar(cType);
 
-		iterator insertPos = setContainer()->end();
-
-		//FIXME: temporary solution here - could also use static lookup-map,
-		//but leave this unchanged until decided if to switch to new UR implementation.
-		switch (cType)
+		if (next < keys.size() && UserRecordKeys::getName(keys[next]) == name)
 		{
-		case 'b':
-		{
-			bool b;
-			in.readBool(b);
-			setFast(insertPos, name, b);
-			break;
+			// follows the present records, which are ordered, unless the
+			// previous record did not
+			if (checkOrder && next > 0
+					&& !(UserRecordKeys::getName(keys[next - 1]) < name))
+				ordered = false;
+			checkOrder = false;
 		}
-		case 'c':
+		else
 		{
-			char c;
-			in.readChar(c);
-			setFast(insertPos, name, c);
-			break;
-		}
-		case 'C':
-		{
-			unsigned char c;
-			in.readUnsignedChar(c);
-			setFast(insertPos, name, c);
-			break;
+			uint32_t key = UserRecordKeys::intern(name);
+			size_t found = next;
+			while (found < keys.size() && keys[found] != key)
+				found++;
+			if (found < keys.size())
+			{
+				keys.erase(keys.begin() + next, keys.begin() + found);
+				eraseValues(values, next, found);
+			}
+			else
+			{
+				keys.insert(keys.begin() + next, key);
+				insertValues(values, next, 1);
+			}
+			if (next > 0 && !(UserRecordKeys::getName(keys[next - 1]) < name))
+				ordered = false;
+			checkOrder = true;
+			moved = true;
 		}
 
-		case 'l':
-		case 'i':
-		{
-			int32_t ii;
-			in.read(ii);
-			setFast(insertPos, name, ii);
-			break;
-		}
-		case 'L':
-		case 'I':
-		{
-			uint32_t ui;
-			in.read(ui);
-			setFast(insertPos, name, ui);
-			break;
-		}
-		case 'o':
+		if (readValue(cType, in, values[next]))
+			next++;
+		else
 		{
-			short s;
-			in.readShort(s);
-			setFast(insertPos, name, s);
-			break;
-		}
-		case 'O':
-		{
-			unsigned short us;
-			in.readUnsignedShort(us);
-			setFast(insertPos, name, us);
-			break;
-		}
-		case 'm':
-		{
-			int64_t l;
-			in.read(l);
-			setFast(insertPos, name, l);
-			break;
+			keys.erase(keys.begin() + next);
+			eraseValues(values, next, next + 1);
+			moved = true;
 		}
-		case 'M':
-		{
-			uint64_t ul;
-			in.read(ul);
-			setFast(insertPos, name, ul);
-			break;
-		}
-		case 'd':
-		{
-			double d;
-			in.readDouble(d);
-			setFast(insertPos, name, d);
-			break;
-		}
-		case 'f':
-		{
-			float f;
-			in.readFloat(f);
-			setFast(insertPos, name, f);
-			break;
-		}
-		case 's':
-		{
-			std::string ss;
-			in.readString(ss);
-			setFast(insertPos, name, ss);
-			break;
-		}
-		case 'S':
-		{
-			Id id(in);
-			Serializable* obj = ObjectFactory::instance().create(id);
-			obj->deserialize(in);
-			setFast(insertPos, name, obj);
-			delete obj;
-			break;
-		}
-		case 'V':
+	}
+	if (next < keys.size())
+	{
+		keys.resize(next);
+		values.resize(next);
+		moved = true;
+	}
+	if (!ordered)
+		sortRecords(keys, values);
+	if (moved)
+		socket->reindex();
+}
+
+void UserRecords::readRecordsLazily(const InputStream &in, unsigned int size)
+{
+	// Like readRecords(), the present keys are reused where they match. The
+	// values are only skipped; the records are copied as they are and the
+	// offsets of the values noted. Present values keep their memory for the
+	// values decoded into them.
+	DataSocket* socket = _dataSocket;
+	std::vector<uint32_t>& keys = socket->_keys;
+	std::vector<Variant>& values = socket->_values;
+	std::vector<uint32_t>& offsets = socket->_offsets;
+	size_t present = keys.size();
+	size_t next = 0;
+	bool ordered = true;
+	bool checkOrder = false;
+	bool moved = present != size;
+	std::string name;
+
+	keys.resize(size);
+	values.resize(size);
+	offsets.resize(size);
+	const char *begin = in.getCursor();
+	for (unsigned int j = 0; j < size; ++j)
+	{
+		in.readString(name);
+		if (next < present && UserRecordKeys::getName(keys[next]) == name)
 		{
-			Basic3Vector obj;
-			double d;
-			in.readDouble(d);
-			obj.setX(d);
-			in.readDouble(d);
-			obj.setY(d);
-			in.readDouble(d);
-			obj.setZ(d);
-			setFast(insertPos, name, obj);
-			break;
+			if (checkOrder && next > 0
+					&& !(UserRecordKeys::getName(keys[next - 1]) < name))
+				ordered = false;
+			checkOrder = false;
 		}
-		case 'Z':
+		else
 		{
-			LorentzVector obj;
-			double d;
-			in.readDouble(d);
-			obj.setX(d);
-			in.readDouble(d);
-			obj.setY(d);
-			in.readDouble(d);
-			obj.setZ(d);
-			in.readDouble(d);
-			obj.setT(d);
-			setFast(insertPos, name, obj);
-			break;
+			keys[next] = UserRecordKeys::intern(name);
+			if (next > 0 && !(UserRecordKeys::getName(keys[next - 1]) < name))
+				ordered = false;
+			checkOrder = true;
+			moved = true;
 		}
 
-		default:
-			PXL_LOG_WARNING << "Type " << cType << " not handled in pxl::Variant I/O.";
-			break;
-		}
+		offsets[next] = in.getCursor() - begin;
+		char cType;
+		in.readChar(cType);
+		if (skipValue(cType, in))
+			next++;
+		else
+			moved = true;
+	}
+	keys.resize(next);
+	values.resize(next);
+	offsets.resize(next);
+	socket->_serialized.assign(begin, in.getCursor());
+
+	// records of unknown types were dropped, the copy cannot be written
+	if (!ordered || next < size)
+		socket->decodeAll();
+	if (!ordered)
+		sortRecords(keys, values);
+	if (moved)
+		socket->reindex();
+}
+
+void UserRecords::skipSerialized(const InputStream &in)
+{
+	unsigned int size = 0;
+	in.readUnsignedInt(size);
+	for (unsigned int j = 0; j < size; ++j)
+	{
+		in.skipString();
+		char cType;
+		in.readChar(cType);
+		skipValue(cType, in);
 	}
 }
 
 std::ostream& UserRecords::print(int level, std::ostream& os, int pan) const
 {
 	os << "UserRecord size " << size() << "\n";
-	for (const_iterator iter = getContainer()->begin();
-			iter != getContainer()->end(); ++iter)
+	for (const_iterator iter = begin(); iter != end(); ++iter)
 	{
 		os << "-->";
 
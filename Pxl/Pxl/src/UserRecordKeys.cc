@@ -0,0 +1,189 @@
+//-------------------------------------------
+// Project: Physics eXtension Library (PXL) -
+//      http://vispa.physik.rwth-aachen.de/ -
+// Copyright (C) 2009-2012 Martin Erdmann   -
+//               RWTH Aachen, Germany       -
+// Licensed under a LGPL-2 or later license -
+//-------------------------------------------
+
+#include "Pxl/Pxl/interface/pxl/core/UserRecordKeys.hh"
+
+#include <stdexcept>
+#include <vector>
+
+#include <pthread.h>
+
+namespace pxl
+{
+
+std::string* UserRecordKeys::_chunks[UserRecordKeys::_maxChunks];
+
+/// Slot of the hash tables, id is the key number + 1, 0 for unused slots.
+struct KeySlot
+{
+	uint32_t hash;
+	uint32_t id;
+};
+
+/// Slot of the cache of unknown keys: no key with the hash was in the table
+/// when it had generation - 1 keys.
+struct MissSlot
+{
+	uint32_t hash;
+	uint32_t generation;
+};
+
+static pthread_mutex_t _keyMutex = PTHREAD_MUTEX_INITIALIZER;
+/// Number of keys, also read without the lock to validate the cached misses.
+static uint32_t _keyCount = 0;
+/// Open addressing table of all keys, kept at most half full.
+static std::vector<KeySlot>* _keyTable = 0;
+
+/// Direct mapped cache of the keys used by a thread, a slot is simply
+/// overwritten by the next key hashing to it.
+static const uint32_t _cacheSize = 1024;
+static PXL_THREAD_LOCAL KeySlot _keyCache[_cacheSize];
+/// The same for keys looked up but not found, which stay valid until a key
+/// is added.
+static PXL_THREAD_LOCAL MissSlot _missCache[_cacheSize];
+
+static inline uint32_t hashKey(const std::string& key)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < key.size(); i++)
+	{
+		hash ^= (unsigned char) key[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void growKeyTable()
+{
+	std::vector<KeySlot> slots(_keyTable->empty() ? 1024 : 2 * _keyTable->size());
+	size_t mask = slots.size() - 1;
+	for (size_t i = 0; i < _keyTable->size(); i++)
+	{
+		const KeySlot& slot = (*_keyTable)[i];
+		if (slot.id == 0)
+			continue;
+		size_t pos = slot.hash & mask;
+		while (slots[pos].id != 0)
+			pos = (pos + 1) & mask;
+		slots[pos] = slot;
+	}
+	_keyTable->swap(slots);
+}
+
+/// Returns the slot of \p key in the table, or the free slot where it is to
+/// be added. The table must be locked and not be empty. \p sameHash is set
+/// if a key with the same hash was passed; keys are never removed, so all
+/// keys with the hash lie on the way.
+static KeySlot& findSlot(const std::string& key, uint32_t hash,
+		bool& sameHash)
+{
+	size_t mask = _keyTable->size() - 1;
+	size_t pos = hash & mask;
+	sameHash = false;
+	while ((*_keyTable)[pos].id != 0)
+	{
+		if ((*_keyTable)[pos].hash == hash)
+		{
+			if (UserRecordKeys::getName((*_keyTable)[pos].id - 1) == key)
+				break;
+			sameHash = true;
+		}
+		pos = (pos + 1) & mask;
+	}
+	return (*_keyTable)[pos];
+}
+
+uint32_t UserRecordKeys::intern(const std::string& key)
+{
+	uint32_t hash = hashKey(key);
+	KeySlot& cached = _keyCache[hash & (_cacheSize - 1)];
+	if (cached.id != 0 && cached.hash == hash && getName(cached.id - 1) == key)
+		return cached.id - 1;
+
+	pthread_mutex_lock(&_keyMutex);
+	if (!_keyTable)
+		_keyTable = new std::vector<KeySlot>;
+	if (2 * (_keyCount + 1) > _keyTable->size())
+		growKeyTable();
+
+	bool sameHash;
+	KeySlot& slot = findSlot(key, hash, sameHash);
+	if (slot.id == 0)
+	{
+		uint32_t id = _keyCount;
+		uint32_t chunk = id >> _chunkBits;
+		if (chunk == _maxChunks)
+		{
+			pthread_mutex_unlock(&_keyMutex);
+			throw std::runtime_error(
+					"pxl::UserRecordKeys::intern(): too many user record keys");
+		}
+		if (!_chunks[chunk])
+			_chunks[chunk] = new std::string[_chunkSize];
+		_chunks[chunk][id & (_chunkSize - 1)] = key;
+		slot.hash = hash;
+		slot.id = id + 1;
+		// the name is stored before the count invalidates cached misses
+		__atomic_store_n(&_keyCount, _keyCount + 1, __ATOMIC_RELEASE);
+	}
+	cached = slot;
+	pthread_mutex_unlock(&_keyMutex);
+	return cached.id - 1;
+}
+
+bool UserRecordKeys::lookup(const std::string& key, uint32_t& id)
+{
+	uint32_t hash = hashKey(key);
+	KeySlot& cached = _keyCache[hash & (_cacheSize - 1)];
+	if (cached.id != 0 && cached.hash == hash && getName(cached.id - 1) == key)
+	{
+		id = cached.id - 1;
+		return true;
+	}
+
+	// optional records are looked up for every event, so unknown keys are
+	// cached as well, until the next key is added
+	MissSlot& missed = _missCache[hash & (_cacheSize - 1)];
+	if (missed.hash == hash && missed.generation
+			== __atomic_load_n(&_keyCount, __ATOMIC_ACQUIRE) + 1)
+		return false;
+
+	pthread_mutex_lock(&_keyMutex);
+	bool found = false;
+	bool sameHash = false;
+	if (_keyTable && !_keyTable->empty())
+	{
+		const KeySlot& slot = findSlot(key, hash, sameHash);
+		if (slot.id != 0)
+		{
+			cached = slot;
+			id = slot.id - 1;
+			found = true;
+		}
+	}
+	// the cache holds no names, a miss is only cached if no key at all has
+	// its hash
+	if (!found && !sameHash)
+	{
+		missed.hash = hash;
+		missed.generation = _keyCount + 1;
+	}
+	pthread_mutex_unlock(&_keyMutex);
+	return found;
+}
+
+uint32_t UserRecordKeys::size()
+{
+	pthread_mutex_lock(&_keyMutex);
+	uint32_t count = _keyCount;
+	pthread_mutex_unlock(&_keyMutex);
+	return count;
+}
+
+} // namespace pxl
@@ -32,7 +32,7 @@ Variant::Variant(const Variant& a) :
 
 Variant::Variant(const char *s)
 {
-	data.__String = new std::string(s);
+	new (data.__buffer) std::string(s);
 	type = TYPE_STRING;
 }
 
@@ -54,19 +54,24 @@ Variant::Variant(const std::vector<Variant> &a)
 	type = TYPE_VECTOR;
 }
 
+template<class T> static inline void destroy(T *p)
+{
+	p->~T();
+}
+
 void Variant::clear()
 {
 	if (type == TYPE_STRING)
 	{
-		safe_delete(data.__String);
+		destroy(inlineString());
 	}
 	else if (type == TYPE_BASIC3VECTOR)
 	{
-		safe_delete(data.__Basic3Vector);
+		destroy(inlineBasic3Vector());
 	}
 	else if (type == TYPE_LORENTZVECTOR)
 	{
-		safe_delete(data.__LorentzVector);
+		destroy(inlineLorentzVector());
 	}
 	else if (type == TYPE_SERIALIZABLE)
 	{
@@ -76,6 +81,18 @@ void Variant::clear()
 	{
 		safe_delete(data.__vec);
 	}
+	else if (type == TYPE_FLOAT_ARRAY)
+	{
+		safe_delete(data.__FloatArray);
+	}
+	else if (type == TYPE_DOUBLE_ARRAY)
+	{
+		safe_delete(data.__DoubleArray);
+	}
+	else if (type == TYPE_INT32_ARRAY)
+	{
+		safe_delete(data.__Int32Array);
+	}
 	type = TYPE_NONE;
 }
 
@@ -93,17 +110,26 @@ void Variant::check(const Type t)
 		switch (t)
 		{
 		case TYPE_STRING:
-			data.__String = new std::string;
+			new (data.__buffer) std::string;
 			break;
 		case TYPE_BASIC3VECTOR:
-			data.__Basic3Vector = new Basic3Vector;
+			new (data.__buffer) Basic3Vector;
 			break;
 		case TYPE_LORENTZVECTOR:
-			data.__LorentzVector = new LorentzVector;
+			new (data.__buffer) LorentzVector;
 			break;
 		case TYPE_VECTOR:
 			data.__vec = new vector_t;
 			break;
+		case TYPE_FLOAT_ARRAY:
+			data.__FloatArray = new std::vector<float>;
+			break;
+		case TYPE_DOUBLE_ARRAY:
+			data.__DoubleArray = new std::vector<double>;
+			break;
+		case TYPE_INT32_ARRAY:
+			data.__Int32Array = new std::vector<int32_t>;
+			break;
 		default:
 			break;
 		}
@@ -174,7 +200,7 @@ const std::type_info& Variant::getTypeInfo() const
 	}
 	else if (type == TYPE_STRING)
 	{
-		const std::type_info &ti = typeid(*data.__String);
+		const std::type_info &ti = typeid(*inlineString());
 		return ti;
 	}
 	else if (type == TYPE_SERIALIZABLE)
@@ -184,12 +210,12 @@ const std::type_info& Variant::getTypeInfo() const
 	}
 	else if (type == TYPE_BASIC3VECTOR)
 	{
-		const std::type_info &ti = typeid(data.__Basic3Vector);
+		const std::type_info &ti = typeid(Basic3Vector*);
 		return ti;
 	}
 	else if (type == TYPE_LORENTZVECTOR)
 	{
-		const std::type_info &ti = typeid(data.__LorentzVector);
+		const std::type_info &ti = typeid(LorentzVector*);
 		return ti;
 	}
 	else if (type == TYPE_VECTOR)
@@ -197,6 +223,21 @@ const std::type_info& Variant::getTypeInfo() const
 		const std::type_info &ti = typeid(*data.__vec);
 		return ti;
 	}
+	else if (type == TYPE_FLOAT_ARRAY)
+	{
+		const std::type_info &ti = typeid(*data.__FloatArray);
+		return ti;
+	}
+	else if (type == TYPE_DOUBLE_ARRAY)
+	{
+		const std::type_info &ti = typeid(*data.__DoubleArray);
+		return ti;
+	}
+	else if (type == TYPE_INT32_ARRAY)
+	{
+		const std::type_info &ti = typeid(*data.__Int32Array);
+		return ti;
+	}
 	else
 	{
 		const std::type_info &ti = typeid(0);
@@ -275,6 +316,18 @@ const char *Variant::getTypeName(Type type)
 	{
 		return "vector";
 	}
+	else if (type == TYPE_FLOAT_ARRAY)
+	{
+		return "float_array";
+	}
+	else if (type == TYPE_DOUBLE_ARRAY)
+	{
+		return "double_array";
+	}
+	else if (type == TYPE_INT32_ARRAY)
+	{
+		return "int32_array";
+	}
 	else
 	{
 		return "unknown";
@@ -351,6 +404,18 @@ Variant::Type Variant::toType(const std::string &name)
 	{
 		return TYPE_STRING;
 	}
+	else if (name == "float_array")
+	{
+		return TYPE_FLOAT_ARRAY;
+	}
+	else if (name == "double_array")
+	{
+		return TYPE_DOUBLE_ARRAY;
+	}
+	else if (name == "int32_array")
+	{
+		return TYPE_INT32_ARRAY;
+	}
 	else
 	{
 		return TYPE_NONE;
@@ -411,16 +476,28 @@ bool Variant::operator ==(const Variant &a) const
 	}
 	else if (type == TYPE_BASIC3VECTOR)
 	{
-		return ((*data.__Basic3Vector) == (*a.data.__Basic3Vector));
+		return ((*inlineBasic3Vector()) == (*a.inlineBasic3Vector()));
 	}
 	else if (type == TYPE_STRING)
 	{
-		return (*data.__String == *a.data.__String);
+		return (*inlineString() == *a.inlineString());
 	}
 	else if (type == TYPE_VECTOR)
 	{
 		return (*data.__vec == *a.data.__vec);
 	}
+	else if (type == TYPE_FLOAT_ARRAY)
+	{
+		return (*data.__FloatArray == *a.data.__FloatArray);
+	}
+	else if (type == TYPE_DOUBLE_ARRAY)
+	{
+		return (*data.__DoubleArray == *a.data.__DoubleArray);
+	}
+	else if (type == TYPE_INT32_ARRAY)
+	{
+		return (*data.__Int32Array == *a.data.__Int32Array);
+	}
 	else
 	{
 		throw std::runtime_error("compare operator not implemented");
@@ -430,7 +507,7 @@ bool Variant::operator ==(const Variant &a) const
 std::string Variant::toString() const
 {
 	if (type == TYPE_STRING)
-		return *data.__String;
+		return *inlineString();
 
 	std::stringstream sstr;
 	if (type == TYPE_BOOL)
@@ -479,24 +556,40 @@ std::string Variant::toString() const
 	}
 	else if (type == TYPE_BASIC3VECTOR)
 	{
-		sstr << data.__Basic3Vector->getX() << " " << data.__Basic3Vector->getY()
-				<< " " << data.__Basic3Vector->getZ();
+		sstr << inlineBasic3Vector()->getX() << " " << inlineBasic3Vector()->getY()
+				<< " " << inlineBasic3Vector()->getZ();
 	}
 	else if (type == TYPE_LORENTZVECTOR)
 	{
-		sstr << data.__LorentzVector->getX() << " "
-				<< data.__LorentzVector->getY() << " "
-				<< data.__LorentzVector->getZ() << " "
-				<< data.__LorentzVector->getE();
+		sstr << inlineLorentzVector()->getX() << " "
+				<< inlineLorentzVector()->getY() << " "
+				<< inlineLorentzVector()->getZ() << " "
+				<< inlineLorentzVector()->getE();
 	}
-	else if (type == TYPE_VECTOR)
+	else if (type == TYPE_VECTOR || type == TYPE_FLOAT_ARRAY
+			|| type == TYPE_DOUBLE_ARRAY || type == TYPE_INT32_ARRAY)
 	{
-		sstr << *data.__vec;
+		sstr << *this;
 	}
 
 	return sstr.str();
 }
 
+/// Reads the numbers of an array written by toString(), e.g. "(1, 2, 3)".
+template<class T> static std::vector<T> arrayFromString(const std::string &str)
+{
+	std::string numbers(str);
+	std::replace(numbers.begin(), numbers.end(), ',', ' ');
+	std::replace(numbers.begin(), numbers.end(), '(', ' ');
+	std::replace(numbers.begin(), numbers.end(), ')', ' ');
+	std::stringstream sstr(numbers);
+	std::vector<T> array;
+	T value;
+	while (sstr >> value)
+		array.push_back(value);
+	return array;
+}
+
 Variant Variant::fromString(const std::string &str, Type type)
 {
 	std::stringstream sstr(str);
@@ -630,6 +723,12 @@ Variant Variant::fromString(const std::string &str, Type type)
 		}
 		return Variant(stringVectorValue);
 	}
+	case TYPE_FLOAT_ARRAY:
+		return Variant(arrayFromString<float>(str));
+	case TYPE_DOUBLE_ARRAY:
+		return Variant(arrayFromString<double>(str));
+	case TYPE_INT32_ARRAY:
+		return Variant(arrayFromString<int32_t>(str));
 	default:
 		throw std::runtime_error("pxl::Variant::fromString: unknown type");
 	}
@@ -668,11 +767,17 @@ bool Variant::operator !=(const Variant &a) const
 	case TYPE_SERIALIZABLE:
 		return (data.__Serializable == a.data.__Serializable);
 	case TYPE_BASIC3VECTOR:
-		return ((*data.__Basic3Vector) == (*a.data.__Basic3Vector));
+		return ((*inlineBasic3Vector()) == (*a.inlineBasic3Vector()));
 	case TYPE_STRING:
-		return (*data.__String == *a.data.__String);
+		return (*inlineString() == *a.inlineString());
 	case TYPE_VECTOR:
 		return (*data.__vec != *a.data.__vec);
+	case TYPE_FLOAT_ARRAY:
+		return (*data.__FloatArray != *a.data.__FloatArray);
+	case TYPE_DOUBLE_ARRAY:
+		return (*data.__DoubleArray != *a.data.__DoubleArray);
+	case TYPE_INT32_ARRAY:
+		return (*data.__Int32Array != *a.data.__Int32Array);
 	default:
 		throw std::runtime_error("compare operator not implemented");
 	}
@@ -717,13 +822,13 @@ void Variant::serialize(const OutputStream &out) const
 		out.writeDouble(data.__Double);
 		break;
 	case TYPE_STRING:
-		out.writeString(*data.__String);
+		out.writeString(*inlineString());
 		break;
 	case TYPE_BASIC3VECTOR:
-		data.__Basic3Vector->serialize(out);
+		inlineBasic3Vector()->serialize(out);
 		break;
 	case TYPE_LORENTZVECTOR:
-		data.__LorentzVector->serialize(out);
+		inlineLorentzVector()->serialize(out);
 		break;
 	case TYPE_VECTOR:
 	{
@@ -733,6 +838,15 @@ void Variant::serialize(const OutputStream &out) const
 			data.__vec->at(i).serialize(out);
 		break;
 	}
+	case TYPE_FLOAT_ARRAY:
+		out.writeArray(*data.__FloatArray);
+		break;
+	case TYPE_DOUBLE_ARRAY:
+		out.writeArray(*data.__DoubleArray);
+		break;
+	case TYPE_INT32_ARRAY:
+		out.writeArray(*data.__Int32Array);
+		break;
 	default:
 		break;
 	}
@@ -780,13 +894,13 @@ void Variant::deserialize(const InputStream &in)
 		in.readDouble(data.__Double);
 		break;
 	case TYPE_STRING:
-		in.readString(*data.__String);
+		in.readString(*inlineString());
 		break;
 	case TYPE_BASIC3VECTOR:
-		data.__Basic3Vector->deserialize(in);
+		inlineBasic3Vector()->deserialize(in);
 		break;
 	case TYPE_LORENTZVECTOR:
-		data.__LorentzVector->deserialize(in);
+		inlineLorentzVector()->deserialize(in);
 		break;
 	case TYPE_VECTOR:
 	{
@@ -797,6 +911,15 @@ void Variant::deserialize(const InputStream &in)
 			data.__vec->at(i).deserialize(in);
 		break;
 	}
+	case TYPE_FLOAT_ARRAY:
+		in.readArray(*data.__FloatArray);
+		break;
+	case TYPE_DOUBLE_ARRAY:
+		in.readArray(*data.__DoubleArray);
+		break;
+	case TYPE_INT32_ARRAY:
+		in.readArray(*data.__Int32Array);
+		break;
 	default:
 		break;
 	}
@@ -851,7 +974,7 @@ void Variant::copy(const Variant &a)
 	}
 	else if (t == TYPE_STRING)
 	{
-		operator =(*a.data.__String);
+		operator =(*a.inlineString());
 	}
 	else if (t == TYPE_SERIALIZABLE)
 	{
@@ -859,20 +982,77 @@ void Variant::copy(const Variant &a)
 	}
 	else if (t == TYPE_BASIC3VECTOR)
 	{
-		operator =(*a.data.__Basic3Vector);
+		operator =(*a.inlineBasic3Vector());
 	}
 	else if (t == TYPE_LORENTZVECTOR)
 	{
-		operator =(*a.data.__LorentzVector);
+		operator =(*a.inlineLorentzVector());
 	}
 	else if (t == TYPE_VECTOR)
 	{
 		operator =(*a.data.__vec);
 	}
+	else if (t == TYPE_FLOAT_ARRAY)
+	{
+		operator =(*a.data.__FloatArray);
+	}
+	else if (t == TYPE_DOUBLE_ARRAY)
+	{
+		operator =(*a.data.__DoubleArray);
+	}
+	else if (t == TYPE_INT32_ARRAY)
+	{
+		operator =(*a.data.__Int32Array);
+	}
+	else
+	{
+		clear();
+	}
+}
+
+/// Takes over the value of \p a, which is left empty. This must be empty.
+void Variant::moveFrom(Variant &a)
+{
+	Type t = a.type;
+	if (t == TYPE_STRING)
+	{
+		new (data.__buffer) std::string;
+		inlineString()->swap(*a.inlineString());
+		a.clear();
+	}
+	else if (t == TYPE_BASIC3VECTOR)
+	{
+		new (data.__buffer) Basic3Vector(*a.inlineBasic3Vector());
+		a.clear();
+	}
+	else if (t == TYPE_LORENTZVECTOR)
+	{
+		new (data.__buffer) LorentzVector(*a.inlineLorentzVector());
+		a.clear();
+	}
 	else
 	{
-		type = TYPE_NONE;
+		// plain values and pointers to serializables, vectors and arrays
+		data = a.data;
 	}
+	type = t;
+	a.type = TYPE_NONE;
+}
+
+void Variant::swap(Variant &other)
+{
+	if (this == &other)
+		return;
+	if (!isInline(type) && !isInline(other.type))
+	{
+		std::swap(data, other.data);
+		std::swap(type, other.type);
+		return;
+	}
+	Variant tmp;
+	tmp.moveFrom(*this);
+	moveFrom(other);
+	other.moveFrom(tmp);
 }
 
 bool Variant::toBool() const
@@ -911,7 +1091,7 @@ bool Variant::toBool() const
 		break;
 	case TYPE_STRING:
 	{
-		std::string upperstr(*data.__String);
+		std::string upperstr(*inlineString());
 		std::transform(upperstr.begin(), upperstr.end(), upperstr.begin(),
 				(int(*)(int))toupper);if
 (		upperstr == "YES")
@@ -933,6 +1113,15 @@ bool Variant::toBool() const
 	case TYPE_VECTOR:
 		return data.__vec->size() != 0;
 		break;
+	case TYPE_FLOAT_ARRAY:
+		return data.__FloatArray->size() != 0;
+		break;
+	case TYPE_DOUBLE_ARRAY:
+		return data.__DoubleArray->size() != 0;
+		break;
+	case TYPE_INT32_ARRAY:
+		return data.__Int32Array->size() != 0;
+		break;
 	case TYPE_FLOAT:
 	case TYPE_DOUBLE:
 	case TYPE_BASIC3VECTOR:
@@ -970,7 +1159,7 @@ to Variant::fun() const { \
 	INT_CASE(Double, TYPE_DOUBLE, to_type, to) \
 	case Variant::TYPE_STRING: \
 		{ \
-		long l = atol(data.__String->c_str()); \
+		long l = atol(inlineString()->c_str()); \
 		if (l < std::numeric_limits<to>::min() || l > std::numeric_limits<to>::max()) \
 			throw bad_conversion(type, to_type); \
 		else \
@@ -981,6 +1170,9 @@ to Variant::fun() const { \
 	case Variant::TYPE_BASIC3VECTOR: \
 	case Variant::TYPE_LORENTZVECTOR: \
 	case Variant::TYPE_VECTOR: \
+	case Variant::TYPE_FLOAT_ARRAY: \
+	case Variant::TYPE_DOUBLE_ARRAY: \
+	case Variant::TYPE_INT32_ARRAY: \
 	case Variant::TYPE_NONE: \
 		throw bad_conversion(type, TYPE_INT16); \
 		break;\
@@ -997,6 +1189,19 @@ INT_FUNCTION( TYPE_UINT32, toUInt32, uint32_t)
 INT_FUNCTION( TYPE_INT64, toInt64, int64_t)
 INT_FUNCTION( TYPE_UINT64, toUInt64, uint64_t)
 
+template<class T> static void printArray(std::ostream& os,
+		const std::vector<T>& array)
+{
+	os << "(";
+	for (size_t i = 0; i < array.size(); i++)
+	{
+		if (i != 0)
+			os << ", ";
+		os << array[i];
+	}
+	os << ")";
+}
+
 PXL_DLL_EXPORT std::ostream& operator <<(std::ostream& os, const Variant &v)
 {
 	switch (v.getType())
@@ -1056,6 +1261,15 @@ PXL_DLL_EXPORT std::ostream& operator <<(std::ostream& os, const Variant &v)
 		os << ")";
 		break;
 	}
+	case Variant::TYPE_FLOAT_ARRAY:
+		printArray(os, v.asFloatArray());
+		break;
+	case Variant::TYPE_DOUBLE_ARRAY:
+		printArray(os, v.asDoubleArray());
+		break;
+	case Variant::TYPE_INT32_ARRAY:
+		printArray(os, v.asInt32Array());
+		break;
 	default:
 		break;
 	}
@@ -1099,10 +1313,12 @@ Variant Variant::fromVector(const std::vector<Variant> &s)
 
 Variant &Variant::operator =(const std::vector<Variant> &a)
 {
-	if (type != TYPE_VECTOR)
+	if (type == TYPE_VECTOR)
 	{
-		clear();
+		*data.__vec = a;
+		return *this;
 	}
+	clear();
 	data.__vec = new std::vector<Variant>(a);
 	type = TYPE_VECTOR;
 	return *this;
@@ -1183,7 +1399,7 @@ float Variant::toFloat() const
 	}
 	else if (type == TYPE_STRING)
 	{
-		return static_cast<float>(std::atof(data.__String->c_str()));
+		return static_cast<float>(std::atof(inlineString()->c_str()));
 	}
 	else if (type == TYPE_BOOL)
 	{
@@ -1239,7 +1455,7 @@ double Variant::toDouble() const
 	}
 	else if (type == TYPE_STRING)
 	{
-		return std::atof(data.__String->c_str());
+		return std::atof(inlineString()->c_str());
 	}
 	else if (type == TYPE_BOOL)
 	{
@@ -34,12 +34,18 @@
 #include <netdb.h>
 #endif
 
+#ifndef _MSC_VER
+#include <sys/select.h>
+#endif
+
 #include <sys/types.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <stdio.h>
 #include <ctype.h>
 #include <stdlib.h>
+#include <string.h>
+#include <algorithm>
 
 #undef PXL_LOG_MODULE_NAME
 #define PXL_LOG_MODULE_NAME "pxl::sFTPFile"
@@ -195,13 +201,29 @@ public:
 	}
 };
 
-sFTPFileImpl::sFTPFileImpl() : _session(0), _eof(false)
+static size_t _readAheadBlocks = 8;
+static size_t _readAheadBlockSize = 524288;
+
+void sFTPFileImpl::setReadAhead(size_t blocks, size_t blockSize)
+{
+	_readAheadBlocks = std::max(blocks, (size_t) 1);
+	_readAheadBlockSize = std::max(blockSize, (size_t) 1);
+}
+
+sFTPFileImpl::sFTPFileImpl() :
+		_session(0), _sftp_session(0), _sftp_handle(0), _mode(0), _socket(0), _eof(
+				false), _bad(false), _current(0), _blockSize(0), _position(0), _nextOffset(
+				0)
 {
 	sFTPInit::instance().initialize();
 }
 
-sFTPFileImpl::sFTPFileImpl(const std::string &filename, int32_t mode)
+sFTPFileImpl::sFTPFileImpl(const std::string &filename, int32_t mode) :
+		_session(0), _sftp_session(0), _sftp_handle(0), _mode(0), _socket(0), _eof(
+				false), _bad(false), _current(0), _blockSize(0), _position(0), _nextOffset(
+				0)
 {
+	sFTPInit::instance().initialize();
 	open(filename, mode);
 }
 
@@ -378,9 +400,19 @@ void sFTPFileImpl::parseUrl(const std::string &url)
 	_host = url.substr(host_start_pos, host_end_pos - host_start_pos);
 	_path = url.substr(host_end_pos + 1);
 
+	// ssh://gmueller@lx3a24:22/.bashrc
+	//              ^      ^
+	size_type port_pos = _host.rfind(":");
+	if (port_pos != std::string::npos)
+	{
+		_port = _host.substr(port_pos + 1);
+		_host.erase(port_pos);
+	}
+
 	PXL_LOG_DEBUG << "URL: " << url;
 	PXL_LOG_DEBUG << "Username: " << _username;
 	PXL_LOG_DEBUG << "Host: " << _host;
+	PXL_LOG_DEBUG << "Port: " << _port;
 	PXL_LOG_DEBUG << "Path: " << _path;
 }
 
@@ -397,7 +429,8 @@ bool sFTPFileImpl::open(const std::string &filename, int32_t mode)
 		_username = ::getenv("USER");
 	}
 
-	connect(_host, _port);
+	if (!connect(_host, _port))
+		return false;
 	authenticate(_username);
 
 	_sftp_session = libssh2_sftp_init(_session);
@@ -429,13 +462,163 @@ bool sFTPFileImpl::open(const std::string &filename, int32_t mode)
 		return false;
 	}
 
+	_mode = mode;
 	_eof = false;
+	_bad = false;
+
+	if (mode & OpenRead)
+		openReadAhead();
 
 	return true;
 }
 
+/// Opens a handle for each block read ahead, the first one is _sftp_handle.
+/// The session is non-blocking from now on.
+void sFTPFileImpl::openReadAhead()
+{
+	_blockSize = _readAheadBlockSize;
+	_readAhead.resize(_readAheadBlocks);
+	for (size_t i = 0; i < _readAhead.size(); i++)
+	{
+		ReadAhead &block = _readAhead[i];
+		if (i == 0)
+			block.handle = _sftp_handle;
+		else
+			block.handle = ::libssh2_sftp_open(_sftp_session, _path.c_str(),
+					LIBSSH2_FXF_READ, 0);
+
+		if (!block.handle)
+		{
+			PXL_LOG_WARNING << "Unable to open more than " << i <<
+					" SFTP handles, reading ahead less: " <<
+					_sftp_error_messages[libssh2_sftp_last_error(_sftp_session)];
+			_readAhead.resize(i);
+			break;
+		}
+		block.data.resize(_blockSize);
+		block.offset = 0;
+		block.size = 0;
+		block.complete = true;
+	}
+
+	::libssh2_session_set_blocking(_session, 0);
+	restart(0);
+}
+
+void sFTPFileImpl::closeReadAhead()
+{
+	if (_session)
+		::libssh2_session_set_blocking(_session, 1);
+
+	for (size_t i = 1; i < _readAhead.size(); i++)
+		::libssh2_sftp_close_handle(_readAhead[i].handle);
+	_readAhead.clear();
+}
+
+/// Waits until the socket is ready for whatever libssh2 was blocked on.
+void sFTPFileImpl::waitSocket()
+{
+	int directions = ::libssh2_session_block_directions(_session);
+	if (directions == 0)
+		return;
+
+	fd_set readfds, writefds;
+	FD_ZERO(&readfds);
+	FD_ZERO(&writefds);
+	if (directions & LIBSSH2_SESSION_BLOCK_INBOUND)
+		FD_SET(_socket, &readfds);
+	if (directions & LIBSSH2_SESSION_BLOCK_OUTBOUND)
+		FD_SET(_socket, &writefds);
+
+	struct timeval timeout;
+	timeout.tv_sec = 10;
+	timeout.tv_usec = 0;
+	::select(_socket + 1, &readfds, &writefds, 0, &timeout);
+}
+
+/// Requests the block at offset, the request is sent by the first receive().
+void sFTPFileImpl::request(ReadAhead &block, int64_t offset)
+{
+	block.offset = offset;
+	block.size = 0;
+	block.complete = false;
+	::libssh2_sftp_seek64(block.handle, offset);
+	receive(block);
+}
+
+/// Receives what has arrived for the block, without waiting.
+/// Returns true if anything arrived.
+bool sFTPFileImpl::receive(ReadAhead &block)
+{
+	bool received = false;
+	while (!block.complete)
+	{
+		ssize_t rc = ::libssh2_sftp_read(block.handle, &block.data[block.size],
+				_blockSize - block.size);
+		if (rc == LIBSSH2_ERROR_EAGAIN)
+			break;
+
+		received = true;
+		if (rc < 0)
+		{
+			PXL_LOG_ERROR << "Unable to read file with SFTP:" <<
+					_sftp_error_messages[libssh2_sftp_last_error(_sftp_session)];
+			_bad = true;
+			block.complete = true;
+		}
+		else if (rc == 0)
+		{
+			// end of file, the block stays short
+			block.complete = true;
+		}
+		else
+		{
+			block.size += rc;
+			block.complete = (block.size == _blockSize);
+		}
+	}
+	return received;
+}
+
+/// Waits for the block at _current, receiving the others meanwhile.
+bool sFTPFileImpl::waitCurrent()
+{
+	ReadAhead &current = _readAhead[_current];
+	while (!current.complete)
+	{
+		bool received = false;
+		for (size_t i = 0; i < _readAhead.size(); i++)
+			received |= receive(_readAhead[(_current + i) % _readAhead.size()]);
+		if (!current.complete && !received)
+			waitSocket();
+	}
+	return !_bad;
+}
+
+/// Requests the blocks from position on. Blocks still in flight are received
+/// first, libssh2 has no means to cancel a read.
+void sFTPFileImpl::restart(int64_t position)
+{
+	for (size_t i = 0; i < _readAhead.size(); i++)
+	{
+		_current = i;
+		waitCurrent();
+	}
+
+	_current = 0;
+	_position = position;
+	_nextOffset = position;
+	for (size_t i = 0; i < _readAhead.size(); i++)
+	{
+		request(_readAhead[i], _nextOffset);
+		_nextOffset += _blockSize;
+	}
+}
+
 void sFTPFileImpl::close()
 {
+	closeReadAhead();
+
 	if (_sftp_handle)
 	{
 		::libssh2_sftp_close_handle(_sftp_handle);
@@ -458,32 +641,69 @@ bool sFTPFileImpl::isEof()
 
 bool sFTPFileImpl::isOpen()
 {
-	return true;
+	return _sftp_handle != 0;
 }
 
 bool sFTPFileImpl::isBad()
 {
-	return false;
+	return _bad;
 }
 
 void sFTPFileImpl::clear()
 {
-
+	_eof = false;
 }
 
 bool sFTPFileImpl::isGood()
 {
-	return true;
+	return !_eof && !_bad;
 }
 
 int64_t sFTPFileImpl::tell()
 {
+	if (!_readAhead.empty())
+		return _position;
+
 	return ::libssh2_sftp_tell64(_sftp_handle);
 }
 
 void sFTPFileImpl::seek(int64_t pos, int32_t d)
 {
-	::libssh2_sftp_seek64(_sftp_handle, pos);
+	if (_readAhead.empty())
+	{
+		::libssh2_sftp_seek64(_sftp_handle, pos);
+		return;
+	}
+
+	int64_t position = pos;
+	if (d == SeekCurrent)
+		position = _position + pos;
+	else if (d == SeekEnd)
+	{
+		LIBSSH2_SFTP_ATTRIBUTES attributes;
+		int rc;
+		while ((rc = ::libssh2_sftp_fstat_ex(_sftp_handle, &attributes, 0))
+				== LIBSSH2_ERROR_EAGAIN)
+			waitSocket();
+		if (rc < 0)
+		{
+			PXL_LOG_ERROR << "Unable to stat file with SFTP:" <<
+					_sftp_error_messages[libssh2_sftp_last_error(_sftp_session)];
+			_bad = true;
+			return;
+		}
+		position = attributes.filesize + pos;
+	}
+
+	if (position < 0)
+		return;
+	_eof = false;
+
+	// positions within the blocks in flight keep them
+	if (position >= _readAhead[_current].offset && position < _nextOffset)
+		_position = position;
+	else
+		restart(position);
 }
 
 int32_t sFTPFileImpl::peek()
@@ -491,6 +711,15 @@ int32_t sFTPFileImpl::peek()
 	if (_eof)
 		return EOF;
 
+	if (!_readAhead.empty())
+	{
+		char c;
+		if (read(&c, 1) != 1)
+			return EOF;
+		_position--;
+		return (unsigned char) c;
+	}
+
 	char c;
 	if (::libssh2_sftp_read(_sftp_handle, (char *) &c, 1))
 	{
@@ -506,6 +735,38 @@ int32_t sFTPFileImpl::peek()
 
 int64_t sFTPFileImpl::read(char *s, size_t count)
 {
+	if (!_readAhead.empty())
+	{
+		size_t read = 0;
+		while (read < count)
+		{
+			if (!waitCurrent())
+				break;
+
+			ReadAhead &current = _readAhead[_current];
+			int64_t end = current.offset + current.size;
+			if (_position >= end)
+			{
+				if (current.size < _blockSize)
+				{
+					_eof = true;
+					break;
+				}
+				// block consumed, request the next one in its place
+				request(current, _nextOffset);
+				_nextOffset += _blockSize;
+				_current = (_current + 1) % _readAhead.size();
+				continue;
+			}
+
+			size_t n = std::min(count - read, (size_t) (end - _position));
+			memcpy(s + read, &current.data[_position - current.offset], n);
+			_position += n;
+			read += n;
+		}
+		return read;
+	}
+
 	size_t read = 0;
 
 	while (read < count)
@@ -538,7 +799,10 @@ int64_t sFTPFileImpl::write(const char *s, size_t count)
 
 void sFTPFileImpl::ignore(int64_t count)
 {
-	::libssh2_sftp_seek64(_sftp_handle, tell() + count);
+	if (!_readAhead.empty())
+		seek(count, SeekCurrent);
+	else
+		::libssh2_sftp_seek64(_sftp_handle, tell() + count);
 }
 
 void sFTPFileImpl::destroy()
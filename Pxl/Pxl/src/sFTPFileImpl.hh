@@ -11,6 +11,8 @@
 
 #include "Pxl/Pxl/interface/pxl/core/File.hh"
 
+#include <vector>
+
 typedef struct _LIBSSH2_SESSION LIBSSH2_SESSION;
 typedef struct _LIBSSH2_SFTP LIBSSH2_SFTP;
 typedef struct _LIBSSH2_SFTP_HANDLE LIBSSH2_SFTP_HANDLE;
@@ -18,8 +20,23 @@ typedef struct _LIBSSH2_SFTP_HANDLE LIBSSH2_SFTP_HANDLE;
 namespace pxl
 {
 
+/// File implementation for ssh://user@host:port/path urls. Files opened for
+/// reading are read ahead in blocks, each requested on its own SFTP handle in
+/// non-blocking mode, so that several reads are in flight at once and the
+/// throughput is not bound by the round trip time.
 class PXL_DLL_EXPORT sFTPFileImpl: public FileImpl
 {
+	/// A block of the file requested ahead of the read position.
+	struct ReadAhead
+	{
+		LIBSSH2_SFTP_HANDLE *handle;
+		std::vector<char> data;
+		int64_t offset;
+		/// Number of bytes received so far.
+		size_t size;
+		bool complete;
+	};
+
 	LIBSSH2_SESSION *_session;
 	LIBSSH2_SFTP *_sftp_session;
 	LIBSSH2_SFTP_HANDLE *_sftp_handle;
@@ -29,14 +46,36 @@ class PXL_DLL_EXPORT sFTPFileImpl: public FileImpl
 	int32_t _mode;
 	int _socket;
 	bool _eof;
+	bool _bad;
+
+	/// Ring of blocks with consecutive offsets, starting at _current.
+	std::vector<ReadAhead> _readAhead;
+	size_t _current;
+	size_t _blockSize;
+	int64_t _position;
+	/// Offset of the block to be requested next.
+	int64_t _nextOffset;
 
 	bool connect(const std::string &host, const std::string &port);
 	void disconnect();
 	bool authenticate(const std::string &username);
 	void parseUrl(const std::string &url);
 
+	void openReadAhead();
+	void closeReadAhead();
+	void request(ReadAhead &block, int64_t offset);
+	bool receive(ReadAhead &block);
+	bool waitCurrent();
+	void restart(int64_t position);
+	void waitSocket();
+
 public:
 
+	/// Sets the number of blocks read ahead and their size for files opened
+	/// from now on, 8 blocks of 512 kB by default. A single block disables
+	/// the pipelining.
+	static void setReadAhead(size_t blocks, size_t blockSize);
+
 	sFTPFileImpl();
 
 	sFTPFileImpl(const std::string &filename, int32_t mode);
@@ -54,7 +54,9 @@ void SignalHandler::dispatcher( int signum ) {
       (*handler)->handle_signal( signum );
       std::cerr << "Handler returned." << std::endl;
    }
-   //re-raise for proper termination
+   //re-raise for proper termination, with the handler that was there before,
+   //the handlers need not unregister themselves
+   signal( signum, m_signal_old_handler[ signum ] );
    std::cerr << "Re-raising." << std::endl;
    raise( signum );
    std::cerr << "Re-raised." << std::endl;
@@ -4,6 +4,10 @@
 #include <algorithm>
 #include <string.h>
 #include <csignal>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/time.h>
 
 #include "dcap.h"
 
@@ -11,46 +15,110 @@
 using namespace std;
 
 
-void * read_ahead( void *data ) {
-   //cast the argument in a usable type
-   dCacheBuf::read_ahead_data *rhd = (dCacheBuf::read_ahead_data*)data;
-   //try to read data, at max bufSize characters and write into the buffer
-   rhd->aheadsize = dc_read( rhd->file, rhd->buffer, rhd->bufsize );
-   //looks like we're done here
-   pthread_exit(NULL);
+// wrappers, since dc_open is variadic and the other signatures differ slightly
+static int dcap_open( const char *name, int flags ) { return dc_open( name, flags ); }
+static ssize_t dcap_read( int file, void *buffer, size_t size ) { return dc_read( file, buffer, size ); }
+static off64_t dcap_lseek( int file, off64_t offset, int whence ) { return dc_lseek( file, offset, whence ); }
+static int dcap_close( int file ) { return dc_close( file ); }
+static int dcap_close2( int file ) { return dc_close2( file ); }
+static void dcap_perror( const char *message ) { dc_perror( message ); }
+static void dcap_set_open_timeout( time_t timeout ) { dc_setOpenTimeout( timeout ); }
+static void dcap_no_buffering( int file ) { dc_noBuffering( file ); }
+
+static int local_open( const char *name, int flags ) { return ::open( name, flags ); }
+static ssize_t local_read( int file, void *buffer, size_t size ) { return ::read( file, buffer, size ); }
+static off64_t local_lseek( int file, off64_t offset, int whence ) { return lseek64( file, offset, whence ); }
+static int local_close( int file ) { return ::close( file ); }
+static void local_perror( const char *message ) { ::perror( message ); }
+static void local_set_open_timeout( time_t ) {}
+static void local_no_buffering( int ) {}
+
+
+dCacheBuf::Backend dCacheBuf::dcap_backend() {
+   Backend backend = { dcap_open, dcap_read, dcap_lseek, dcap_close, dcap_close2,
+                       dcap_perror, dcap_set_open_timeout, dcap_no_buffering };
+   return backend;
+}
+
+
+dCacheBuf::Backend dCacheBuf::local_backend() {
+   Backend backend = { local_open, local_read, local_lseek, local_close, local_close,
+                       local_perror, local_set_open_timeout, local_no_buffering };
+   return backend;
+}
+
+
+static double now() {
+   timeval tv;
+   gettimeofday( &tv, 0 );
+   return tv.tv_sec + 1e-6 * tv.tv_usec;
 }
 
 
 
 dCacheBuf::dCacheBuf() :
    streambuf(),
-   m_timeout( 3600 ),
-   //get one megabyte of buffer space
-   bufsize( 1048576 ),
-   //we don't have a file open yet
-   filename(),
-   file( 0 ),
-   readsize( 0 ),
-   read_active( false )
+   m_config(),
+   m_backend( dcap_backend() )
+{
+   init();
+}
+
+
+dCacheBuf::dCacheBuf( const Config &config, const Backend &backend ) :
+   streambuf(),
+   m_config( config ),
+   m_backend( backend )
 {
+   init();
+}
+
+
+void dCacheBuf::init() {
+   m_timeout = 3600;
+   //we don't have a file open yet
+   file = 0;
+   m_open = false;
+   readsize = 0;
+   m_config.blocksize = max( m_config.blocksize, (streamsize) 1 );
    //take one permille as push back buffer, but at least 10 characters
-   pbsize = max( bufsize / 1000, (long int) 10 );
-   //get two buffer of appropriate size
-   //one satisfy the consumers and one to read into at the same time
-   active_buffer = new char[ bufsize+pbsize ];
-   readahead_buffer = new char[ bufsize+pbsize ];
+   pbsize = max( m_config.blocksize / 1000, (streamsize) 10 );
+   m_config.depth = max( m_config.depth, 1u );
+   m_config.max_ring_bytes = max( m_config.max_ring_bytes, ring_bytes( m_config.blocksize, 1 ) );
+   while( m_config.depth > 1 && ring_bytes( m_config.blocksize, m_config.depth ) > m_config.max_ring_bytes ) {
+      --m_config.depth;
+   }
+   m_config.max_depth = max( m_config.max_depth, m_config.depth );
+   m_config.min_blocksize = min( m_config.min_blocksize, m_config.blocksize );
+   m_config.max_blocksize = max( m_config.max_blocksize, m_config.blocksize );
+   m_blocksize = m_config.blocksize;
+   m_depth = m_config.depth;
+   //one block for the consumer and up to max_depth blocks read ahead,
+   //the memory of a block is only allocated when it is first read into
+   m_blocks.resize( m_config.max_depth + 1 );
+   m_blocks[ 0 ].data.resize( pbsize );
+   m_active = 0;
+   m_filled = 0;
+   m_read_offset = 0;
+   m_read_done = false;
+   m_thread_running = false;
+   m_stop = false;
+   pthread_mutex_init( &m_mutex, 0 );
+   pthread_cond_init( &m_not_empty, 0 );
+   pthread_cond_init( &m_not_full, 0 );
 
    //set all pointer to the start of the active buffer, behind the push back area
-   setg( active_buffer+pbsize, active_buffer+pbsize, active_buffer+pbsize );
+   char *begin = &m_blocks[ 0 ].data[ 0 ] + pbsize;
+   setg( begin, begin, begin );
 }
 
 
 dCacheBuf::~dCacheBuf(){
    //close file, if still open
    close();
-   //get rid of the buffers
-   delete[] active_buffer;
-   delete[] readahead_buffer;
+   pthread_cond_destroy( &m_not_full );
+   pthread_cond_destroy( &m_not_empty );
+   pthread_mutex_destroy( &m_mutex );
 }
 
 
@@ -67,18 +135,24 @@ dCacheBuf * dCacheBuf::open( const char *name, unsigned int timeout ){
    //first register the signals
    register_signals();
    //open a file read only
-   dc_setOpenTimeout( m_timeout );
-   file = dc_open( name, O_RDONLY );
+   m_backend.set_open_timeout( m_timeout );
+   file = m_backend.open( name, O_RDONLY );
    //check if it worked
    if( file > 0 ){
-      //switch off read-ahead
-      dc_noBuffering( file );
+      //switch off read-ahead, we do our own
+      m_backend.no_buffering( file );
       //looks good, so store the filename
       filename = name;
+      m_open = true;
       //reset the pointers
-      setg( active_buffer+pbsize, active_buffer+pbsize, active_buffer+pbsize );
-      //start a read-ahead
-      start_read_ahead( readahead_buffer+pbsize );
+      m_active = 0;
+      m_filled = 0;
+      m_read_offset = 0;
+      m_read_done = false;
+      char *begin = &m_blocks[ 0 ].data[ 0 ] + pbsize;
+      setg( begin, begin, begin );
+      //start reading ahead
+      start_prefetch();
       //and return this
       return this;
    } else {
@@ -90,20 +164,28 @@ dCacheBuf * dCacheBuf::open( const char *name, unsigned int timeout ){
 
 
 dCacheBuf * dCacheBuf::close(){
-   //wait fo the read ahead thread to finish
-   if( read_active ) {
-      read_ahead_wait();
-   }
+   //wait for the prefetch thread to finish
+   stop_prefetch();
    //clean up
    filename.clear();
    readsize = 0;
+   m_active = 0;
+   m_filled = 0;
+   m_read_offset = 0;
+   m_read_done = false;
+   //release the blocks, except for the push back area
+   for( size_t i = 0; i < m_blocks.size(); ++i ) {
+      vector< char >().swap( m_blocks[ i ].data );
+   }
+   m_blocks[ 0 ].data.resize( pbsize );
    //reset the pointers
-   setg( active_buffer+pbsize, active_buffer+pbsize, active_buffer+pbsize );
+   char *begin = &m_blocks[ 0 ].data[ 0 ] + pbsize;
+   setg( begin, begin, begin );
    //if we have a file open, close it
    bool success;
    if( is_open() ){
-      //try to close it
-      if( dc_close( file ) == 0 ){
+      //try to close it, unless re-opening it after a read failure failed
+      if( file > 0 && m_backend.close( file ) == 0 ){
          //closing successful
          success = true;
       } else {
@@ -120,6 +202,7 @@ dCacheBuf * dCacheBuf::close(){
 
    //reset file descriptor
    file = 0;
+   m_open = false;
 
    //return failure or success
    return success ? this : 0;
@@ -137,81 +220,59 @@ int dCacheBuf::underflow(){
       return traits_type::to_int_type(*gptr());
    }
 
-   //compute the number of characters for the push back area
-   //it can't be larger than the push back area
-   //and also not larger than the number of characters we've already read
-   streamsize numPutback = min( pbsize, gptr() - eback());
-   char *putback_buf = new char[numPutback];
-   //move the numPutback characters before the current pointer position into the push back area
-   memmove( putback_buf, gptr()-numPutback, numPutback );
+   //wait for the next block
+   pthread_mutex_lock( &m_mutex );
+   if( m_filled == 0 && !m_read_done && m_config.adaptive && m_depth < m_config.max_depth
+       && ring_bytes( m_blocksize, m_depth + 1 ) <= m_config.max_ring_bytes ) {
+      //the consumer is faster than a single stream, keep more reads in flight
+      ++m_depth;
+      pthread_cond_signal( &m_not_full );
+   }
+   while( m_filled == 0 && m_thread_running ) pthread_cond_wait( &m_not_empty, &m_mutex );
+   bool const ready = m_filled > 0;
+   pthread_mutex_unlock( &m_mutex );
 
-   //wait for the read-ahead thread
-   streamsize num = read_ahead_wait();
-   //check for error
-   if( num < 0 ) {
-      cerr << "dCacheBuf: Read failure after " << readsize << " bytes, error message:" << endl;
-      dc_perror( "dCacheBuf: " );
-      //close old connection
-      cerr << "dCacheBuf: Closing old connection with file descriptor " << file << "..." << endl;
-      if( dc_close2( file ) != 0 ) {
-         cerr << "dCacheBuf: Error while closing file descriptor " << file << ":" << endl;
-         dc_perror( "dCacheBuf: " );
-         cerr << "dCacheBuf: Going on anyway...." << endl;
-      }
-      cerr << "dCacheBuf: Closed, trying to reconnect..." << endl;
-      //reset the file descriptor
-      file = 0;
-      //re-open the file read only
-      dc_setOpenTimeout( m_timeout );
-      file = dc_open( filename.c_str(), O_RDONLY );
-      dc_noBuffering( file );
-      //check that it worked
-      if( file == 0 ) {
-         cerr << "dCacheBuf: Failed to open file " << filename << ", error message:" << endl;
-         dc_perror( "dCacheBuf: " );
-         throw dCache_error( "Failed to re-open file." );
-      }
-      //jump to where we last tried to read from
-      cerr << "dCacheBuf: Reconnected with file descriptor " << file << ", seeking old position at " << readsize << "..." << endl;
-      if( readsize != dc_lseek( file, readsize, SEEK_SET ) ) {
-         cerr << "dCacheBuf: Failed to seek to position " << readsize << ", error message:" << endl;
-         dc_perror( "dCacheBuf: " );
-         throw dCache_error( "Failed to jump to previous file position." );
-      }
-      //looks all fine, so try to read again
-      cerr << "dCacheBuf: Back to old position, reading again into buffer: " << (void*)readahead_buffer << endl;
-      num = dc_read( file, readahead_buffer+pbsize, bufsize );
-      //and again check if it worked
-      if( num < 0 ) {
-         cerr << "dCacheBuf: Read failure, error message:" << endl;
-         dc_perror( "dCacheBuf: " );
-         throw dCache_error( "Failed to read from re-opened file." );
-      }
-      cerr << "dCacheBuf: Read " << num << " bytes, seems we're back in business!" << endl;
+   //the ring only runs dry at the end of the file
+   if( !ready ){
+      return traits_type::eof();
+   }
+
+   size_t const next = ( m_active + 1 ) % m_blocks.size();
+   Block &block = m_blocks[ next ];
+   //reading failed for good
+   if( !block.error.empty() ) {
+      throw dCache_error( block.error );
    }
    //in case we got nothing, return EOF
-   if( num == 0 ){
+   if( block.size == 0 ){
       return traits_type::eof();
    }
 
+   //compute the number of characters for the push back area
+   //it can't be larger than the push back area
+   //and also not larger than the number of characters we've already read
+   streamsize numPutback = min( pbsize, gptr() - eback());
    //move the numPutback characters before the current pointer position into the push back area
-   memmove( readahead_buffer+pbsize-numPutback, putback_buf, numPutback );
-
-   //now exchange active and read-ahead buffer
-   char *temp_buffer = active_buffer;
-   active_buffer = readahead_buffer;
-   readahead_buffer = temp_buffer;
+   //of the next block, the prefetch thread does not touch both blocks
+   char *begin = &block.data[ 0 ] + pbsize;
+   memmove( begin-numPutback, gptr()-numPutback, numPutback );
+
+   //the next block becomes the active one, the old one is free for reading again
+   pthread_mutex_lock( &m_mutex );
+   size_t const left = m_active;
+   m_active = next;
+   --m_filled;
+   recycle( left );
+   pthread_cond_signal( &m_not_full );
+   pthread_mutex_unlock( &m_mutex );
 
    //reading worked, reset the pointers
-   setg( active_buffer+pbsize-numPutback, //beginning of the push back area
-         active_buffer+pbsize, //end of the push back area
-         active_buffer+pbsize+num ); //end of the push back area plus the number of character we've read
+   setg( begin-numPutback, //beginning of the push back area
+         begin, //end of the push back area
+         begin+block.size ); //end of the push back area plus the number of character we've read
 
    //increase the number of characters we've already read
-   readsize += num;
-
-   //and start a new read-ahead
-   start_read_ahead( readahead_buffer+pbsize );
+   readsize += block.size;
 
    //return the next character
    return traits_type::to_int_type(*gptr());
@@ -219,70 +280,228 @@ int dCacheBuf::underflow(){
 
 
 streamsize dCacheBuf::showmanyc(){
-   //WARNING: This function is quite a waste
-   //but I'm too lazy to do it better
-
-   //wait fo the read ahead thread to finish
-   if( read_active ) read_ahead_wait();
+   if( !is_open() ) return -1;
+   //the prefetch thread must not read while we move around, and only then
+   //file can be used here
+   stop_prefetch();
+   //re-opening the file after a read failure failed, the size is unknown
+   if( file <= 0 ){
+      start_prefetch();
+      return -1;
+   }
    //jump to the end of the file to get the current file size
-   streamsize filesize = dc_lseek( file, 0, SEEK_END );
-   //jump back to where we came from
-   dc_lseek( file, readsize, SEEK_SET );
-   //restart the read ahead
-   start_read_ahead( readahead_buffer+pbsize );
+   streamsize filesize = m_backend.lseek( file, 0, SEEK_END );
+   //jump back to where the prefetch thread stopped
+   m_backend.lseek( file, m_read_offset, SEEK_SET );
+   //restart reading ahead
+   start_prefetch();
    //return remaining characters
    return filesize-readsize;
 }
 
 
 
-void dCacheBuf::start_read_ahead( char* buffer ) {
-   //set the data the thread needs
-   rhd.bufsize = bufsize;
-   rhd.file = file;
-   rhd.aheadsize = 0;
-   rhd.buffer = buffer;
-   //start a thread
-   pthread_create( &thread, NULL, read_ahead, (void*)&rhd );
+void dCacheBuf::start_prefetch() {
+   if( m_thread_running ) return;
+
+   m_stop = false;
+   //the thread inherits the signal mask, it is started with the terminating
+   //signals blocked, so that handle_signal() runs on another thread
+   sigset_t blocked, old;
+   terminating_signals( blocked );
+   pthread_sigmask( SIG_BLOCK, &blocked, &old );
+   int const result = pthread_create( &m_thread, NULL, prefetch_thread, (void*)this );
+   pthread_sigmask( SIG_SETMASK, &old, 0 );
    //and store that we're reading
-   read_active = true;
+   if( result == 0 ) {
+      m_thread_running = true;
+   } else {
+      throw dCache_error( "Failed to start the read-ahead thread." );
+   }
+}
+
+
+
+void dCacheBuf::stop_prefetch() {
+   if( !m_thread_running ) return;
+
+   //the thread finishes its current read, the blocks read so far stay in the ring
+   pthread_mutex_lock( &m_mutex );
+   m_stop = true;
+   pthread_cond_broadcast( &m_not_full );
+   pthread_mutex_unlock( &m_mutex );
+   pthread_join( m_thread, 0 );
+   m_thread_running = false;
 }
 
 
 
-std::streamsize dCacheBuf::read_ahead_wait() {
-   void *status;
-   //wait for our read ahead thread to finish
-   pthread_join( thread, &status );
-   //finished, so set no active read
-   read_active = false;
-   //return how much we've read
-   return rhd.aheadsize;
+void * dCacheBuf::prefetch_thread( void *buf ) {
+   static_cast< dCacheBuf* >( buf )->prefetch();
+   return 0;
+}
+
+
+
+void dCacheBuf::prefetch() {
+   pthread_mutex_lock( &m_mutex );
+   while( true ) {
+      //wait for a free block
+      while( !m_stop && ( m_read_done || m_filled >= m_depth ) ) {
+         //nothing more to read, wake up a consumer waiting for the end of the file
+         if( m_read_done ) pthread_cond_broadcast( &m_not_empty );
+         pthread_cond_wait( &m_not_full, &m_mutex );
+      }
+      if( m_stop ) break;
+
+      Block &block = m_blocks[ ( m_active + 1 + m_filled ) % m_blocks.size() ];
+      streamsize const size = m_blocksize;
+      pthread_mutex_unlock( &m_mutex );
+
+      //the block is not visible to the consumer until it is counted as filled,
+      //blocks of another block size get exactly the current one
+      if( block.data.size() != (size_t) ( size + pbsize ) ) {
+         vector< char >( size + pbsize ).swap( block.data );
+      }
+      block.error.clear();
+      double const start = now();
+      streamsize num = m_backend.read( file, &block.data[ 0 ] + pbsize, size );
+      double const seconds = now() - start;
+      //a signal closed the file to end the read, do not re-open it
+      if( num < 0 && !m_stop ) num = recover( block, size );
+
+      pthread_mutex_lock( &m_mutex );
+      block.size = max( num, (streamsize) 0 );
+      m_read_offset += block.size;
+      if( block.size == 0 ) m_read_done = true;
+      else adapt( size, num, seconds );
+      ++m_filled;
+      pthread_cond_signal( &m_not_empty );
+   }
+   pthread_mutex_unlock( &m_mutex );
+}
+
+
+
+streamsize dCacheBuf::recover( Block &block, streamsize size ) {
+   cerr << "dCacheBuf: Read failure after " << m_read_offset << " bytes, error message:" << endl;
+   m_backend.perror( "dCacheBuf: " );
+   //close old connection
+   cerr << "dCacheBuf: Closing old connection with file descriptor " << file << "..." << endl;
+   if( m_backend.close2( file ) != 0 ) {
+      cerr << "dCacheBuf: Error while closing file descriptor " << file << ":" << endl;
+      m_backend.perror( "dCacheBuf: " );
+      cerr << "dCacheBuf: Going on anyway...." << endl;
+   }
+   cerr << "dCacheBuf: Closed, trying to reconnect..." << endl;
+   //re-open the file read only
+   m_backend.set_open_timeout( m_timeout );
+   file = m_backend.open( filename.c_str(), O_RDONLY );
+   //check that it worked
+   if( file <= 0 ) {
+      cerr << "dCacheBuf: Failed to open file " << filename << ", error message:" << endl;
+      m_backend.perror( "dCacheBuf: " );
+      //keep the descriptor invalid, but let the consumer see the error first
+      file = 0;
+      block.error = "Failed to re-open file.";
+      return -1;
+   }
+   m_backend.no_buffering( file );
+   //jump to where we last tried to read from
+   cerr << "dCacheBuf: Reconnected with file descriptor " << file << ", seeking old position at " << m_read_offset << "..." << endl;
+   if( m_read_offset != m_backend.lseek( file, m_read_offset, SEEK_SET ) ) {
+      cerr << "dCacheBuf: Failed to seek to position " << m_read_offset << ", error message:" << endl;
+      m_backend.perror( "dCacheBuf: " );
+      block.error = "Failed to jump to previous file position.";
+      return -1;
+   }
+   //looks all fine, so try to read again
+   cerr << "dCacheBuf: Back to old position, reading again into buffer: " << (void*)&block.data[ 0 ] << endl;
+   streamsize num = m_backend.read( file, &block.data[ 0 ] + pbsize, size );
+   //and again check if it worked
+   if( num < 0 ) {
+      cerr << "dCacheBuf: Read failure, error message:" << endl;
+      m_backend.perror( "dCacheBuf: " );
+      block.error = "Failed to read from re-opened file.";
+      return -1;
+   }
+   cerr << "dCacheBuf: Read " << num << " bytes, seems we're back in business!" << endl;
+   return num;
+}
+
+
+
+void dCacheBuf::adapt( streamsize size, streamsize num, double seconds ) {
+   //only full reads say something about the throughput
+   if( !m_config.adaptive || num < size ) return;
+
+   //aim at reads of about target_read_time seconds: larger blocks amortise
+   //the latency of slow pools, smaller ones keep the ring moving on fast ones
+   if( seconds < m_config.target_read_time / 2 && m_blocksize * 2 <= m_config.max_blocksize
+       && ring_bytes( m_blocksize * 2, m_depth ) <= m_config.max_ring_bytes ) {
+      m_blocksize *= 2;
+   } else if( seconds > m_config.target_read_time * 2 && m_blocksize / 2 >= m_config.min_blocksize ) {
+      m_blocksize /= 2;
+   }
+}
+
+
+
+streamsize dCacheBuf::ring_bytes( streamsize blocksize, unsigned int depth ) const {
+   //the active block, the blocks read ahead and the one recycled for the next read
+   return ( depth + 2 ) * ( blocksize + pbsize );
+}
+
+
+
+void dCacheBuf::recycle( size_t left ) {
+   //the blocks from the active one up to m_depth ahead are in use, the one
+   //behind them is read into next; with the full depth that is the left one
+   if( m_depth + 2 >= m_blocks.size() ) return;
+   size_t const spare = ( m_active + 1 + m_depth ) % m_blocks.size();
+   if( m_blocks[ spare ].data.empty() ) {
+      m_blocks[ spare ].data.swap( m_blocks[ left ].data );
+   }
+   //the others keep no memory, so that the ring holds about m_depth + 2 blocks
+   vector< char >().swap( m_blocks[ left ].data );
 }
 
 
 
 void dCacheBuf::handle_signal( int signum ) {
    std::cerr << "Handling signal: " << signum << std::endl;
-   if( signum == SIGTERM
-       || signum == SIGFPE
-       || signum == SIGILL
-       || signum == SIGSEGV
-       || signum == SIGBUS
-       || signum == SIGABRT
-       || signum == SIGHUP
-       || signum == SIGINT
-       || signum == SIGQUIT
-       || signum == SIGTERM
-       ) {
+   sigset_t terminating;
+   terminating_signals( terminating );
+   if( sigismember( &terminating, signum ) == 1 ) {
+      //the signal may interrupt the consumer while it holds the mutex, so only
+      //stop the prefetch thread and close the file under it, which ends a
+      //read blocked on the server; close() joins the thread if we go on
       std::cerr << "It's a terminating signal, closing file..." << std::endl;
-      close();
+      m_stop = true;
+      int const fd = file;
+      file = -1;
+      if( fd > 0 ) m_backend.close( fd );
       std::cerr << "Closed." << std::endl;
    }
 }
 
 
 
+void dCacheBuf::terminating_signals( sigset_t &set ) {
+   sigemptyset( &set );
+   sigaddset( &set, SIGTERM );
+   sigaddset( &set, SIGFPE );
+   sigaddset( &set, SIGILL );
+   sigaddset( &set, SIGSEGV );
+   sigaddset( &set, SIGBUS );
+   sigaddset( &set, SIGABRT );
+   sigaddset( &set, SIGHUP );
+   sigaddset( &set, SIGINT );
+   sigaddset( &set, SIGQUIT );
+}
+
+
+
 void dCacheBuf::register_signals() {
    Tools::SignalHandler::handler()->register_handler( SIGTERM, this );
    Tools::SignalHandler::handler()->register_handler( SIGFPE, this );
@@ -1,7 +1,11 @@
 #include <pthread.h>
+#include <csignal>
 #include <streambuf>
 #include <stdexcept>
 #include <string>
+#include <vector>
+#include <sys/types.h>
+#include <time.h>
 
 #include "Tools/SignalHandler.hh"
 
@@ -13,22 +17,60 @@ public:
 
 class dCacheBuf : public std::streambuf, public Tools::EventHandler {
 public:
-   struct read_ahead_data {
-      //max bytes to read
-      std::streamsize bufsize;
-      //file to read from
-      int file;
-      //number of bytes read in last read ahead
-      std::streamsize aheadsize;
-      //buffer to write to
-      char *buffer;
+   //the functions used to access the file
+   //dcap is used by default, local_backend() reads local files instead,
+   //e.g. to test the buffering without dCache
+   struct Backend {
+      int (*open)( const char *name, int flags );
+      ssize_t (*read)( int file, void *buffer, size_t size );
+      off64_t (*lseek)( int file, off64_t offset, int whence );
+      int (*close)( int file );
+      //close a connection after a read failure
+      int (*close2)( int file );
+      void (*perror)( const char *message );
+      void (*set_open_timeout)( time_t timeout );
+      void (*no_buffering)( int file );
+   };
+
+   static Backend dcap_backend();
+   static Backend local_backend();
+
+   //size and number of the blocks read ahead
+   struct Config {
+      Config() :
+         blocksize( 1048576 ),
+         depth( 4 ),
+         adaptive( false ),
+         min_blocksize( 262144 ),
+         max_blocksize( 16777216 ),
+         max_depth( 16 ),
+         target_read_time( 0.5 ),
+         max_ring_bytes( 67108864 )
+      {}
+
+      //size of the blocks read at once, in bytes
+      std::streamsize blocksize;
+      //number of blocks read ahead of the consumer
+      unsigned int depth;
+      //if true, the block size is tuned between min_blocksize and max_blocksize
+      //so that one read takes about target_read_time seconds, and the depth
+      //grows up to max_depth whenever the consumer has to wait for data
+      bool adaptive;
+      std::streamsize min_blocksize;
+      std::streamsize max_blocksize;
+      unsigned int max_depth;
+      double target_read_time;
+      //upper limit of the memory held by the blocks of one file, in bytes,
+      //the block size and depth do not grow beyond it
+      std::streamsize max_ring_bytes;
    };
 
    dCacheBuf();
+   explicit dCacheBuf( const Config &config, const Backend &backend = dcap_backend() );
    ~dCacheBuf();
-   
+
    //tell us, if there is a file already open
-   bool is_open(){ return file > 0; }
+   bool is_open(){ return m_open; }
    //open the file denoted by name
    //name must something that's understood by dCache (precisely by dc_open() )
    //returns the this pointer if successful, 0 otherwise
@@ -39,6 +81,10 @@ public:
    //(closing a non-opened file is a failure, too
    dCacheBuf * close();
 
+   //current (possibly adapted) block size and depth
+   std::streamsize blocksize() const { return m_blocksize; }
+   unsigned int depth() const { return m_depth; }
+
    //how to handle various signals
    virtual void handle_signal( int signum );
 
@@ -49,38 +95,74 @@ protected:
    int underflow();
 
 private:
+   //a block read ahead, the data starts behind the push back area
+   struct Block {
+      std::vector< char > data;
+      //number of bytes read, 0 at the end of the file
+      std::streamsize size;
+      //set if reading failed and the file could not be re-opened
+      std::string error;
+   };
+
+   void init();
+
+   //the prefetch thread and its control
+   static void * prefetch_thread( void *buf );
+   void prefetch();
+   void start_prefetch();
+   void stop_prefetch();
+   //re-opens the file after a read failure and reads the block again
+   std::streamsize recover( Block &block, std::streamsize size );
+   void adapt( std::streamsize size, std::streamsize num, double seconds );
+   //memory held by the blocks with the given block size and depth
+   std::streamsize ring_bytes( std::streamsize blocksize, unsigned int depth ) const;
+   //hands the memory of the block the consumer just left on, or releases it
+   void recycle( size_t left );
+
+   Config m_config;
+   Backend m_backend;
    //open timeout
    unsigned int m_timeout;
-   //size of the buffer
-   std::streamsize bufsize;
    //size of push back buffer
    std::streamsize pbsize;
-   //buffer to hold data
-   char *active_buffer;
-   char *readahead_buffer;
-   char *canard_front, *canard_center, *canard_rear;
    //name of the last successfully opened file
    std::string filename;
-   //file descriptor
-   int file;
-   //number of characters already read
+   //file descriptor, only used by the prefetch thread while it runs,
+   //since it is replaced when the file is re-opened after a read failure;
+   //handle_signal() closes it and sets it to -1 to end a blocked read
+   volatile int file;
+   //set between a successful open() and close(), even if re-opening the
+   //file failed and file is invalid
+   bool m_open;
+   //number of characters already handed to the consumer
    std::streamsize readsize;
 
-   //arguments to pass to the thread
-   read_ahead_data rhd;
+   //ring of blocks, the consumer reads from the active block, the next
+   //m_filled blocks are ready and the prefetch thread reads into the one after
+   std::vector< Block > m_blocks;
+   size_t m_active;
+   size_t m_filled;
+   //file position of the next read of the prefetch thread
+   std::streamsize m_read_offset;
+   //set once a read returned the end of the file or failed for good
+   bool m_read_done;
+   std::streamsize m_blocksize;
+   unsigned int m_depth;
 
-   //read ahead thread
-   pthread_t thread;
-
-   //true if a thread is busy doing a read-ahead
-   //false if nothing is being read
-   bool read_active;
-
-   //read ahead functions
-   void start_read_ahead( char* buffer );
-   std::streamsize read_ahead_wait();
+   pthread_t m_thread;
+   bool m_thread_running;
+   //also set by handle_signal(), without the mutex
+   volatile sig_atomic_t m_stop;
+   pthread_mutex_t m_mutex;
+   pthread_cond_t m_not_empty;
+   pthread_cond_t m_not_full;
 
    //manage signal handling
    void register_signals();
    void unregister_signals();
+   //fills set with the signals handled by handle_signal()
+   static void terminating_signals( sigset_t &set );
+
+   dCacheBuf( const dCacheBuf & );
+   dCacheBuf &operator=( const dCacheBuf & );
 };
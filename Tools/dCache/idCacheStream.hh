@@ -7,6 +7,11 @@ public:
       //tell the base class istream where to find the buffer
       rdbuf( &buf );
    }
+   //construct the stream with the given read-ahead configuration
+   explicit idCacheStream( const dCacheBuf::Config &config ) : std::istream(), buf( config ) {
+      //tell the base class istream where to find the buffer
+      rdbuf( &buf );
+   }
    //construct the stream and at the same time open a file
    //make is explicit, there is no sane way to cast (!) a char[] into a idCacheStream
    explicit idCacheStream( const char *filename ) : std::istream(), buf() {